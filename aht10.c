@@ -35,36 +35,91 @@ bool aht10_init(i2c_inst_t* i2c) {
  * @return true se a leitura foi bem-sucedida e os dados são válidos, false caso contrário.
  */
 bool aht10_read_data(i2c_inst_t* i2c, aht10_data_t* data) {
-    // 1. Envia o comando para disparar uma medição.
+    if (!aht10_iniciar_medicao(i2c)) return false;
+    sleep_ms(AHT10_TEMPO_MEDICAO_MS);
+    return aht10_ler_medicao(i2c, data);
+}
+
+/**
+ * @brief Dispara uma medição sem aguardar o resultado.
+ * @param i2c A instância do I2C onde o sensor está conectado.
+ * @return true se o comando foi aceito pelo sensor.
+ */
+bool aht10_iniciar_medicao(i2c_inst_t* i2c) {
+    // Envia o comando para disparar uma medição.
     // Retorna false se houver erro na escrita I2C.
     int ret = i2c_write_blocking(i2c, AHT10_ADDR, CMD_MEASURE, sizeof(CMD_MEASURE), false);
-    if (ret < 0) return false;
-
-    // 2. Espera o tempo de medição recomendado pelo datasheet (~75ms).
-    sleep_ms(80);
+    return ret >= 0;
+}
 
-    // 3. Lê os 6 bytes de dados de resposta do sensor.
+/**
+ * @brief Lê o resultado de uma medição disparada por aht10_iniciar_medicao().
+ * @param i2c A instância do I2C onde o sensor está conectado.
+ * @param data Ponteiro para a estrutura onde os dados lidos serão armazenados.
+ * @return true se a leitura foi bem-sucedida e os dados são válidos, false caso contrário.
+ */
+bool aht10_ler_medicao(i2c_inst_t* i2c, aht10_data_t* data) {
+    // 1. Lê os 6 bytes de dados de resposta do sensor.
     // Retorna false se houver erro na leitura I2C (não conseguir ler 6 bytes).
     uint8_t buf[6];
-    ret = i2c_read_blocking(i2c, AHT10_ADDR, buf, sizeof(buf), false);
+    int ret = i2c_read_blocking(i2c, AHT10_ADDR, buf, sizeof(buf), false);
     if (ret < 0) return false;
 
-    // 4. Checa o byte de status para ver se o sensor está calibrado e não está ocupado.
+    // 2. Checa o byte de status para ver se o sensor está calibrado e não está ocupado.
     // O bit 7 (status Busy/Calibrated) deve ser 0 (não ocupado) e o bit 3 (Calibrated) deve ser 1.
     if ((buf[0] & 0x88) != 0x08) {
         return false; // Retorna false se o status indica sensor ocupado ou não calibrado.
     }
 
-    // 5. Calcula os valores de umidade e temperatura com base nas fórmulas do datasheet.
-    // As fórmulas convertem os valores brutos de 20 bits (ou 20.5 bits) para as unidades reais.
-    
-    // Cálculo da umidade: (raw_humidity / 2^20) * 100%
+    // 3. Calcula os valores de umidade e temperatura com base nas fórmulas do datasheet.
+    aht10_converter_bruto(buf, data);
+
+    return true; // Leitura bem-sucedida e dados válidos.
+}
+
+/**
+ * @brief Converte os 6 bytes brutos de resposta do sensor em temperatura e umidade.
+ * As fórmulas convertem os valores brutos de 20 bits (ou 20.5 bits) para as unidades reais.
+ * @param buf Os 6 bytes lidos do sensor.
+ * @param data Ponteiro para a estrutura onde os valores convertidos serão armazenados.
+ */
+void aht10_converter_bruto(const uint8_t buf[6], aht10_data_t* data) {
+    // Cálculo da umidade: (raw_humidity / 2^20) * 100% = raw * 10000 / 2^20 centésimos.
+    // 10000 / 2^20 = 625 / 2^16: o produto cabe em 32 bits (2^20 * 625 < 2^30).
     uint32_t raw_humidity = ((uint32_t)buf[1] << 12) | ((uint32_t)buf[2] << 4) | (buf[3] >> 4);
-    data->humidity = ((float)raw_humidity / 1048576.0f) * 100.0f;
+    data->humidity_c100 = (uint16_t)((raw_humidity * 625u + (1u << 15)) >> 16);
 
-    // Cálculo da temperatura: ((raw_temp / 2^20) * 200) - 50
+    // Cálculo da temperatura: ((raw_temp / 2^20) * 200) - 50, em centésimos:
+    // raw * 20000 / 2^20 - 5000 = raw * 625 / 2^15 - 5000.
     uint32_t raw_temp = (((uint32_t)buf[3] & 0x0F) << 16) | ((uint32_t)buf[4] << 8) | buf[5];
-    data->temperature = (((float)raw_temp / 1048576.0f) * 200.0f) - 50.0f;
+    data->temperature_c100 = (int16_t)((int32_t)((raw_temp * 625u + (1u << 14)) >> 15) - 5000);
+}
 
-    return true; // Leitura bem-sucedida e dados válidos.
-}
\ No newline at end of file
+// --- Interface de Driver (sensor_driver.h) ---
+
+static bool driver_iniciar(const sensor_contexto_t *ctx) {
+    return aht10_init(ctx->i2c);
+}
+
+static int32_t driver_disparar(const sensor_contexto_t *ctx) {
+    return aht10_iniciar_medicao(ctx->i2c) ? AHT10_TEMPO_MEDICAO_MS : -1;
+}
+
+static bool driver_ler(const sensor_contexto_t *ctx, amostra_t *destino) {
+    aht10_data_t dados;
+    if (!aht10_ler_medicao(ctx->i2c, &dados)) return false;
+    destino->temp_c100 = dados.temperature_c100;
+    destino->umid_c100 = dados.humidity_c100;
+    destino->validos |= AMOSTRA_TEMP | AMOSTRA_UMID;
+    return true;
+}
+
+const sensor_driver_t aht10_driver = {
+    .nome = "aht10",
+    .capacidades = AMOSTRA_TEMP | AMOSTRA_UMID,
+    .unidades = "C,%UR",
+    .iniciar = driver_iniciar,
+    .disparar = driver_disparar,
+    .pronto = NULL, // O AHT10 conclui dentro de AHT10_TEMPO_MEDICAO_MS
+    .ler = driver_ler,
+};
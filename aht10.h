@@ -7,18 +7,20 @@
 #ifndef AHT10_H
 #define AHT10_H
 
-#include "pico/stdlib.h" // Para tipos básicos como bool, float
+#include "pico/stdlib.h" // Para tipos básicos como bool e inteiros de largura fixa
 #include "hardware/i2c.h" // Para o tipo i2c_inst_t
+#include "sensor_driver.h" // Para sensor_driver_t
 
 #define AHT10_ADDR 0x38 // Endereço I2C padrão do sensor AHT10
+#define AHT10_TEMPO_MEDICAO_MS 80 // Tempo de medição recomendado pelo datasheet (~75ms) com margem
 
 /**
  * @struct aht10_data_t
  * @brief Estrutura para armazenar os dados finais de temperatura e umidade lidos do sensor.
  */
 typedef struct {
-    float temperature; ///< Temperatura em Graus Celsius.
-    float humidity;    ///< Umidade Relativa em %.
+    int16_t temperature_c100;  ///< Temperatura em centésimos de grau Celsius.
+    uint16_t humidity_c100;    ///< Umidade Relativa em centésimos de %.
 } aht10_data_t;
 
 /**
@@ -38,4 +40,33 @@ bool aht10_init(i2c_inst_t* i2c_port);
  */
 bool aht10_read_data(i2c_inst_t* i2c_port, aht10_data_t* data);
 
+/**
+ * @brief Dispara uma medição sem aguardar o resultado.
+ * O resultado pode ser lido com aht10_ler_medicao() após AHT10_TEMPO_MEDICAO_MS.
+ * @param i2c_port A instância do I2C onde o sensor está conectado.
+ * @return true se o comando foi aceito pelo sensor.
+ */
+bool aht10_iniciar_medicao(i2c_inst_t* i2c_port);
+
+/**
+ * @brief Lê o resultado de uma medição disparada por aht10_iniciar_medicao().
+ * @param i2c_port A instância do I2C onde o sensor está conectado.
+ * @param data Ponteiro para a estrutura onde os dados lidos serão armazenados.
+ * @return true se a leitura foi bem-sucedida e o sensor já havia concluído a medição.
+ */
+bool aht10_ler_medicao(i2c_inst_t* i2c_port, aht10_data_t* data);
+
+/**
+ * @brief Converte os 6 bytes brutos de resposta do sensor em temperatura e umidade.
+ * Só aritmética inteira (o M0+ não tem FPU). Não acessa o barramento; não valida o byte de status.
+ * @param buf Os 6 bytes lidos do sensor.
+ * @param data Ponteiro para a estrutura onde os valores convertidos serão armazenados.
+ */
+void aht10_converter_bruto(const uint8_t buf[6], aht10_data_t* data);
+
+/**
+ * @brief Driver do AHT10 para o registro de sensores (temperatura e umidade do ar).
+ */
+extern const sensor_driver_t aht10_driver;
+
 #endif // AHT10_H
\ No newline at end of file
@@ -0,0 +1,29 @@
+/**
+ * @file amostras.c
+ * @brief Implementação da fila de amostras entre os núcleos.
+ */
+
+#include "amostras.h"
+#include "pico/util/queue.h"
+
+static queue_t fila;
+static volatile uint32_t descartadas;
+
+void amostras_iniciar(void) {
+    queue_init(&fila, sizeof(amostra_t), AMOSTRAS_FILA_TAM);
+}
+
+void amostras_enviar(const amostra_t *amostra) {
+    while (!queue_try_add(&fila, amostra)) {
+        amostra_t antiga;
+        if (queue_try_remove(&fila, &antiga)) descartadas++;
+    }
+}
+
+bool amostras_receber(amostra_t *amostra) {
+    return queue_try_remove(&fila, amostra);
+}
+
+uint32_t amostras_descartadas(void) {
+    return descartadas;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file amostras.h
+ * @brief Fila de amostras dos sensores entre o Core 0 (aquisição) e o Core 1 (publicação).
+ *
+ * Cada amostra leva o instante monotônico em que foi adquirida; o horário de parede é
+ * atribuído só na formatação (relogio.h). A fila é a queue_t do SDK, segura entre núcleos,
+ * e substitui os pacotes de sensor que antes ocupavam o FIFO de hardware.
+ */
+
+#ifndef AMOSTRAS_H
+#define AMOSTRAS_H
+
+#include "pico/stdlib.h" // Para tipos básicos
+
+#define AMOSTRAS_FILA_TAM 16 // Amostras retidas enquanto o Core 1 está ocupado
+
+// Bits de amostra_t.validos
+#define AMOSTRA_TEMP (1u << 0)
+#define AMOSTRA_UMID (1u << 1)
+#define AMOSTRA_LUZ  (1u << 2)
+#define AMOSTRA_SOLO (1u << 3)
+
+/**
+ * @struct amostra_t
+ * @brief Leitura conjunta dos sensores ambientais.
+ */
+typedef struct {
+    uint64_t tempo_us;   ///< time_us_64() no momento da aquisição.
+    int16_t temp_c100;   ///< Temperatura em centésimos de °C.
+    uint16_t umid_c100;  ///< Umidade relativa em centésimos de %.
+    uint32_t luz_mlux;   ///< Luminosidade em milésimos de lux.
+    uint16_t solo_c100;  ///< Umidade do solo em centésimos de %.
+    uint8_t validos;     ///< Combinação dos bits AMOSTRA_*.
+    uint8_t zona;        ///< Zona da estufa (sensores.h); 0 é a zona principal.
+} amostra_t;
+
+/**
+ * @brief Inicializa a fila. Deve ser chamada pelo Core 0 antes de iniciar o Core 1.
+ */
+void amostras_iniciar(void);
+
+/**
+ * @brief Enfileira uma amostra (Core 0). Nunca bloqueia: com a fila cheia, a amostra
+ * mais antiga é descartada.
+ */
+void amostras_enviar(const amostra_t *amostra);
+
+/**
+ * @brief Retira a amostra mais antiga (Core 1).
+ * @return false se a fila está vazia.
+ */
+bool amostras_receber(amostra_t *amostra);
+
+/**
+ * @brief Total de amostras descartadas por falta de espaço desde o boot.
+ */
+uint32_t amostras_descartadas(void);
+
+#endif // AMOSTRAS_H
@@ -0,0 +1,187 @@
+/**
+ * @file bench.c
+ * @brief Implementação dos micro-benchmarks com o SysTick como contador de ciclos.
+ * O Cortex-M0+ não tem DWT->CYCCNT; o SysTick, alimentado por clk_sys, decrementa
+ * um ciclo por vez e dá resolução de ciclo para operações de até 2^24 ciclos.
+ */
+
+#include "bench.h"
+
+#if ESTUFA_BENCH
+
+#include <stdio.h>
+#include "hardware/structs/systick.h"
+#include "hardware/clocks.h"
+#include "ssd1306_i2c.h"
+#include "display.h"
+#include "matriz.h"
+#include "publicacao.h"
+#include "aht10.h"
+#include "bh1750.h"
+#include "solo.h"
+#include "formato.h"
+#include "configura_geral.h"
+
+#define BENCH_ITERACOES 200
+#define SYSTICK_MASCARA 0x00FFFFFFu
+
+typedef void (*caso_bench_t)(void);
+
+// --- Dados dos Casos ---
+static uint8_t quadro[ssd1306_buffer_length];
+static fila_publicacao_t fila;
+static publicacao_t publicacao;
+static aht10_data_t leitura_aht10;
+static volatile int32_t sumidouro; // Impede que o compilador elimine as conversões
+static const uint8_t bruto_aht10[6] = { 0x1C, 0x6B, 0x3A, 0x55, 0xD2, 0x4F };
+static const amostra_t amostra_exemplo = {
+    .tempo_us = 123456789, .temp_c100 = 2345, .umid_c100 = 6170, .luz_mlux = 1234000,
+    .solo_c100 = 4512, .validos = AMOSTRA_TEMP | AMOSTRA_UMID | AMOSTRA_LUZ | AMOSTRA_SOLO,
+};
+
+static void caso_vazio(void) { }
+
+static void caso_texto(void) {
+    ssd1306_draw_utf8_multiline(quadro, 0, 0, "Temp: 23.5 C");
+}
+
+static void caso_quadro(void) {
+    display_compor_mensagem(quadro, "Estufa OK", "Temp: 23.5 C", "Luz: 1234 lux");
+}
+
+static void caso_matriz(void) {
+    matriz_compor_flor(100);
+}
+
+static void caso_fila(void) {
+    publicacao_t *p = fila_publicacao_reservar(&fila);
+    if (p) fila_publicacao_confirmar(&fila);
+    if (fila_publicacao_proxima(&fila)) fila_publicacao_descartar(&fila);
+}
+
+static void caso_formatar_sensor(void) {
+    publicacao_formatar_sensor(FIFO_CMD_PUB_SENSOR_TEMP, 2345, 0, &publicacao);
+}
+
+static void caso_formatar_amostra(void) {
+    publicacao_formatar_amostra(&amostra_exemplo, &publicacao);
+}
+
+// Referência: a formatação anterior, com printf de ponto flutuante, para comparar com formato.h.
+static void caso_snprintf_decimal(void) {
+    snprintf(publicacao.mensagem, sizeof(publicacao.mensagem), "%.2f", (float)(int16_t)2345 / 100.0f);
+}
+
+static void caso_formato_decimal(void) {
+    formato_t f;
+    formato_iniciar(&f, publicacao.mensagem, sizeof(publicacao.mensagem));
+    formato_decimal(&f, 2345, 2);
+}
+
+static void caso_snprintf_topico(void) {
+    snprintf(publicacao.topico, sizeof(publicacao.topico), "%s/zona%u/%s", "bitdoglab_02", 3u, "sensores/temperatura");
+}
+
+static void caso_formato_topico(void) {
+    formato_t f;
+    formato_iniciar(&f, publicacao.topico, sizeof(publicacao.topico));
+    formato_texto(&f, "bitdoglab_02");
+    formato_texto(&f, "/zona");
+    formato_uint(&f, 3);
+    formato_caractere(&f, '/');
+    formato_texto(&f, "sensores/temperatura");
+}
+
+static void caso_formatar_evento(void) {
+    publicacao_formatar_evento(MSG_ALARM_LUZ_ON, 0, &publicacao);
+}
+
+static void caso_aht10(void) {
+    aht10_converter_bruto(bruto_aht10, &leitura_aht10);
+    sumidouro = leitura_aht10.temperature_c100;
+}
+
+static void caso_bh1750(void) {
+    sumidouro = (int32_t)bh1750_converter_bruto(0x1A2B);
+}
+
+static void caso_solo(void) {
+    sumidouro = solo_converter_bruto(2000);
+}
+
+static const struct {
+    const char *nome;
+    caso_bench_t funcao;
+} casos[] = {
+    { "ssd1306_draw_utf8",      caso_texto },
+    { "display_compor_quadro",  caso_quadro },
+    { "matriz_compor_flor",     caso_matriz },
+    { "fila_inserir_remover",   caso_fila },
+    { "formatar_sensor",        caso_formatar_sensor },
+    { "formatar_amostra",       caso_formatar_amostra },
+    { "snprintf_decimal",       caso_snprintf_decimal },
+    { "formato_decimal",        caso_formato_decimal },
+    { "snprintf_topico",        caso_snprintf_topico },
+    { "formato_topico",         caso_formato_topico },
+    { "formatar_evento",        caso_formatar_evento },
+    { "aht10_converter",        caso_aht10 },
+    { "bh1750_converter",       caso_bh1750 },
+    { "solo_converter",         caso_solo },
+};
+
+// --- Medição ---
+
+static inline uint32_t systick_ler(void) {
+    return systick_hw->cvr;
+}
+
+/**
+ * @brief Mede uma operação BENCH_ITERACOES vezes.
+ * @param funcao Caso a medir.
+ * @param minimo Menor número de ciclos observado.
+ * @return Média de ciclos por operação.
+ */
+static uint32_t medir(caso_bench_t funcao, uint32_t *minimo) {
+    uint64_t soma = 0;
+    *minimo = UINT32_MAX;
+    for (int i = 0; i < BENCH_ITERACOES; i++) {
+        uint32_t inicio = systick_ler();
+        funcao();
+        uint32_t fim = systick_ler();
+        uint32_t ciclos = (inicio - fim) & SYSTICK_MASCARA; // Contador decrescente de 24 bits
+        soma += ciclos;
+        if (ciclos < *minimo) *minimo = ciclos;
+    }
+    return (uint32_t)(soma / BENCH_ITERACOES);
+}
+
+void bench_executar(void) {
+    // SysTick em modo livre com o clock do processador, sem interrupção.
+    systick_hw->csr = 0;
+    systick_hw->rvr = SYSTICK_MASCARA;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5; // ENABLE | CLKSOURCE (processador)
+
+    fila_publicacao_iniciar(&fila);
+
+    // A chamada vazia mede o custo fixo de ler o SysTick e chamar o caso por ponteiro.
+    uint32_t base_min;
+    medir(caso_vazio, &base_min);
+
+    uint32_t mhz = clock_get_hz(clk_sys) / 1000000;
+    printf("[bench] clk_sys=%lu MHz, %d iteracoes, custo fixo=%lu ciclos (descontado)\n",
+           (unsigned long)mhz, BENCH_ITERACOES, (unsigned long)base_min);
+    printf("[bench] caso                    ciclos/op(min) ciclos/op(media)  us/op\n");
+    for (size_t c = 0; c < count_of(casos); c++) {
+        uint32_t minimo;
+        uint32_t media = medir(casos[c].funcao, &minimo);
+        minimo = minimo > base_min ? minimo - base_min : 0;
+        media = media > base_min ? media - base_min : 0;
+        printf("  %-24s %14lu %16lu %6lu.%02lu\n", casos[c].nome, (unsigned long)minimo, (unsigned long)media,
+               (unsigned long)(media / mhz), (unsigned long)((media % mhz) * 100 / mhz));
+    }
+
+    systick_hw->csr = 0;
+}
+
+#endif // ESTUFA_BENCH
@@ -0,0 +1,32 @@
+/**
+ * @file bench.h
+ * @brief Micro-benchmarks dos caminhos críticos de lógica pura do firmware.
+ * Mede, em ciclos de clk_sys por operação (via SysTick), a composição de texto no
+ * display, o desenho da matriz, a fila e a formatação das publicações e as
+ * conversões dos sensores. Habilitado com ESTUFA_BENCH=1.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "pico/stdlib.h"
+
+#ifndef ESTUFA_BENCH
+#define ESTUFA_BENCH 0
+#endif
+
+#if ESTUFA_BENCH
+
+/**
+ * @brief Executa todos os casos e imprime via stdio os ciclos por operação (mínimo e médio).
+ * Não usa o barramento I2C, o PIO nem a rede: pode rodar logo após stdio_init_all().
+ */
+void bench_executar(void);
+
+#else
+
+static inline void bench_executar(void) { }
+
+#endif // ESTUFA_BENCH
+
+#endif // BENCH_H
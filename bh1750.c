@@ -24,7 +24,7 @@ const uint8_t BH1750_CMD_HIRES1 = 0x20;    // Comando para modo de alta resoluç
 void bh1750_init(i2c_inst_t *i2c) {
     // Envia a sequência de inicialização para o sensor: Power On e Reset.
     // Embora essas escritas não verifiquem o retorno, a falha real seria detectada
-    // na primeira tentativa de leitura em bh1750_read_lux().
+    // na primeira tentativa de leitura em bh1750_read_mlux().
     i2c_write_blocking(i2c, BH1750_ADDR, &BH1750_CMD_POWER_ON, 1, false);
     sleep_ms(10); // Pequeno atraso após ligar
     i2c_write_blocking(i2c, BH1750_ADDR, &BH1750_CMD_RESET, 1, false);
@@ -32,33 +32,85 @@ void bh1750_init(i2c_inst_t *i2c) {
 }
 
 /**
- * @brief Solicita uma nova medição de luminosidade ao sensor e retorna o valor em Lux.
+ * @brief Solicita uma nova medição de luminosidade ao sensor e retorna o valor em mlux.
  * Bloqueante: aguarda o tempo de conversão do sensor.
  * @param i2c A instância do I2C a ser usada.
- * @return float - O valor da luminosidade em Lux, ou -1.0f em caso de erro na leitura.
+ * @return int32_t - A luminosidade em mlux, ou -1 em caso de erro na leitura.
  */
-float bh1750_read_lux(i2c_inst_t *i2c) {
-    uint8_t raw_data[2]; // Buffer para os 2 bytes de dados brutos
-    int bytes_read;
+int32_t bh1750_read_mlux(i2c_inst_t *i2c) {
+    bh1750_iniciar_medicao(i2c);
+    // Aguarda o tempo de conversão do sensor.
+    sleep_ms(BH1750_TEMPO_CONVERSAO_MS);
+    return bh1750_ler_medicao(i2c);
+}
 
+/**
+ * @brief Dispara uma medição única em alta resolução sem aguardar o resultado.
+ * @param i2c A instância do I2C a ser usada.
+ * @return true se o comando foi aceito pelo sensor.
+ */
+bool bh1750_iniciar_medicao(i2c_inst_t *i2c) {
     // Envia o comando para iniciar uma nova medição no modo de alta resolução (HIRES1).
     // O sensor automaticamente iniciará a conversão e armazenará o resultado.
-    i2c_write_blocking(i2c, BH1750_ADDR, &BH1750_CMD_HIRES1, 1, false);
-    
-    // Aguarda o tempo de conversão do sensor.
-    // Para o modo HIRES1 (0x20), o datasheet recomenda ~120ms para a conversão.
-    // Usar 180ms para garantir margem de segurança.
-    sleep_ms(180); 
-    
+    return i2c_write_blocking(i2c, BH1750_ADDR, &BH1750_CMD_HIRES1, 1, false) == 1;
+}
+
+/**
+ * @brief Lê o resultado de uma medição disparada por bh1750_iniciar_medicao().
+ * @param i2c A instância do I2C a ser usada.
+ * @return int32_t - A luminosidade em mlux, ou -1 em caso de erro na leitura.
+ */
+int32_t bh1750_ler_medicao(i2c_inst_t *i2c) {
+    uint8_t raw_data[2]; // Buffer para os 2 bytes de dados brutos
+
     // Lê os 2 bytes do resultado da medição.
-    bytes_read = i2c_read_blocking(i2c, BH1750_ADDR, raw_data, 2, false);
+    int bytes_read = i2c_read_blocking(i2c, BH1750_ADDR, raw_data, 2, false);
     if (bytes_read < 2) {
         // Retorna um valor de erro se a leitura I2C falhar (não conseguir ler 2 bytes).
-        return -1.0f; 
+        return -1; 
     }
     
     // Combina os bytes lidos (MSB << 8 | LSB) para formar o valor bruto de 16 bits.
-    // O datasheet especifica que o valor em Lux é (valor_bruto / 1.2).
     uint16_t raw_value = (raw_data[0] << 8) | raw_data[1];
-    return (float)raw_value / 1.2f;
-}
\ No newline at end of file
+    return (int32_t)bh1750_converter_bruto(raw_value);
+}
+
+/**
+ * @brief Converte o valor bruto de 16 bits do sensor em milésimos de lux (modo HIRES1).
+ * @param raw_value Valor bruto (MSB << 8 | LSB).
+ * @return uint32_t - A luminosidade em mlux.
+ */
+uint32_t bh1750_converter_bruto(uint16_t raw_value) {
+    // O datasheet especifica que o valor em Lux é (valor_bruto / 1.2), ou seja,
+    // raw * 1000 / 1.2 = raw * 2500 / 3 mlux, com arredondamento.
+    return ((uint32_t)raw_value * 2500u + 1u) / 3u;
+}
+
+// --- Interface de Driver (sensor_driver.h) ---
+
+static bool driver_iniciar(const sensor_contexto_t *ctx) {
+    bh1750_init(ctx->i2c); // BH1750 não tem checagem de retorno na init
+    return true;
+}
+
+static int32_t driver_disparar(const sensor_contexto_t *ctx) {
+    return bh1750_iniciar_medicao(ctx->i2c) ? BH1750_TEMPO_CONVERSAO_MS : -1;
+}
+
+static bool driver_ler(const sensor_contexto_t *ctx, amostra_t *destino) {
+    int32_t mlux = bh1750_ler_medicao(ctx->i2c);
+    if (mlux < 0) return false;
+    destino->luz_mlux = (uint32_t)mlux;
+    destino->validos |= AMOSTRA_LUZ;
+    return true;
+}
+
+const sensor_driver_t bh1750_driver = {
+    .nome = "bh1750",
+    .capacidades = AMOSTRA_LUZ,
+    .unidades = "lux",
+    .iniciar = driver_iniciar,
+    .disparar = driver_disparar,
+    .pronto = NULL, // Tempo de conversão fixo no modo HIRES1
+    .ler = driver_ler,
+};
@@ -7,6 +7,9 @@
 #define BH1750_H
 
 #include "hardware/i2c.h" // Incluído para o tipo i2c_inst_t
+#include "sensor_driver.h" // Para sensor_driver_t
+
+#define BH1750_TEMPO_CONVERSAO_MS 180 // ~120ms pelo datasheet (HIRES1), com margem de segurança
 
 /**
  * @brief Inicializa o sensor BH1750.
@@ -16,11 +19,38 @@
 void bh1750_init(i2c_inst_t *i2c);
 
 /**
- * @brief Solicita uma nova medição de luminosidade ao sensor e retorna o valor em Lux.
+ * @brief Solicita uma nova medição de luminosidade ao sensor e retorna o valor em milésimos de lux.
  * Bloqueante: aguarda o tempo de conversão do sensor.
  * @param i2c A instância do I2C a ser usada.
- * @return float - O valor da luminosidade em Lux, ou -1.0f em caso de erro na leitura.
+ * @return int32_t - A luminosidade em mlux, ou -1 em caso de erro na leitura.
+ */
+int32_t bh1750_read_mlux(i2c_inst_t *i2c);
+
+/**
+ * @brief Dispara uma medição única em alta resolução sem aguardar o resultado.
+ * O resultado pode ser lido com bh1750_ler_medicao() após BH1750_TEMPO_CONVERSAO_MS.
+ * @param i2c A instância do I2C a ser usada.
+ * @return true se o comando foi aceito pelo sensor.
+ */
+bool bh1750_iniciar_medicao(i2c_inst_t *i2c);
+
+/**
+ * @brief Lê o resultado de uma medição disparada por bh1750_iniciar_medicao().
+ * @param i2c A instância do I2C a ser usada.
+ * @return int32_t - A luminosidade em mlux, ou -1 em caso de erro na leitura.
+ */
+int32_t bh1750_ler_medicao(i2c_inst_t *i2c);
+
+/**
+ * @brief Converte o valor bruto de 16 bits do sensor em milésimos de lux (modo HIRES1).
+ * @param raw_value Valor bruto (MSB << 8 | LSB).
+ * @return uint32_t - A luminosidade em mlux (até ~54,6 milhões).
+ */
+uint32_t bh1750_converter_bruto(uint16_t raw_value);
+
+/**
+ * @brief Driver do BH1750 para o registro de sensores (luminosidade).
  */
-float bh1750_read_lux(i2c_inst_t *i2c);
+extern const sensor_driver_t bh1750_driver;
 
 #endif // BH1750_H
\ No newline at end of file
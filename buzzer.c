@@ -6,6 +6,7 @@
 
 #include "buzzer.h"
 #include "hardware/clocks.h" // Necessário para clock_get_hz
+#include "reproducao.h"       // Para estufa_dormir_ms
 
 
 // --- Definições Internas de Notas Musicais (Frequências em Hz) ---
@@ -67,7 +68,7 @@ void buzzer_stop_beep() {
 void buzzer_play_tone(uint16_t frequency, uint16_t duration_ms) {
     // Se a frequência for 0, trata-se de um silêncio (pausa)
     if (frequency == 0) {
-        sleep_ms(duration_ms);
+        estufa_dormir_ms(duration_ms);
         return;
     }
 
@@ -86,7 +87,7 @@ void buzzer_play_tone(uint16_t frequency, uint16_t duration_ms) {
     pwm_set_chan_level(slice_num, pwm_gpio_to_channel(BUZZER_PIN), wrap / 2); // 50% duty cycle
     pwm_set_enabled(slice_num, true);
 
-    sleep_ms(duration_ms); // **Bloqueante:** Pausa a execução pela duração do tom
+    estufa_dormir_ms(duration_ms); // **Bloqueante:** Pausa a execução pela duração do tom
     
     buzzer_stop_beep(); // Para o tom ao final da duração
 }
@@ -0,0 +1,55 @@
+/**
+ * @file cache_xip.c
+ * @brief Implementação da leitura dos contadores da cache do XIP.
+ */
+
+#include "cache_xip.h"
+#include "hardware/structs/xip_ctrl.h"
+#include "formato.h"
+#include <stdio.h>
+
+// Última janela fechada; escrita pelo Core 0 e lida pelo Core 1 na formatação.
+static volatile uint32_t janela_acessos, janela_acertos, janela_ms;
+static uint32_t inicio_janela_us;
+
+/**
+ * @brief Taxa de acerto em centésimos de % (100% com a janela vazia).
+ */
+static uint32_t taxa_acerto_c100(uint32_t acessos, uint32_t acertos) {
+    return acessos ? (uint32_t)((uint64_t)acertos * 10000 / acessos) : 10000;
+}
+
+void cache_xip_iniciar(void) {
+    xip_ctrl_hw->ctr_acc = 0; // Qualquer escrita zera o contador
+    xip_ctrl_hw->ctr_hit = 0;
+    inicio_janela_us = time_us_32();
+}
+
+void cache_xip_atualizar(void) {
+    uint32_t acessos = xip_ctrl_hw->ctr_acc;
+    uint32_t acertos = xip_ctrl_hw->ctr_hit;
+    janela_ms = (time_us_32() - inicio_janela_us) / 1000;
+    cache_xip_iniciar();
+    janela_acessos = acessos;
+    janela_acertos = acertos;
+    uint32_t taxa = taxa_acerto_c100(acessos, acertos);
+    printf("[xip] acessos=%lu acertos=%lu erros=%lu taxa=%lu.%02lu%%\n", (unsigned long)acessos,
+           (unsigned long)acertos, (unsigned long)(acessos - acertos),
+           (unsigned long)(taxa / 100), (unsigned long)(taxa % 100));
+}
+
+int cache_xip_formatar(char *destino, size_t tamanho) {
+    uint32_t acessos = janela_acessos, acertos = janela_acertos;
+    formato_t f;
+    formato_iniciar(&f, destino, tamanho);
+    formato_texto(&f, "{\"janela_ms\":");
+    formato_uint(&f, janela_ms);
+    formato_texto(&f, ",\"acessos\":");
+    formato_uint(&f, acessos);
+    formato_texto(&f, ",\"erros\":");
+    formato_uint(&f, acessos - acertos);
+    formato_texto(&f, ",\"taxa_acerto\":");
+    formato_decimal(&f, (int32_t)taxa_acerto_c100(acessos, acertos), 2);
+    formato_caractere(&f, '}');
+    return (int)formato_tamanho(&f);
+}
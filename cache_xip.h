@@ -0,0 +1,31 @@
+/**
+ * @file cache_xip.h
+ * @brief Contadores de acessos e acertos da cache do XIP (flash QSPI).
+ * Os contadores do hardware são compartilhados pelos dois núcleos e saturam em 32 bits;
+ * por isso são lidos e zerados a cada janela de relatório.
+ */
+
+#ifndef CACHE_XIP_H
+#define CACHE_XIP_H
+
+#include "pico/stdlib.h" // Para tipos básicos
+#include <stddef.h>
+
+/**
+ * @brief Zera os contadores e inicia a primeira janela.
+ */
+void cache_xip_iniciar(void);
+
+/**
+ * @brief Fecha a janela atual (lendo e zerando os contadores), imprime o resumo e abre a próxima.
+ * Chamada pelo Core 0 no heartbeat.
+ */
+void cache_xip_atualizar(void);
+
+/**
+ * @brief Formata em JSON a última janela fechada por cache_xip_atualizar().
+ * @return Número de caracteres escritos (sem o '\0'; o texto é truncado se não couber).
+ */
+int cache_xip_formatar(char *destino, size_t tamanho);
+
+#endif // CACHE_XIP_H
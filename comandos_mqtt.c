@@ -0,0 +1,204 @@
+/**
+ * @file comandos_mqtt.c
+ * @brief Implementação do interpretador incremental de comandos MQTT.
+ */
+
+#include "comandos_mqtt.h"
+#include "configura_geral.h"
+#include "configuracao.h"
+#include "latencia.h"
+#include "pico/multicore.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FNV_BASE 2166136261u
+#define FNV_PRIMO 16777619u
+
+enum FaseInterpretador {
+    FASE_NOME,      ///< Lendo o nome do comando.
+    FASE_VALOR,     ///< Lendo o argumento após '=' ou espaço.
+    FASE_FIM,       ///< Argumento encerrado: só aceita espaços até o fim.
+    FASE_DESCARTAR  ///< Mensagem inválida ou de outro tópico: ignora até o fim.
+};
+
+enum TipoArgumento {
+    ARG_NENHUM,  ///< Comando sem argumento.
+    ARG_NUMERO,  ///< Inteiro decimal dentro de [minimo, maximo].
+    ARG_TEXTO    ///< Texto livre, validado pelo tratador do comando.
+};
+
+/**
+ * @struct comando_t
+ * @brief Linha da tabela de comandos: nome, tipo/faixa do argumento e pacote enviado ao Core 0.
+ * Comandos de texto não cabem em um pacote do FIFO e são tratados por uma função própria.
+ */
+typedef struct {
+    const char *nome;
+    uint8_t argumento;      ///< Valor de enum TipoArgumento.
+    uint16_t minimo;
+    uint16_t maximo;
+    uint16_t comando_fifo;  ///< Comando FIFO enviado ao Core 0.
+    uint16_t valor_fixo;    ///< Valor enviado quando o comando não tem argumento.
+    bool (*tratar_texto)(const char *texto);
+} comando_t;
+
+static bool tratar_id(const char *texto);
+static bool tratar_broker(const char *texto);
+
+static const comando_t comandos[] = {
+    { "IRRIGAR",      ARG_NENHUM, 0, 0,     FIFO_CMD_EVENTO,               EVT_CMD_IRRIGAR,  NULL },
+    { "CANCELAR",     ARG_NENHUM, 0, 0,     FIFO_CMD_EVENTO,               EVT_CMD_CANCELAR, NULL },
+    { "STATUS",       ARG_NENHUM, 0, 0,     FIFO_CMD_SOLICITAR_STATUS,     0,                NULL },
+    { "LUZ_MAX",      ARG_NUMERO, 1, 54612, FIFO_CMD_AJUSTAR_LUZ_MAX,      0,                NULL }, // 54612 lux = fundo de escala do BH1750
+    { "INTERVALO",    ARG_NUMERO, 1, 3600,  FIFO_CMD_AJUSTAR_INTERVALO,    0,                NULL },
+    { "DURACAO",      ARG_NUMERO, 1, 255,   FIFO_CMD_AJUSTAR_DURACAO,      0,                NULL },
+    { "UMIDADE_ALVO", ARG_NUMERO, 1, 100,   FIFO_CMD_AJUSTAR_UMIDADE_ALVO, 0,                NULL },
+    { "ID",           ARG_TEXTO,  0, 0,     0,                             0,                tratar_id },
+    { "BROKER",       ARG_TEXTO,  0, 0,     0,                             0,                tratar_broker },
+};
+
+// --- Estado do Interpretador ---
+static uint32_t hash_topico_comando;
+static uint8_t fase = FASE_DESCARTAR;
+static char nome[COMANDO_NOME_MAX + 1];
+static uint8_t nome_tam;
+static char valor[COMANDO_VALOR_MAX + 1];
+static uint8_t valor_tam;
+static bool igual_lido; // O separador '=' já apareceu (só um é aceito, antes do argumento)
+static uint32_t inicio_mensagem_us; // Chegada da mensagem, para a latência comando -> atuação
+
+// --- Funções Auxiliares ---
+
+static inline bool eh_espaco(uint8_t c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+/**
+ * @brief ID=<nome>: novo DEVICE_ID (letras, dígitos, '_' e '-').
+ */
+static bool tratar_id(const char *texto) {
+    size_t n = strlen(texto);
+    if (n == 0 || n >= CONFIG_ID_MAX) return false;
+    for (size_t i = 0; i < n; i++) {
+        char c = texto[i];
+        bool ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-';
+        if (!ok) return false;
+    }
+    configuracao_propor_id(texto);
+    return true;
+}
+
+/**
+ * @brief BROKER=<a.b.c.d>[:porta]: novo endereço do broker MQTT.
+ */
+static bool tratar_broker(const char *texto) {
+    unsigned ip[4], porta = MQTT_BROKER_PORT;
+    int lidos = 0;
+    if (sscanf(texto, "%3u.%3u.%3u.%3u%n", &ip[0], &ip[1], &ip[2], &ip[3], &lidos) != 4) return false;
+    if (texto[lidos] == ':') {
+        char *fim;
+        porta = strtoul(texto + lidos + 1, &fim, 10);
+        if (*fim != '\0' || porta == 0 || porta > 0xFFFF) return false;
+    } else if (texto[lidos] != '\0') {
+        return false;
+    }
+    uint8_t endereco[4];
+    for (int i = 0; i < 4; i++) {
+        if (ip[i] > 255) return false;
+        endereco[i] = (uint8_t)ip[i];
+    }
+    configuracao_propor_broker(endereco, (uint16_t)porta);
+    return true;
+}
+
+/**
+ * @brief Procura o comando lido na tabela, valida o argumento e o envia ao Core 0.
+ */
+static void despachar(void) {
+    nome[nome_tam] = '\0';
+    valor[valor_tam] = '\0';
+    for (size_t i = 0; i < count_of(comandos); i++) {
+        const comando_t *c = &comandos[i];
+        if (strcmp(nome, c->nome) != 0) continue;
+        if ((c->argumento == ARG_NENHUM) != (valor_tam == 0)) break;
+        if (c->argumento == ARG_TEXTO) {
+            if (c->tratar_texto(valor)) return;
+            break;
+        }
+        uint16_t argumento = c->valor_fixo;
+        if (c->argumento == ARG_NUMERO) {
+            char *fim;
+            unsigned long n = strtoul(valor, &fim, 10);
+            if (*fim != '\0' || n < c->minimo || n > c->maximo) break;
+            argumento = (uint16_t)n;
+        }
+        if (c->comando_fifo == FIFO_CMD_EVENTO && argumento == EVT_CMD_IRRIGAR) {
+            latencia_marcar(LAT_COMANDO_IRRIGAR, inicio_mensagem_us); // Concluída pelo Core 0 ao acionar o servo
+        }
+        multicore_fifo_push_blocking(((uint32_t)c->comando_fifo << 16) | argumento);
+        return;
+    }
+    printf("[comando] rejeitado: %s\n", nome);
+}
+
+// --- Implementação das Funções Públicas ---
+
+uint32_t comandos_mqtt_hash(const char *texto) {
+    uint32_t h = FNV_BASE;
+    while (*texto) {
+        h ^= (uint8_t)*texto++;
+        h *= FNV_PRIMO;
+    }
+    return h;
+}
+
+void comandos_mqtt_registrar_topico(const char *topico) {
+    hash_topico_comando = comandos_mqtt_hash(topico);
+}
+
+void comandos_mqtt_iniciar_mensagem(const char *topico, uint32_t tamanho_total) {
+    (void)tamanho_total; // O payload é consumido em fluxo: o tamanho total não limita nada
+    inicio_mensagem_us = time_us_32();
+    nome_tam = 0;
+    valor_tam = 0;
+    igual_lido = false;
+    fase = comandos_mqtt_hash(topico) == hash_topico_comando ? FASE_NOME : FASE_DESCARTAR;
+}
+
+void comandos_mqtt_consumir(const uint8_t *dados, uint16_t tamanho, bool ultimo) {
+    for (uint16_t i = 0; i < tamanho && fase != FASE_DESCARTAR; i++) {
+        uint8_t c = dados[i];
+        if (fase == FASE_NOME) {
+            if (c >= 'a' && c <= 'z') c -= 'a' - 'A';
+            if ((c >= 'A' && c <= 'Z') || c == '_') {
+                if (nome_tam >= COMANDO_NOME_MAX) { fase = FASE_DESCARTAR; break; }
+                nome[nome_tam++] = (char)c;
+            } else if (c == '=' || (eh_espaco(c) && nome_tam > 0)) {
+                igual_lido = c == '=';
+                fase = FASE_VALOR;
+            } else if (!eh_espaco(c)) {
+                fase = FASE_DESCARTAR;
+            }
+        } else if (fase == FASE_VALOR) {
+            // Espaços só antes do argumento ("NOME = 5"); depois dele, encerram o argumento.
+            if (eh_espaco(c)) {
+                if (valor_tam > 0) fase = FASE_FIM;
+                continue;
+            }
+            if (c == '=' && valor_tam == 0 && !igual_lido) {
+                igual_lido = true;
+                continue;
+            }
+            if (c < 0x21 || c > 0x7E || valor_tam >= COMANDO_VALOR_MAX) { fase = FASE_DESCARTAR; break; }
+            valor[valor_tam++] = (char)c;
+        } else if (!eh_espaco(c)) { // FASE_FIM: texto após o argumento ("INTERVALO=1 0")
+            fase = FASE_DESCARTAR;
+            break;
+        }
+    }
+    if (ultimo) {
+        if (fase != FASE_DESCARTAR && nome_tam > 0) despachar();
+        fase = FASE_DESCARTAR; // Fragmentos extras sem nova mensagem são ignorados
+    }
+}
@@ -0,0 +1,48 @@
+/**
+ * @file comandos_mqtt.h
+ * @brief Interpretador incremental dos comandos recebidos via MQTT (Core 1).
+ * Consome o payload fragmento a fragmento, no próprio buffer do LWIP, sem cópia e
+ * sem limite de tamanho. O tópico é identificado por um hash calculado uma única
+ * vez por mensagem e comparado a hashes pré-calculados na inscrição.
+ *
+ * Comandos aceitos no tópico <DEVICE_ID>/comando/estado (maiúsculas ou minúsculas):
+ *   IRRIGAR, CANCELAR, STATUS,
+ *   LUZ_MAX=<lux>, INTERVALO=<s>, DURACAO=<s>, UMIDADE_ALVO=<%>,
+ *   ID=<device_id>, BROKER=<a.b.c.d>[:porta] (gravados na flash; valem no próximo boot)
+ */
+
+#ifndef COMANDOS_MQTT_H
+#define COMANDOS_MQTT_H
+
+#include "pico/stdlib.h" // Para tipos básicos
+
+#define COMANDO_NOME_MAX 16  // Maior nome de comando aceito
+#define COMANDO_VALOR_MAX 32 // Maior argumento aceito
+
+/**
+ * @brief Registra o tópico de comandos, pré-calculando seu identificador.
+ * @param topico Tópico completo (ex: "bitdoglab_02/comando/estado").
+ */
+void comandos_mqtt_registrar_topico(const char *topico);
+
+/**
+ * @brief Início de uma nova mensagem recebida. Chamada pelo callback de publicação do LWIP.
+ * @param topico Tópico da mensagem.
+ * @param tamanho_total Tamanho total do payload anunciado pelo broker.
+ */
+void comandos_mqtt_iniciar_mensagem(const char *topico, uint32_t tamanho_total);
+
+/**
+ * @brief Consome um fragmento do payload. Ao receber o último fragmento, o comando é despachado ao Core 0.
+ * @param dados Bytes do fragmento.
+ * @param tamanho Quantidade de bytes do fragmento.
+ * @param ultimo true se este é o último fragmento (MQTT_DATA_FLAG_LAST).
+ */
+void comandos_mqtt_consumir(const uint8_t *dados, uint16_t tamanho, bool ultimo);
+
+/**
+ * @brief Hash FNV-1a de 32 bits de uma string terminada em '\0'.
+ */
+uint32_t comandos_mqtt_hash(const char *texto);
+
+#endif // COMANDOS_MQTT_H
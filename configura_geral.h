@@ -23,16 +23,51 @@
 #define SCL_PIN 15 // I2C1 (Display)
 #define I2C0_SDA_PIN 0 // I2C0 (Sensores AHT10, BH1750)
 #define I2C0_SCL_PIN 1 // I2C0 (Sensores AHT10, BH1750)
+#define TCA9548A_HABILITADO 0 // 1 se houver um multiplexador TCA9548A no I2C0 (várias zonas)
+#define TCA9548A_ADDR 0x70
+
+// Sonda capacitiva de umidade do solo (saída analógica)
+#define SOLO_SONDA_HABILITADA 0 // 1 com a sonda ligada; sem ela a entrada do ADC fica flutuando
+#define SOLO_ADC_PIN 28         // ADC2, livre no conector de expansão
+#define SOLO_ADC_SECO 2800      // Leitura bruta (12 bits) com a sonda no ar
+#define SOLO_ADC_MOLHADO 1200   // Leitura bruta com a sonda na água
 
 #define PWM_MAX_DUTY 0xFFFF
 
+// Perfil de movimento do servo irrigador
+#define SERVO_VELOCIDADE_PADRAO_GRAUS_S 120
+#define SERVO_VELOCIDADE_VARREDURA_GRAUS_S 80 // 120 graus em ~1,5 s
+#define SERVO_ACELERACAO_GRAUS_S2 300
+#define SERVO_VARREDURA_ANGULO_MIN 30
+#define SERVO_VARREDURA_ANGULO_MAX 150
+
 // --- Configurações de Rede e MQTT ---
-#define DEVICE_ID "bitdoglab_02"
+// Valores de fábrica: os valores em uso vêm de configuracao.h (persistidos em flash).
+// DEVICE_ID vazio: o ID de fábrica é DEVICE_ID_PREFIXO seguido do número de série da placa
+// em hexadecimal (ex: "estufa_e6614103e7452d2f"), único em uma frota gravada com o mesmo binário.
+#ifndef DEVICE_ID
+#define DEVICE_ID ""
+#endif
+#define DEVICE_ID_PREFIXO "estufa_"
 #define MQTT_BROKER_IP "192.168.0.18"
 #define MQTT_BROKER_PORT 1883
+#define SNTP_SERVIDOR "pool.ntp.org" // Nome ou IP literal (ex: um servidor local de testes)
+
+// --- Limiares de Sensores (padrões de fábrica, ajustáveis por comando) ---
+#define LUZ_MAXIMA_ESTUFA 2000 // Lux
+#define INTERVALO_LEITURA_SENSOR_S 10
 
-// --- Limiares de Sensores ---
-#define LUZ_MAXIMA_ESTUFA 2000.0
+// --- Controle Automático de Irrigação ---
+#define IRRIGACAO_AUTO_HABILITADA 1
+#define IRRIGACAO_DURACAO_PADRAO_S 10      // Duração da rega manual (Botão B / comando IRRIGAR)
+#define IRRIGACAO_UMIDADE_AR_ALVO 60       // Alvo de umidade relativa do ar (%)
+#define IRRIGACAO_UMIDADE_SOLO_ALVO 45     // Alvo de umidade do solo (%), usado quando há sonda
+#define IRRIGACAO_BANDA_MORTA_C100 200     // Erro (centésimos de %) abaixo do qual não se irriga
+#define IRRIGACAO_KP_MS 800                // Milissegundos de rega por % de erro
+#define IRRIGACAO_KI_US 2000               // Microssegundos de rega por %·s de erro acumulado
+#define IRRIGACAO_DURACAO_MIN_S 3          // Regas mais curtas que isso são adiadas
+#define IRRIGACAO_DURACAO_MAX_S 30         // Saturação da saída do controlador
+#define IRRIGACAO_BLOQUEIO_S 1800          // Intervalo mínimo entre regas (s)
 
 // Definições de Timers (em microssegundos)
 #define TEMPO_MSG_BEM_VINDO_US 2500000
@@ -42,15 +77,33 @@
 #define TOPICO_BASE_COMANDO_ESTADO "comando/estado"
 #define TOPICO_HISTORICO "historico"
 #define TOPICO_HEARTBEAT "heartbeat"
+#define TOPICO_IRRIGACAO "irrigacao"
+#define TOPICO_STATUS "status"
+#define TOPICO_BOOT "boot"
+#define TOPICO_RESET "reset"
+#define TOPICO_ENERGIA "energia"
+#define TOPICO_MEMORIA "memoria"
+#define TOPICO_XIP "xip"
+#define TOPICO_DIAGNOSTICO_REDE "diagnostico/rede"
+#define TOPICO_DIAGNOSTICO_LATENCIA "diagnostico/latencia"
+#define TOPICO_AMOSTRA "sensores/amostra"
 
 // --- Comandos FIFO ---
-#define FIFO_CMD_WIFI_CONECTADO 0xFFFE
 #define FIFO_CMD_PUBLICAR_MQTT 0xADD0
-#define FIFO_CMD_MUDAR_ESTADO 0xE5A0
-#define FIFO_CMD_MQTT_CONECTADO 0xBEEF
+#define FIFO_CMD_EVENTO 0xE5A0
+#define FIFO_CMD_ESTADO_REDE 0xBEEF
+// Identificadores de sensor (as leituras chegam ao Core 1 pela fila de amostras.h)
 #define FIFO_CMD_PUB_SENSOR_TEMP 0xADD2
 #define FIFO_CMD_PUB_SENSOR_UMID 0xADD3
 #define FIFO_CMD_PUB_SENSOR_LUZ 0xADD4
+#define FIFO_CMD_PUB_SENSOR_SOLO 0xADD5
+#define FIFO_CMD_SOLICITAR_STATUS 0xC0A0
+#define FIFO_CMD_AJUSTAR_LUZ_MAX 0xC0A1
+#define FIFO_CMD_AJUSTAR_INTERVALO 0xC0A2
+#define FIFO_CMD_AJUSTAR_DURACAO 0xC0A3
+#define FIFO_CMD_AJUSTAR_UMIDADE_ALVO 0xC0A4
+#define FIFO_CMD_SALVAR_REDE 0xC0A5
+#define FIFO_CMD_ESTACIONAR 0xC0AF
 
 // --- Enumerações de Estado e Tipos ---
 enum ModoOperacao {
@@ -59,17 +112,39 @@ enum ModoOperacao {
     MODO_ESTUFA_PROTEGENDO,
     MODO_ESTUFA_PROTEGIDO,
     MODO_ESTUFA_IRRIGACAO,
-    MODO_MSG_IRRIGACAO_FIM
+    MODO_MSG_IRRIGACAO_FIM,
+    NUM_MODOS
+};
+
+// Eventos da máquina de estados (EVENTO_NENHUM = 0 é reservado pelo motor)
+enum EventoSistema {
+    EVT_LUZ_ALTA = 1,
+    EVT_LUZ_NORMAL,
+    EVT_TEMPO_ESGOTADO,
+    EVT_ANIMACAO_CONCLUIDA,
+    EVT_BOTAO_B,
+    EVT_CMD_IRRIGAR,
+    EVT_CMD_CANCELAR,
+    EVT_IRRIGACAO_AUTO
 };
 
-enum WifiStatus {
-    WIFI_STATUS_FAIL, WIFI_STATUS_SUCCESS
+// Estados da conectividade, informados pelo Core 1 (rede.c)
+enum EstadoRede {
+    REDE_OFFLINE,
+    REDE_CONECTANDO_WIFI,
+    REDE_CONECTANDO_MQTT,
+    REDE_ONLINE
 };
 
 enum MQTT_MSG_TYPE {
     MSG_ALARM_LUZ_ON,
     MSG_ALARM_LUZ_OFF,
-    MSG_LOG_HEARTBEAT
+    MSG_LOG_HEARTBEAT,
+    MSG_IRRIGACAO_AUTO,
+    MSG_STATUS,
+    MSG_ENERGIA,
+    MSG_MEMORIA,
+    MSG_XIP
 };
 
 #endif // CONFIGURA_GERAL_H
\ No newline at end of file
@@ -0,0 +1,319 @@
+/**
+ * @file configuracao.c
+ * @brief Implementação do armazenamento da configuração em flash.
+ *
+ * Layout: CONFIG_NUM_SETORES setores no fim da flash, divididos em páginas de 256 bytes.
+ * Cada página guarda um registro completo (cabeçalho + configuração + CRC32). Os registros
+ * são acrescentados em sequência; ao cruzar para um novo setor, esse setor é apagado antes
+ * (o registro vigente está sempre no outro setor). No boot vale o registro íntegro de maior
+ * número de sequência, o que também torna a gravação imune a quedas de energia.
+ */
+
+#include "configuracao.h"
+#include "configura_geral.h"
+#include "energia.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include "pico/multicore.h"
+#include "pico/sync.h"
+#include "pico/unique_id.h"
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+
+// --- Definições Internas ---
+#define CONFIG_NUM_SETORES 2
+#define CONFIG_PAGINAS_POR_SETOR (FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE)
+#define CONFIG_NUM_PAGINAS (CONFIG_NUM_SETORES * CONFIG_PAGINAS_POR_SETOR)
+#define CONFIG_OFFSET (PICO_FLASH_SIZE_BYTES - CONFIG_NUM_SETORES * FLASH_SECTOR_SIZE)
+#define CONFIG_MAGICA 0x45535446u       // "ESTF"
+// O Core 1 é acordado pelo despertador; no pior caso, vê o FIFO ao fim de uma fatia de sono.
+#define CONFIG_TIMEOUT_ESTACIONAR_US ((ENERGIA_FATIA_C1_MS + 100) * 1000)
+
+/**
+ * @struct registro_config_t
+ * @brief Registro gravado em uma página da flash.
+ */
+typedef struct {
+    uint32_t magica;
+    uint32_t sequencia;
+    uint16_t versao;
+    uint16_t tamanho;       ///< sizeof(config_estufa_t) da versão que gravou.
+    config_estufa_t dados;  ///< Seguido do CRC32 de todos os bytes anteriores.
+} registro_config_t;
+
+_Static_assert(sizeof(registro_config_t) + sizeof(uint32_t) <= FLASH_PAGE_SIZE,
+               "registro de configuracao excede uma pagina");
+
+// --- Estado ---
+config_estufa_t configuracao_ativa;
+config_rede_t configuracao_rede_boot;
+
+static uint32_t sequencia_atual;     // 0 = nenhum registro na flash
+static uint16_t proxima_pagina;
+static uint32_t total_gravacoes;     // Gravações desde o boot
+
+// Sincronização com o Core 1 durante a gravação
+static volatile bool pedido_estacionar;
+static volatile bool core1_estacionado;
+
+// Proposta de rede vinda do Core 1
+static critical_section_t secao_proposta;
+static config_rede_t proposta_rede;
+static uint8_t campos_propostos; // Bits PROPOSTA_*: campos de proposta_rede que valem
+
+#define PROPOSTA_ID     (1u << 0)
+#define PROPOSTA_BROKER (1u << 1)
+
+// --- Funções Auxiliares ---
+
+static inline const registro_config_t *registro_na_flash(uint16_t pagina) {
+    return (const registro_config_t *)(uintptr_t)(XIP_BASE + CONFIG_OFFSET + (uint32_t)pagina * FLASH_PAGE_SIZE);
+}
+
+/**
+ * @brief CRC32 (polinômio refletido 0xEDB88320), bit a bit: só roda no boot e em gravações.
+ */
+static uint32_t crc32(const uint8_t *dados, size_t tamanho) {
+    uint32_t crc = 0xFFFFFFFFu;
+    while (tamanho--) {
+        crc ^= *dados++;
+        for (int b = 0; b < 8; b++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1u));
+        }
+    }
+    return ~crc;
+}
+
+static inline uint32_t crc_registro(const registro_config_t *r) {
+    return crc32((const uint8_t *)r, offsetof(registro_config_t, dados) + r->tamanho);
+}
+
+static bool registro_valido(const registro_config_t *r) {
+    if (r->magica != CONFIG_MAGICA || r->versao == 0 || r->versao > CONFIG_VERSAO) return false;
+    if (r->tamanho == 0 || r->tamanho > sizeof(config_estufa_t)) return false;
+    // O CRC fica logo após os dados, no tamanho da versão que gravou o registro.
+    uint32_t crc;
+    memcpy(&crc, (const uint8_t *)&r->dados + r->tamanho, sizeof(crc));
+    return crc == crc_registro(r);
+}
+
+static bool pagina_apagada(uint16_t pagina) {
+    const uint32_t *p = (const uint32_t *)registro_na_flash(pagina);
+    for (size_t i = 0; i < FLASH_PAGE_SIZE / sizeof(uint32_t); i++) {
+        if (p[i] != 0xFFFFFFFFu) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief ID de fábrica derivado do número de série da flash: DEVICE_ID_PREFIXO + 16 dígitos hex.
+ */
+static void id_da_placa(char *destino) {
+    _Static_assert(sizeof(DEVICE_ID_PREFIXO) - 1 + 2 * PICO_UNIQUE_BOARD_ID_SIZE_BYTES < CONFIG_ID_MAX,
+                   "DEVICE_ID_PREFIXO longo demais para o numero de serie");
+    static const char hex[] = "0123456789abcdef";
+    pico_unique_board_id_t serie;
+    pico_get_unique_board_id(&serie);
+    size_t n = strlen(DEVICE_ID_PREFIXO);
+    memcpy(destino, DEVICE_ID_PREFIXO, n);
+    for (size_t i = 0; i < PICO_UNIQUE_BOARD_ID_SIZE_BYTES; i++) {
+        destino[n++] = hex[serie.id[i] >> 4];
+        destino[n++] = hex[serie.id[i] & 0x0F];
+    }
+    destino[n] = '\0';
+}
+
+static void carregar_padroes(config_estufa_t *c) {
+    memset(c, 0, sizeof(*c));
+    c->luz_maxima_mlux = (uint32_t)LUZ_MAXIMA_ESTUFA * 1000u;
+    c->umidade_alvo_c100 = (uint32_t)IRRIGACAO_UMIDADE_AR_ALVO * 100u;
+    c->intervalo_leitura_s = INTERVALO_LEITURA_SENSOR_S;
+    c->duracao_irrigacao_s = IRRIGACAO_DURACAO_PADRAO_S;
+    if (DEVICE_ID[0] != '\0') {
+        strncpy(c->rede.device_id, DEVICE_ID, CONFIG_ID_MAX - 1);
+    } else {
+        id_da_placa(c->rede.device_id);
+    }
+    unsigned a, b, d, e;
+    if (sscanf(MQTT_BROKER_IP, "%u.%u.%u.%u", &a, &b, &d, &e) == 4) {
+        c->rede.broker_ip[0] = a; c->rede.broker_ip[1] = b;
+        c->rede.broker_ip[2] = d; c->rede.broker_ip[3] = e;
+    }
+    c->rede.broker_porta = MQTT_BROKER_PORT;
+}
+
+/**
+ * @brief Converte os campos gravados em float pela versão 1 para ponto fixo.
+ * Os campos ocupam as mesmas posições; apenas a interpretação dos bits muda.
+ */
+static void migrar_v1(config_estufa_t *c) {
+    float luz, umidade;
+    memcpy(&luz, &c->luz_maxima_mlux, sizeof(luz));
+    memcpy(&umidade, &c->umidade_alvo_c100, sizeof(umidade));
+    c->luz_maxima_mlux = luz > 0.0f ? (uint32_t)(luz * 1000.0f + 0.5f) : 0;
+    c->umidade_alvo_c100 = umidade > 0.0f ? (uint32_t)(umidade * 100.0f + 0.5f) : 0;
+}
+
+/**
+ * @brief Pede ao Core 1 que se estacione em RAM e aguarda a confirmação.
+ * @return false se o Core 1 não respondeu a tempo (ex: ocupado conectando ao Wi-Fi).
+ */
+static bool estacionar_core1(void) {
+    core1_estacionado = false;
+    pedido_estacionar = true;
+    __mem_fence_release();
+    if (!multicore_fifo_push_timeout_us((uint32_t)FIFO_CMD_ESTACIONAR << 16, CONFIG_TIMEOUT_ESTACIONAR_US)) {
+        pedido_estacionar = false;
+        return false;
+    }
+    energia_acordar_nucleo1();
+    absolute_time_t limite = make_timeout_time_us(CONFIG_TIMEOUT_ESTACIONAR_US);
+    while (!core1_estacionado) {
+        if (time_reached(limite)) {
+            // Se o pedido for atendido depois, o Core 1 verá a liberação e seguirá direto.
+            pedido_estacionar = false;
+            return false;
+        }
+        tight_loop_contents();
+    }
+    return true;
+}
+
+static inline void liberar_core1(void) {
+    __mem_fence_release();
+    pedido_estacionar = false;
+}
+
+// --- Implementação das Funções Públicas ---
+
+void configuracao_carregar(void) {
+    critical_section_init(&secao_proposta);
+    carregar_padroes(&configuracao_ativa);
+    sequencia_atual = 0;
+    proxima_pagina = 0;
+
+    uint16_t pagina_atual = 0;
+    for (uint16_t p = 0; p < CONFIG_NUM_PAGINAS; p++) {
+        const registro_config_t *r = registro_na_flash(p);
+        if (registro_valido(r) && r->sequencia > sequencia_atual) {
+            sequencia_atual = r->sequencia;
+            pagina_atual = p;
+        }
+    }
+
+    if (sequencia_atual > 0) {
+        // Registros de versões anteriores só cobrem o início da estrutura; o resto fica no padrão.
+        const registro_config_t *r = registro_na_flash(pagina_atual);
+        memcpy(&configuracao_ativa, &r->dados, r->tamanho);
+        if (r->versao == 1) migrar_v1(&configuracao_ativa);
+        configuracao_ativa.rede.device_id[CONFIG_ID_MAX - 1] = '\0';
+        proxima_pagina = (pagina_atual + 1) % CONFIG_NUM_PAGINAS;
+    }
+    configuracao_rede_boot = configuracao_ativa.rede;
+}
+
+bool configuracao_salvar(const config_estufa_t *nova) {
+    static uint8_t buf[FLASH_PAGE_SIZE] __attribute__((aligned(4)));
+    registro_config_t *r = (registro_config_t *)buf;
+
+    memset(buf, 0xFF, FLASH_PAGE_SIZE);
+    r->magica = CONFIG_MAGICA;
+    r->sequencia = sequencia_atual + 1;
+    r->versao = CONFIG_VERSAO;
+    r->tamanho = sizeof(config_estufa_t);
+    r->dados = *nova;
+    uint32_t crc = crc_registro(r);
+    memcpy((uint8_t *)&r->dados + r->tamanho, &crc, sizeof(crc));
+
+    // Cruzando para um novo setor (ou encontrando lixo na página), apaga o setor inteiro.
+    // O registro vigente nunca está no setor apagado.
+    uint16_t pagina = proxima_pagina;
+    bool apagar = (pagina % CONFIG_PAGINAS_POR_SETOR) == 0;
+    if (!apagar && !pagina_apagada(pagina)) {
+        pagina = (pagina / CONFIG_PAGINAS_POR_SETOR + 1) % CONFIG_NUM_SETORES * CONFIG_PAGINAS_POR_SETOR;
+        apagar = true;
+    }
+    uint32_t offset_pagina = CONFIG_OFFSET + (uint32_t)pagina * FLASH_PAGE_SIZE;
+    uint32_t offset_setor = offset_pagina & ~(FLASH_SECTOR_SIZE - 1);
+
+    if (!estacionar_core1()) {
+        printf("[config] Core 1 nao respondeu; configuracao nao gravada\n");
+        return false;
+    }
+    uint32_t ints = save_and_disable_interrupts();
+    if (apagar) flash_range_erase(offset_setor, FLASH_SECTOR_SIZE);
+    flash_range_program(offset_pagina, buf, FLASH_PAGE_SIZE);
+    restore_interrupts(ints);
+    liberar_core1();
+
+    if (!registro_valido(registro_na_flash(pagina))) {
+        printf("[config] verificacao falhou na pagina %u\n", pagina);
+        proxima_pagina = (pagina + 1) % CONFIG_NUM_PAGINAS; // Não insiste na página defeituosa
+        return false;
+    }
+
+    configuracao_ativa = *nova;
+    sequencia_atual = r->sequencia;
+    proxima_pagina = (pagina + 1) % CONFIG_NUM_PAGINAS;
+    total_gravacoes++;
+    return true;
+}
+
+void configuracao_propor_id(const char *id) {
+    critical_section_enter_blocking(&secao_proposta);
+    strncpy(proposta_rede.device_id, id, CONFIG_ID_MAX - 1);
+    proposta_rede.device_id[CONFIG_ID_MAX - 1] = '\0';
+    campos_propostos |= PROPOSTA_ID;
+    critical_section_exit(&secao_proposta);
+    multicore_fifo_push_blocking((uint32_t)FIFO_CMD_SALVAR_REDE << 16);
+}
+
+void configuracao_propor_broker(const uint8_t ip[4], uint16_t porta) {
+    critical_section_enter_blocking(&secao_proposta);
+    memcpy(proposta_rede.broker_ip, ip, sizeof(proposta_rede.broker_ip));
+    proposta_rede.broker_porta = porta;
+    campos_propostos |= PROPOSTA_BROKER;
+    critical_section_exit(&secao_proposta);
+    multicore_fifo_push_blocking((uint32_t)FIFO_CMD_SALVAR_REDE << 16);
+}
+
+bool configuracao_aplicar_proposta_rede(void) {
+    // Parte da configuração gravada (e não do retrato do boot), para que BROKER= seguido
+    // de ID= antes de reiniciar não desfaça a primeira alteração.
+    config_estufa_t nova = configuracao_ativa;
+    critical_section_enter_blocking(&secao_proposta);
+    if (campos_propostos & PROPOSTA_ID) {
+        memcpy(nova.rede.device_id, proposta_rede.device_id, CONFIG_ID_MAX);
+    }
+    if (campos_propostos & PROPOSTA_BROKER) {
+        memcpy(nova.rede.broker_ip, proposta_rede.broker_ip, sizeof(nova.rede.broker_ip));
+        nova.rede.broker_porta = proposta_rede.broker_porta;
+    }
+    campos_propostos = 0;
+    critical_section_exit(&secao_proposta);
+    return configuracao_salvar(&nova);
+}
+
+void __not_in_flash_func(configuracao_estacionar)(void) {
+    uint32_t ints = save_and_disable_interrupts();
+    __mem_fence_acquire();
+    core1_estacionado = true;
+    while (pedido_estacionar) {
+        tight_loop_contents();
+    }
+    core1_estacionado = false;
+    __mem_fence_acquire();
+    restore_interrupts(ints);
+}
+
+void configuracao_imprimir(void) {
+    const config_estufa_t *c = &configuracao_ativa;
+    printf("[config] seq=%lu prox_pag=%u gravacoes=%lu luz_max=%lu umid_alvo=%lu intervalo=%us duracao=%us\n",
+           (unsigned long)sequencia_atual, proxima_pagina, (unsigned long)total_gravacoes,
+           (unsigned long)(c->luz_maxima_mlux / 1000u), (unsigned long)(c->umidade_alvo_c100 / 100u),
+           c->intervalo_leitura_s, c->duracao_irrigacao_s);
+    printf("[config] id=%s broker=%u.%u.%u.%u:%u\n", c->rede.device_id,
+           c->rede.broker_ip[0], c->rede.broker_ip[1], c->rede.broker_ip[2], c->rede.broker_ip[3],
+           c->rede.broker_porta);
+}
@@ -0,0 +1,108 @@
+/**
+ * @file configuracao.h
+ * @brief Configuração de operação persistida em flash.
+ *
+ * Os valores de configura_geral.h passam a ser apenas os padrões de fábrica: no boot,
+ * o registro mais recente gravado na flash é carregado para uma estrutura em RAM, lida
+ * diretamente pelos módulos. Alterações recebidas pelo canal de comandos são gravadas
+ * como um novo registro (versionado e com CRC) em um log circular de páginas que ocupa
+ * os dois últimos setores da flash, distribuindo o desgaste entre todas as páginas.
+ *
+ * Apenas o Core 0 grava. Durante o apagamento/programação o Core 1 fica estacionado em
+ * RAM com as interrupções desligadas, e o Core 0 também desliga as suas.
+ */
+
+#ifndef CONFIGURACAO_H
+#define CONFIGURACAO_H
+
+#include "pico/stdlib.h" // Para tipos básicos
+
+#define CONFIG_VERSAO 2         // Incrementar ao acrescentar campos (sempre no final) ou mudar a representação
+#define CONFIG_ID_MAX 24        // Tamanho máximo do DEVICE_ID, incluindo o '\0'
+
+/**
+ * @struct config_rede_t
+ * @brief Parâmetros de rede. Só têm efeito no boot seguinte à alteração.
+ */
+typedef struct {
+    char device_id[CONFIG_ID_MAX];
+    uint8_t broker_ip[4];
+    uint16_t broker_porta;
+} config_rede_t;
+
+/**
+ * @struct config_estufa_t
+ * @brief Configuração completa da estufa, como gravada na flash.
+ */
+typedef struct {
+    uint32_t luz_maxima_mlux;       ///< Limiar de luminosidade (mlux). Era float (lux) até a versão 1.
+    uint32_t umidade_alvo_c100;     ///< Alvo de umidade relativa do ar (centésimos de %). Era float (%) até a versão 1.
+    uint16_t intervalo_leitura_s;   ///< Período de amostragem dos sensores.
+    uint16_t duracao_irrigacao_s;   ///< Duração da rega manual.
+    config_rede_t rede;
+} config_estufa_t;
+
+// Cópias em RAM; use os acessores abaixo.
+extern config_estufa_t configuracao_ativa;
+extern config_rede_t configuracao_rede_boot;
+
+/**
+ * @brief Configuração em vigor. Acesso direto à cópia em RAM, sem custo de busca.
+ */
+static inline const config_estufa_t *configuracao(void) {
+    return &configuracao_ativa;
+}
+
+/**
+ * @brief Parâmetros de rede carregados no boot (os usados pela conexão atual).
+ */
+static inline const config_rede_t *configuracao_rede(void) {
+    return &configuracao_rede_boot;
+}
+
+/**
+ * @brief Carrega o registro válido mais recente da flash, ou os padrões de configura_geral.h.
+ * Deve ser chamada pelo Core 0 antes de iniciar o Core 1.
+ */
+void configuracao_carregar(void);
+
+/**
+ * @brief Grava uma nova configuração e, se a gravação for bem-sucedida, passa a usá-la.
+ * A operação é atômica: em caso de falha a configuração em vigor não muda.
+ * Somente o Core 0 pode chamar esta função.
+ * @param nova Configuração completa a gravar.
+ * @return true se o registro foi gravado e verificado.
+ */
+bool configuracao_salvar(const config_estufa_t *nova);
+
+/**
+ * @brief Propõe um novo DEVICE_ID (chamada pelo Core 1 ao receber um comando).
+ * A proposta é entregue ao Core 0 via FIFO_CMD_SALVAR_REDE e gravada por ele. Só o campo
+ * proposto muda: os demais vêm da última configuração gravada, não da do boot.
+ * @param id Identificador já validado, com menos de CONFIG_ID_MAX caracteres.
+ */
+void configuracao_propor_id(const char *id);
+
+/**
+ * @brief Propõe um novo broker MQTT, nas mesmas condições de configuracao_propor_id().
+ */
+void configuracao_propor_broker(const uint8_t ip[4], uint16_t porta);
+
+/**
+ * @brief Grava os campos de rede propostos pelo Core 1 desde a última gravação
+ * (tratador de FIFO_CMD_SALVAR_REDE).
+ */
+bool configuracao_aplicar_proposta_rede(void);
+
+/**
+ * @brief Estaciona o Core 1 enquanto o Core 0 grava a flash (tratador de FIFO_CMD_ESTACIONAR).
+ * Executa da RAM com as interrupções desligadas até o fim da gravação.
+ */
+void configuracao_estacionar(void);
+
+/**
+ * @brief Imprime a configuração em vigor e a posição atual do log na flash.
+ */
+void configuracao_imprimir(void);
+
+#endif // CONFIGURACAO_H
@@ -1,13 +1,32 @@
 #include "display.h"
 #include "configura_geral.h"
 #include "ssd1306_i2c.h" // Inclui diretamente a API de baixo nível
+#include "perfil.h"
 #include <string.h> // Adicione esta linha para a função memset
 
 // Definição e alocação de memória para o buffer do OLED e a área de renderização,
 // visíveis apenas dentro deste arquivo (display.c)
-static uint8_t buffer_oled[ssd1306_buffer_length];
+static uint8_t buffer_oled[ssd1306_buffer_length] __attribute__((aligned(4))); // Alinhado para as cópias de glifo em 32 bits
 static struct render_area area;
 
+// Indicador de conectividade no canto superior direito (página 0), presente em todas as telas.
+// Os títulos quebram antes dele: 15 caracteres por linha em vez de 16.
+// Colunas de 8 pixels, bit 0 no topo; índices seguem enum EstadoRede.
+#define INDICADOR_LARGURA 7
+#define INDICADOR_COLUNA (ssd1306_width - INDICADOR_LARGURA)
+static const uint8_t icones_rede[][INDICADOR_LARGURA] = {
+    [REDE_OFFLINE]         = { 0x41, 0x22, 0x14, 0x08, 0x14, 0x22, 0x41 }, // X
+    [REDE_CONECTANDO_WIFI] = { 0xC0, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80 }, // 1 barra
+    [REDE_CONECTANDO_MQTT] = { 0xC0, 0x00, 0xF0, 0x00, 0xFC, 0x00, 0x80 }, // 3 barras
+    [REDE_ONLINE]          = { 0xC0, 0x00, 0xF0, 0x00, 0xFC, 0x00, 0xFF }, // 4 barras
+};
+static uint8_t estado_rede = REDE_OFFLINE;
+static struct render_area area_indicador;
+
+static inline void display_desenhar_indicador(uint8_t *buffer) {
+    memcpy(buffer + INDICADOR_COLUNA, icones_rede[estado_rede], INDICADOR_LARGURA);
+}
+
 // Função auxiliar estática para limpar o buffer e a tela.
 // "static" significa que ela só é visível dentro deste arquivo.
 static void display_clear() {
@@ -36,26 +55,75 @@ void display_init() {
     area.end_page = ssd1306_n_pages - 1;
     calculate_render_area_buffer_length(&area);
 
+    area_indicador.start_column = INDICADOR_COLUNA;
+    area_indicador.end_column = ssd1306_width - 1;
+    area_indicador.start_page = 0;
+    area_indicador.end_page = 0;
+    calculate_render_area_buffer_length(&area_indicador);
+
     // Limpa o display ao iniciar
     display_clear();
 }
 
-// Implementação da função de exibir mensagens
-void display_show_message(const char *line1, const char *line2, const char *line3) {
+// Implementação da composição do quadro
+void display_compor_mensagem(uint8_t *buffer, const char *line1, const char *line2, const char *line3) {
     // Primeiro, limpa o buffer com zeros.
-    memset(buffer_oled, 0, ssd1306_buffer_length);
+    memset(buffer, 0, ssd1306_buffer_length);
 
     // Desenha cada linha no buffer, se ela não for nula
     if (line1) {
-        ssd1306_draw_utf8_multiline(buffer_oled, 0, 0, line1);
+        ssd1306_draw_utf8_largura(buffer, 0, 0, line1, 1, INDICADOR_COLUNA);
     }
     if (line2) {
-        ssd1306_draw_utf8_multiline(buffer_oled, 0, 28, line2);
+        ssd1306_draw_utf8_multiline(buffer, 0, 28, line2);
     }
     if (line3) {
-        ssd1306_draw_utf8_multiline(buffer_oled, 0, 56, line3);
+        ssd1306_draw_utf8_multiline(buffer, 0, 56, line3);
     }
+}
+
+// Implementação da tela com leitura em destaque (fonte dupla)
+void display_show_destaque(const char *titulo, const char *destaque, const char *rodape) {
+    PERFIL_INICIO(t_display);
+
+    memset(buffer_oled, 0, ssd1306_buffer_length);
+    if (titulo) {
+        ssd1306_draw_utf8_largura(buffer_oled, 0, 0, titulo, 1, INDICADOR_COLUNA);
+    }
+    if (destaque) {
+        ssd1306_draw_utf8_escala(buffer_oled, 0, 20, destaque, 2);
+    }
+    if (rodape) {
+        ssd1306_draw_utf8_multiline(buffer_oled, 0, 48, rodape);
+    }
+    display_desenhar_indicador(buffer_oled);
+    render_on_display(buffer_oled, &area);
+
+    PERFIL_FIM(PERFIL_FASE_DISPLAY, t_display);
+}
+
+// Implementação da função de exibir mensagens
+void display_show_message(const char *line1, const char *line2, const char *line3) {
+    PERFIL_INICIO(t_display);
+
+    display_compor_mensagem(buffer_oled, line1, line2, line3);
+    display_desenhar_indicador(buffer_oled);
 
     // Finalmente, envia o buffer pronto para a tela de uma vez
     render_on_display(buffer_oled, &area);
-}
\ No newline at end of file
+
+    PERFIL_FIM(PERFIL_FASE_DISPLAY, t_display);
+}
+
+// Atualiza só o indicador de rede: envia apenas as colunas do ícone, sem redesenhar a tela
+void display_definir_estado_rede(uint8_t estado) {
+    if (estado >= count_of(icones_rede) || estado == estado_rede) return;
+    estado_rede = estado;
+    display_desenhar_indicador(buffer_oled);
+    render_on_display(buffer_oled + INDICADOR_COLUNA, &area_indicador); // Página 0: bytes contíguos
+}
+
+// Apaga/acende o painel sem perder o quadro atual
+void display_definir_ligado(bool ligado) {
+    ssd1306_ligar(ligado);
+}
@@ -1,6 +1,8 @@
 #ifndef DISPLAY_H
 #define DISPLAY_H
 
+#include "pico/stdlib.h" // Para uint8_t
+
 // Inicializa o display OLED e o barramento I2C. Deve ser chamada uma vez.
 void display_init();
 
@@ -8,4 +10,19 @@ void display_init();
 // As linhas podem ser NULL para não desenhar nada naquela posição.
 void display_show_message(const char *line1, const char *line2, const char *line3);
 
+// Exibe um título, uma leitura em fonte dupla (16x16, até 8 caracteres por linha)
+// e um rodapé. Qualquer parâmetro pode ser NULL.
+void display_show_destaque(const char *titulo, const char *destaque, const char *rodape);
+
+// Compõe até três linhas de texto em um buffer de quadro (ssd1306_buffer_length bytes),
+// sem enviar nada ao display.
+void display_compor_mensagem(uint8_t *buffer, const char *line1, const char *line2, const char *line3);
+
+// Atualiza o ícone de conectividade (enum EstadoRede) no canto superior direito.
+// Só as colunas do ícone são enviadas ao display; as próximas telas já o incluem.
+void display_definir_estado_rede(uint8_t estado);
+
+// Liga ou apaga o painel (modo de baixo consumo). O conteúdo é preservado.
+void display_definir_ligado(bool ligado);
+
 #endif // DISPLAY_H
\ No newline at end of file
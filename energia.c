@@ -0,0 +1,124 @@
+/**
+ * @file energia.c
+ * @brief Implementação do modo de baixo consumo e da contabilidade de sono.
+ */
+
+#include "energia.h"
+#include "hardware/clocks.h"
+#include "pico/cyw43_arch.h"
+#include "pico/multicore.h" // Para get_core_num
+#include "formato.h"
+#include "pico/async_context.h"
+#include <stdio.h>
+
+// Contadores cumulativos por núcleo (32 bits: leitura atômica pelo outro núcleo;
+// o relatório usa diferenças, que sobrevivem ao estouro).
+static volatile uint32_t dormindo_us[2];
+static volatile uint32_t despertares[2];
+
+static volatile bool despertar_pendente; // Evento do Core 0 sinalizado por ISR
+
+#if ESTUFA_BAIXO_CONSUMO
+/**
+ * @brief Trabalho vazio: basta ser agendado para que a espera do Core 1 termine.
+ */
+static void atender_despertar(async_context_t *contexto, async_when_pending_worker_t *trabalhador) {
+    (void)contexto;
+    (void)trabalhador;
+}
+
+static async_when_pending_worker_t despertador = { .do_work = atender_despertar };
+static volatile bool despertador_registrado;
+#endif
+
+void energia_configurar_clock(void) {
+#if ESTUFA_BAIXO_CONSUMO
+    set_sys_clock_khz(ENERGIA_CLK_SYS_KHZ, true);
+#endif
+}
+
+void energia_dormir_ate(absolute_time_t instante) {
+    uint core = get_core_num();
+    uint32_t inicio = time_us_32();
+    if (core == 1) {
+#if ESTUFA_BAIXO_CONSUMO
+        // Espera em fatias: se o despertar do Core 0 se perder, o FIFO ainda é visto a tempo.
+        // Uma espera que termina antes da fatia é trabalho do CYW43 ou o despertador.
+        while (true) {
+            absolute_time_t fatia = make_timeout_time_ms(ENERGIA_FATIA_C1_MS);
+            absolute_time_t limite = absolute_time_diff_us(instante, fatia) > 0 ? instante : fatia;
+            cyw43_arch_wait_for_work_until(limite);
+            if (!time_reached(limite) || time_reached(instante) || multicore_fifo_rvalid()) break;
+        }
+#else
+        (void)instante;
+        cyw43_arch_poll();
+        sleep_ms(1);
+#endif
+    } else {
+#if ESTUFA_BAIXO_CONSUMO
+        // Cada WFE termina em qualquer interrupção (o alarme do stdio USB dispara a cada 1 ms);
+        // só volta ao laço no prazo ou em um evento que ele precise atender.
+        while (!time_reached(instante) && !multicore_fifo_rvalid() && !despertar_pendente) {
+            best_effort_wfe_or_timeout(instante);
+        }
+        despertar_pendente = false;
+#else
+        (void)instante;
+        return; // O Core 0 segue em laço contínuo
+#endif
+    }
+    dormindo_us[core] += time_us_32() - inicio;
+    despertares[core]++;
+}
+
+void energia_iniciar_nucleo1(void) {
+#if ESTUFA_BAIXO_CONSUMO
+    async_context_t *contexto = cyw43_arch_async_context();
+    if (contexto && async_context_add_when_pending_worker(contexto, &despertador)) {
+        despertador_registrado = true;
+    }
+#endif
+}
+
+void energia_acordar_nucleo1(void) {
+#if ESTUFA_BAIXO_CONSUMO
+    // Seguro a partir do outro núcleo: o contexto agenda o trabalho no núcleo dono dele.
+    if (despertador_registrado) async_context_set_work_pending(cyw43_arch_async_context(), &despertador);
+#endif
+}
+
+void energia_sinalizar_despertar(void) {
+    despertar_pendente = true;
+}
+
+int energia_formatar(char *destino, size_t tamanho) {
+    static uint32_t ultimo_relatorio_us, ultimo_dormindo[2], ultimo_despertares[2];
+    uint32_t agora = time_us_32();
+    uint32_t janela = agora - ultimo_relatorio_us;
+    if (janela == 0) janela = 1;
+    int32_t ativo_d10[2], taxa_d10[2]; // Em décimos
+    for (int c = 0; c < 2; c++) {
+        uint32_t d = dormindo_us[c], n = despertares[c];
+        uint32_t sono = d - ultimo_dormindo[c];
+        ativo_d10[c] = sono >= janela ? 0 : (int32_t)((uint64_t)(janela - sono) * 1000 / janela);
+        taxa_d10[c] = (int32_t)((uint64_t)(n - ultimo_despertares[c]) * 10000000 / janela);
+        ultimo_dormindo[c] = d;
+        ultimo_despertares[c] = n;
+    }
+    ultimo_relatorio_us = agora;
+    formato_t f;
+    formato_iniciar(&f, destino, tamanho);
+    formato_texto(&f, "{\"clk_mhz\":");
+    formato_uint(&f, clock_get_hz(clk_sys) / 1000000);
+    formato_texto(&f, ",\"ativo_c0\":");
+    formato_decimal(&f, ativo_d10[0], 1);
+    formato_texto(&f, ",\"ativo_c1\":");
+    formato_decimal(&f, ativo_d10[1], 1);
+    formato_texto(&f, ",\"desp_s_c0\":");
+    formato_decimal(&f, taxa_d10[0], 1);
+    formato_texto(&f, ",\"desp_s_c1\":");
+    formato_decimal(&f, taxa_d10[1], 1);
+    formato_caractere(&f, '}');
+    return (int)formato_tamanho(&f);
+}
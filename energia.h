@@ -0,0 +1,70 @@
+/**
+ * @file energia.h
+ * @brief Modo de baixo consumo para estufas alimentadas por bateria/painel solar.
+ *
+ * Com ESTUFA_BAIXO_CONSUMO=1:
+ *   - clk_sys é reduzido no boot (ENERGIA_CLK_SYS_KHZ), antes de configurar os periféricos;
+ *   - o CYW43 entra em economia agressiva enquanto conectado;
+ *   - os dois núcleos dormem até o próximo evento agendado, acordando antes só por um
+ *     evento que o laço precisa atender: botão ou mensagem no FIFO (Core 0), trabalho do
+ *     CYW43 ou mensagem do Core 0 (Core 1). Outras interrupções (alarme do stdio USB,
+ *     PWM do LED e do servo) voltam a dormir sem passar pelo laço;
+ *   - o display é apagado após ENERGIA_DISPLAY_APAGAR_S sem atividade.
+ * Em qualquer modo, o tempo dormido e o número de despertares de cada núcleo são
+ * contabilizados para estimar o ciclo de trabalho e dimensionar a bateria.
+ */
+
+#ifndef ENERGIA_H
+#define ENERGIA_H
+
+#include "pico/stdlib.h" // Para absolute_time_t
+
+#ifndef ESTUFA_BAIXO_CONSUMO
+#define ESTUFA_BAIXO_CONSUMO 0
+#endif
+
+#define ENERGIA_CLK_SYS_KHZ 48000      // clk_sys no modo de baixo consumo (padrão do SDK: 125 MHz)
+#define ENERGIA_SONO_MAX_MS 1000       // Sono máximo por iteração (abaixo do orçamento do supervisor)
+#define ENERGIA_TICK_ATIVO_MS 20       // Período do laço com animações/temporizadores em curso
+#define ENERGIA_FATIA_C1_MS 100        // Maior espera do Core 1 sem olhar o FIFO (rede de segurança do despertar)
+#define ENERGIA_DISPLAY_APAGAR_S 30    // Inatividade até apagar o display
+
+/**
+ * @brief Ajusta clk_sys para o modo de energia do build. Deve ser chamada pelo Core 0 antes de
+ * inicializar qualquer periférico, pois os divisores de PWM, PIO, I2C e UART são calculados a
+ * partir de clock_get_hz() na inicialização.
+ */
+void energia_configurar_clock(void);
+
+/**
+ * @brief Dorme até o instante indicado ou até o próximo evento, contabilizando o sono.
+ * No Core 1 o sono é feito por cyw43_arch_wait_for_work_until(), que também atende o CYW43.
+ * Sem ESTUFA_BAIXO_CONSUMO, o Core 0 não dorme e o Core 1 mantém o passo de 1 ms.
+ */
+void energia_dormir_ate(absolute_time_t instante);
+
+/**
+ * @brief Registra o despertador do Core 1 no contexto assíncrono do CYW43.
+ * Chamada pelo Core 1 depois de cyw43_arch_init().
+ */
+void energia_iniciar_nucleo1(void);
+
+/**
+ * @brief Acorda o Core 1 depois que o Core 0 escreve no FIFO. Um SEV não libera a espera
+ * do contexto assíncrono do CYW43; sem isso o Core 1 só veria a mensagem no fim da fatia.
+ */
+void energia_acordar_nucleo1(void);
+
+/**
+ * @brief Marca um despertar do Core 0 que o laço precisa atender (ex: botão). Chamada de ISR.
+ */
+void energia_sinalizar_despertar(void);
+
+/**
+ * @brief Escreve em JSON o ciclo de trabalho (% acordado) e os despertares por segundo de
+ * cada núcleo desde o relatório anterior. Deve ser chamada sempre do mesmo núcleo.
+ * @return Número de caracteres escritos (sem o '\0'; o texto é truncado se não couber).
+ */
+int energia_formatar(char *destino, size_t tamanho);
+
+#endif // ENERGIA_H
@@ -0,0 +1,110 @@
+/**
+ * @file formato.c
+ * @brief Implementação da formatação de texto sem printf.
+ * Os dígitos são gerados de trás para frente em um buffer local; as divisões por 10
+ * usam o divisor de hardware do RP2040 (as rotinas de divisão do SDK o chamam).
+ */
+
+#include "formato.h"
+#include "na_ram.h"
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Acrescenta n caracteres, truncando no fim do destino.
+ */
+static void NA_RAM(acrescentar)(formato_t *f, const char *texto, size_t n) {
+    size_t livre = f->tamanho - 1 - f->pos;
+    if (n > livre) {
+        n = livre;
+        f->truncado = true;
+    }
+    for (size_t i = 0; i < n; i++) {
+        f->destino[f->pos + i] = texto[i];
+    }
+    f->pos += n;
+    f->destino[f->pos] = '\0';
+}
+
+/**
+ * @brief Escreve os dígitos de valor, com pelo menos min_digitos (completando com zeros).
+ * @param fim Posição seguinte ao último dígito; deve haver espaço para todos os dígitos antes dela.
+ * @return Ponteiro para o primeiro dígito.
+ */
+static char *NA_RAM(digitos)(char *fim, uint32_t valor, uint8_t min_digitos) {
+    char *p = fim;
+    do {
+        *--p = (char)('0' + valor % 10);
+        valor /= 10;
+        if (min_digitos) min_digitos--;
+    } while (valor || min_digitos);
+    return p;
+}
+
+// --- Implementação das Funções Públicas ---
+
+void formato_iniciar(formato_t *f, char *destino, size_t tamanho) {
+    f->destino = destino;
+    f->tamanho = tamanho;
+    f->pos = 0;
+    f->truncado = false;
+    destino[0] = '\0';
+}
+
+void NA_RAM(formato_texto)(formato_t *f, const char *texto) {
+    size_t n = 0;
+    while (texto[n]) n++;
+    acrescentar(f, texto, n);
+}
+
+void NA_RAM(formato_caractere)(formato_t *f, char c) {
+    acrescentar(f, &c, 1);
+}
+
+void NA_RAM(formato_uint)(formato_t *f, uint32_t valor) {
+    char buf[10];
+    char *p = digitos(buf + sizeof(buf), valor, 0);
+    acrescentar(f, p, (size_t)(buf + sizeof(buf) - p));
+}
+
+void formato_uint64(formato_t *f, uint64_t valor) {
+    // Em blocos de 9 dígitos: só uma ou duas divisões de 64 bits, o resto em 32 bits.
+    char buf[20];
+    char *fim = buf + sizeof(buf);
+    char *p = fim;
+    while (valor >= 1000000000u) {
+        p = digitos(p, (uint32_t)(valor % 1000000000u), 9);
+        valor /= 1000000000u;
+    }
+    p = digitos(p, (uint32_t)valor, 0);
+    acrescentar(f, p, (size_t)(fim - p));
+}
+
+void NA_RAM(formato_int)(formato_t *f, int32_t valor) {
+    if (valor < 0) {
+        formato_caractere(f, '-');
+        formato_uint(f, 0u - (uint32_t)valor);
+    } else {
+        formato_uint(f, (uint32_t)valor);
+    }
+}
+
+void NA_RAM(formato_decimal)(formato_t *f, int32_t valor, uint8_t casas) {
+    static const uint32_t potencias[] = {
+        1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u
+    };
+    if (casas > 9) casas = 9;
+    uint32_t abs_valor = valor < 0 ? 0u - (uint32_t)valor : (uint32_t)valor;
+    uint32_t escala = potencias[casas];
+
+    char buf[21];
+    char *fim = buf + sizeof(buf);
+    char *p = fim;
+    if (casas) {
+        p = digitos(p, abs_valor % escala, casas);
+        *--p = '.';
+    }
+    p = digitos(p, abs_valor / escala, 0);
+    if (valor < 0) *--p = '-';
+    acrescentar(f, p, (size_t)(fim - p));
+}
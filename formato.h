@@ -0,0 +1,79 @@
+/**
+ * @file formato.h
+ * @brief Formatação de texto sem printf: inteiros, decimais em ponto fixo e cadeias,
+ * acrescentados a um buffer do chamador.
+ * Não aloca memória nem usa ponto flutuante. O destino fica sempre terminado em '\0';
+ * o que não couber é descartado e a truncagem fica registrada no formatador.
+ */
+
+#ifndef FORMATO_H
+#define FORMATO_H
+
+#include "pico/stdlib.h" // Para tipos básicos
+#include <stddef.h>
+
+/**
+ * @struct formato_t
+ * @brief Posição de escrita em um buffer do chamador.
+ */
+typedef struct {
+    char *destino;
+    size_t tamanho;  ///< Capacidade do destino, incluindo o '\0'.
+    size_t pos;      ///< Caracteres escritos até agora.
+    bool truncado;   ///< Algum trecho não coube.
+} formato_t;
+
+/**
+ * @brief Começa a escrever no início de um buffer (que passa a conter a cadeia vazia).
+ * @param tamanho Capacidade do destino em bytes; deve ser pelo menos 1.
+ */
+void formato_iniciar(formato_t *f, char *destino, size_t tamanho);
+
+/**
+ * @brief Acrescenta uma cadeia terminada em '\0'.
+ */
+void formato_texto(formato_t *f, const char *texto);
+
+/**
+ * @brief Acrescenta um caractere.
+ */
+void formato_caractere(formato_t *f, char c);
+
+/**
+ * @brief Acrescenta um inteiro sem sinal em base 10.
+ */
+void formato_uint(formato_t *f, uint32_t valor);
+
+/**
+ * @brief Acrescenta um inteiro sem sinal de 64 bits em base 10 (ex: horários em ms).
+ */
+void formato_uint64(formato_t *f, uint64_t valor);
+
+/**
+ * @brief Acrescenta um inteiro com sinal em base 10.
+ */
+void formato_int(formato_t *f, int32_t valor);
+
+/**
+ * @brief Acrescenta um valor em ponto fixo decimal com um número fixo de casas.
+ * Ex: formato_decimal(f, -1205, 2) escreve "-12.05"; formato_decimal(f, 7, 1) escreve "0.7".
+ * @param valor Valor já escalado por 10^casas.
+ * @param casas Casas decimais (0 a 9).
+ */
+void formato_decimal(formato_t *f, int32_t valor, uint8_t casas);
+
+/**
+ * @brief Número de caracteres escritos (sem o '\0').
+ */
+static inline size_t formato_tamanho(const formato_t *f) {
+    return f->pos;
+}
+
+/**
+ * @brief Indica se todo o texto acrescentado coube no destino.
+ */
+static inline bool formato_completo(const formato_t *f) {
+    return !f->truncado;
+}
+
+#endif // FORMATO_H
@@ -0,0 +1,32 @@
+/**
+ * @file bench_host.c
+ * @brief Os micro-benchmarks de bench.c rodando no host, com os mesmos casos e a mesma
+ * saída do boot da placa com ESTUFA_BENCH=1.
+ *
+ * O SysTick simulado conta os ciclos do processador do host (TSC), e o clk_sys é ajustado
+ * para a frequência dele: os ciclos e µs por operação são do host, não do RP2040.
+ *
+ * Uso: bench_host
+ */
+
+#include "bench.h"
+#include "configuracao.h"
+#include "escalonador.h"
+#include "hardware/clocks.h"
+#include "placa.h"
+
+uint64_t placa_systick_hz(void);
+
+int main(void) {
+    escalonador_iniciar(false);
+    placa_config_t cfg = {
+        .device_id = "bitdoglab_02",
+        .numero_serie = 0xE57F0A0000000001ull,
+        .console = stdout,
+    };
+    placa_ligar(&cfg); // Os núcleos não rodam: o escalonador nunca é executado
+    set_sys_clock_khz((uint32_t)(placa_systick_hz() / 1000), true);
+    configuracao_carregar(); // Como no boot: os casos de formatação leem a configuração
+    bench_executar();
+    return 0;
+}
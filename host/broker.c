@@ -0,0 +1,255 @@
+/**
+ * @file broker.c
+ * @brief Implementação do broker MQTT em processo do ensaio de latência.
+ */
+
+#include "broker.h"
+#include "escalonador.h"
+#include "mqtt_pacote.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define BROKER_ASSINATURAS_MAX 8
+#define BROKER_TOPICO_MAX 128
+
+typedef enum { TRECHO_CONECTAR, TRECHO_PARA_BROKER, TRECHO_ACK, TRECHO_PARA_PLACA } tipo_trecho_t;
+
+/**
+ * @brief Bytes (ou o aviso de conexão) atravessando o enlace em um dos sentidos.
+ */
+typedef struct {
+    broker_t *broker;
+    tipo_trecho_t tipo;
+    uint32_t sessao;
+    size_t tamanho;
+    uint8_t dados[];
+} trecho_t;
+
+struct broker {
+    uint32_t latencia_us;
+    broker_recebido_t recebido;
+    void *ctx;
+    const placa_rede_eventos_t *eventos;
+    uint32_t sessao;            // Trechos de conexões anteriores são descartados
+    bool aberta;
+    bool aceita;                // CONNACK enviado
+    size_t pendentes;           // Bytes enviados pela placa ainda sem ACK
+    uint8_t *rx;
+    size_t rx_tamanho, rx_capacidade;
+    char assinaturas[BROKER_ASSINATURAS_MAX][BROKER_TOPICO_MAX];
+    int num_assinaturas;
+    uint16_t proximo_id;
+};
+
+// --- Funções Auxiliares ---
+
+static void entregar_trecho(void *ctx);
+
+/**
+ * @param dados NULL no ACK, que só leva o tamanho confirmado.
+ */
+static void agendar_trecho(broker_t *b, tipo_trecho_t tipo, uint64_t atraso_us, const uint8_t *dados, size_t tamanho) {
+    trecho_t *t = malloc(sizeof(trecho_t) + (dados ? tamanho : 0));
+    if (!t) abort();
+    t->broker = b;
+    t->tipo = tipo;
+    t->sessao = b->sessao;
+    t->tamanho = tamanho;
+    if (dados && tamanho) memcpy(t->dados, dados, tamanho);
+    escalonador_agendar(escalonador_agora_us() + atraso_us, entregar_trecho, t);
+}
+
+static void enviar_para_placa(broker_t *b, const uint8_t *dados, size_t tamanho) {
+    agendar_trecho(b, TRECHO_PARA_PLACA, b->latencia_us, dados, tamanho);
+}
+
+/**
+ * @brief Casa um tópico com um filtro de assinatura ('+' e '#' do MQTT).
+ */
+static bool topico_casa(const char *filtro, const char *topico) {
+    while (*filtro) {
+        if (*filtro == '#') return true;
+        if (*filtro == '+') {
+            while (*topico && *topico != '/') topico++;
+            filtro++;
+            continue;
+        }
+        if (*filtro != *topico) return false;
+        filtro++;
+        topico++;
+    }
+    return *topico == '\0';
+}
+
+static void tratar_publish(broker_t *b, const mqtt_pacote_t *pacote) {
+    mqtt_publish_t p;
+    if (!mqtt_pacote_ler_publish(pacote, &p) || p.topico_tamanho >= BROKER_TOPICO_MAX) return;
+    if (p.qos > 0) {
+        uint8_t puback[4];
+        enviar_para_placa(b, puback, mqtt_pacote_puback(puback, p.id));
+    }
+    char topico[BROKER_TOPICO_MAX];
+    memcpy(topico, p.topico, p.topico_tamanho);
+    topico[p.topico_tamanho] = '\0';
+    char *payload = malloc(p.payload_tamanho + 1);
+    if (!payload) abort();
+    memcpy(payload, p.payload, p.payload_tamanho);
+    payload[p.payload_tamanho] = '\0';
+    if (b->recebido) b->recebido(b->ctx, topico, payload, p.payload_tamanho);
+    free(payload);
+}
+
+static void tratar_subscribe(broker_t *b, const mqtt_pacote_t *pacote) {
+    if (pacote->tamanho < 5) return;
+    uint16_t id = mqtt_pacote_id(pacote);
+    size_t n = (size_t)((pacote->corpo[2] << 8) | pacote->corpo[3]);
+    if (4 + n + 1 > pacote->tamanho || n >= BROKER_TOPICO_MAX) return;
+    uint8_t qos = pacote->corpo[4 + n] > 1 ? 1 : pacote->corpo[4 + n];
+    if (b->num_assinaturas < BROKER_ASSINATURAS_MAX) {
+        memcpy(b->assinaturas[b->num_assinaturas], pacote->corpo + 4, n);
+        b->assinaturas[b->num_assinaturas++][n] = '\0';
+    }
+    uint8_t suback[5];
+    enviar_para_placa(b, suback, mqtt_pacote_suback(suback, id, qos));
+}
+
+static void tratar_pacote(broker_t *b, const mqtt_pacote_t *pacote) {
+    switch (pacote->tipo) {
+        case MQTT_PACOTE_CONNECT: {
+            uint8_t connack[4];
+            enviar_para_placa(b, connack, mqtt_pacote_connack(connack, 0));
+            b->aceita = true;
+            break;
+        }
+        case MQTT_PACOTE_PUBLISH:
+            tratar_publish(b, pacote);
+            break;
+        case MQTT_PACOTE_SUBSCRIBE:
+            tratar_subscribe(b, pacote);
+            break;
+        case MQTT_PACOTE_PINGREQ: {
+            const uint8_t pingresp[2] = { MQTT_PACOTE_PINGRESP << 4, 0 };
+            enviar_para_placa(b, pingresp, sizeof(pingresp));
+            break;
+        }
+        default:
+            break; // PUBACK das publicações do broker: nada a fazer
+    }
+}
+
+static void receber(broker_t *b, const uint8_t *dados, size_t tamanho) {
+    if (b->rx_tamanho + tamanho > b->rx_capacidade) {
+        b->rx_capacidade = (b->rx_tamanho + tamanho) * 2;
+        b->rx = realloc(b->rx, b->rx_capacidade);
+        if (!b->rx) abort();
+    }
+    memcpy(b->rx + b->rx_tamanho, dados, tamanho);
+    b->rx_tamanho += tamanho;
+    size_t lidos = 0;
+    for (;;) {
+        mqtt_pacote_t pacote;
+        long n = mqtt_pacote_extrair(b->rx + lidos, b->rx_tamanho - lidos, &pacote);
+        if (n <= 0) break; // Malformado: a placa nunca manda, e o ensaio acusa a falta da medida
+        lidos += (size_t)n;
+        tratar_pacote(b, &pacote);
+    }
+    memmove(b->rx, b->rx + lidos, b->rx_tamanho - lidos);
+    b->rx_tamanho -= lidos;
+}
+
+static void entregar_trecho(void *ctx) {
+    trecho_t *t = ctx;
+    broker_t *b = t->broker;
+    if (t->sessao == b->sessao && b->aberta) {
+        switch (t->tipo) {
+            case TRECHO_CONECTAR:
+                b->eventos->conectada(true);
+                break;
+            case TRECHO_PARA_BROKER:
+                receber(b, t->dados, t->tamanho);
+                agendar_trecho(b, TRECHO_ACK, b->latencia_us, NULL, t->tamanho);
+                break;
+            case TRECHO_ACK:
+                b->pendentes -= t->tamanho;
+                b->eventos->enviados();
+                break;
+            case TRECHO_PARA_PLACA:
+                b->eventos->receber(t->dados, t->tamanho);
+                break;
+        }
+    }
+    free(t);
+}
+
+// --- Transporte (lado da placa) ---
+
+static bool transporte_abrir(void *ctx, const placa_rede_eventos_t *eventos) {
+    broker_t *b = ctx;
+    b->sessao++;
+    b->eventos = eventos;
+    b->aberta = true;
+    b->aceita = false;
+    b->pendentes = 0;
+    b->rx_tamanho = 0;
+    b->num_assinaturas = 0;
+    agendar_trecho(b, TRECHO_CONECTAR, 2 * (uint64_t)b->latencia_us, NULL, 0); // SYN e SYN-ACK
+    return true;
+}
+
+static void transporte_enviar(void *ctx, const uint8_t *dados, size_t tamanho) {
+    broker_t *b = ctx;
+    b->pendentes += tamanho;
+    agendar_trecho(b, TRECHO_PARA_BROKER, b->latencia_us, dados, tamanho);
+}
+
+static void transporte_fechar(void *ctx) {
+    broker_t *b = ctx;
+    b->sessao++;
+    b->aberta = false;
+    b->aceita = false;
+    b->pendentes = 0;
+}
+
+static size_t transporte_pendentes(void *ctx) {
+    return ((broker_t *)ctx)->pendentes;
+}
+
+// --- Implementação das Funções Públicas ---
+
+broker_t *broker_criar(uint32_t latencia_us, broker_recebido_t recebido, void *ctx) {
+    broker_t *b = calloc(1, sizeof(broker_t));
+    if (!b) abort();
+    b->latencia_us = latencia_us;
+    b->recebido = recebido;
+    b->ctx = ctx;
+    return b;
+}
+
+placa_transporte_t broker_transporte(broker_t *b) {
+    return (placa_transporte_t){
+        .ctx = b,
+        .abrir = transporte_abrir,
+        .enviar = transporte_enviar,
+        .fechar = transporte_fechar,
+        .pendentes = transporte_pendentes,
+    };
+}
+
+bool broker_publicar(broker_t *b, const char *topico, const char *payload) {
+    if (!b->aberta || !b->aceita) return false;
+    for (int i = 0; i < b->num_assinaturas; i++) {
+        if (!topico_casa(b->assinaturas[i], topico)) continue;
+        size_t tamanho = strlen(payload);
+        uint8_t *pacote = malloc(mqtt_pacote_tamanho_publish(strlen(topico), tamanho, 1));
+        if (!pacote) abort();
+        if (++b->proximo_id == 0) b->proximo_id = 1;
+        enviar_para_placa(b, pacote, mqtt_pacote_publish(pacote, topico, payload, tamanho, 1, false, b->proximo_id));
+        free(pacote);
+        return true;
+    }
+    return false;
+}
+
+bool broker_placa_pronta(const broker_t *b) {
+    return b->aberta && b->aceita && b->num_assinaturas > 0;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file broker.h
+ * @brief Broker MQTT em processo para o ensaio de latência: uma placa conectada por um
+ * enlace simulado com latência fixa em cada sentido, no relógio do escalonador.
+ *
+ * Responde CONNECT, SUBSCRIBE, PINGREQ e os PUBLISH QoS 1 da placa, repassa cada PUBLISH
+ * recebido ao ensaio e entrega à placa as publicações do ensaio nos tópicos que ela assinou.
+ */
+
+#ifndef BROKER_H
+#define BROKER_H
+
+#include "placa.h"
+
+typedef struct broker broker_t;
+
+/**
+ * @brief Chamado quando um PUBLISH da placa chega ao broker.
+ * @param topico e payload terminados em '\0'.
+ */
+typedef void (*broker_recebido_t)(void *ctx, const char *topico, const char *payload, size_t tamanho);
+
+/**
+ * @param latencia_us Atraso de cada sentido do enlace (o ACK de um envio leva o dobro).
+ */
+broker_t *broker_criar(uint32_t latencia_us, broker_recebido_t recebido, void *ctx);
+
+/**
+ * @brief Transporte para placa_config_t: o lado da placa do enlace.
+ */
+placa_transporte_t broker_transporte(broker_t *b);
+
+/**
+ * @brief Publica (QoS 1) para a placa, se ela assinou o tópico.
+ * @return false se a placa não está conectada ou não assinou o tópico.
+ */
+bool broker_publicar(broker_t *b, const char *topico, const char *payload);
+
+/**
+ * @brief Se a placa tem uma sessão MQTT aceita com ao menos uma assinatura.
+ */
+bool broker_placa_pronta(const broker_t *b);
+
+#endif // BROKER_H
@@ -0,0 +1,199 @@
+/**
+ * @file cyw43.c
+ * @brief Rádio da placa simulada: cyw43_arch (threadsafe_background), contexto assíncrono
+ * e o cliente SNTP do LWIP.
+ *
+ * Tudo o que no firmware real roda na interrupção do CYW43 (enlace, bytes recebidos,
+ * temporizadores do LWIP, trabalhadores do contexto assíncrono) é atendido aqui, no núcleo
+ * que chamou cyw43_arch_init(), sempre que ele espera com as interrupções ligadas e fora de
+ * cyw43_arch_lwip_begin()/end().
+ */
+
+#include "placa_interna.h"
+#include "pico/cyw43_arch.h"
+#include "lwip/apps/sntp.h"
+
+#define BEACON_INTERVALO_US 102400   // 100 TU: intervalo de beacon típico do AP
+#define SNTP_PRIMEIRA_RESPOSTA_US 30000
+#define HORA_UTC_PADRAO_US 1767225600000000ull // 2026-01-01 00:00:00 UTC
+
+struct async_context {
+    async_when_pending_worker_t *trabalhadores;
+};
+
+cyw43_t cyw43_state;
+
+static bool iniciado;
+static uint nucleo_rede = UINT32_MAX;
+static uint bloqueios;              // Profundidade de cyw43_arch_lwip_begin()
+static bool enlace_mudou;           // Evento do enlace ainda não atendido
+static bool sntp_ativo, sntp_pendente;
+static async_context_t contexto;
+
+// --- Funções Auxiliares ---
+
+static void enlace_de_pe(void *ctx) {
+    (void)ctx;
+    if (cyw43_state.enlace != CYW43_LINK_JOIN) return; // Desassociado no meio do caminho
+    cyw43_state.enlace = CYW43_LINK_UP;
+    enlace_mudou = true;
+    placa_acordar_nucleo(nucleo_rede);
+}
+
+static void sntp_resposta(void *ctx) {
+    (void)ctx;
+    if (!sntp_ativo) return;
+    sntp_pendente = true;
+    placa_acordar_nucleo(nucleo_rede);
+    escalonador_agendar(placa_para_escalonador(placa_agora_us() + (uint64_t)SNTP_UPDATE_DELAY * 1000),
+                        sntp_resposta, NULL);
+}
+
+static void sntp_entregar(void) {
+    uint64_t agora = placa_agora_us();
+    uint64_t utc = placa_cfg.hora_utc_us ? placa_cfg.hora_utc_us(placa_cfg.ctx, agora) : HORA_UTC_PADRAO_US + agora;
+    SNTP_SET_SYSTEM_TIME_US((uint32_t)(utc / 1000000), (uint32_t)(utc % 1000000));
+}
+
+// --- Interface com a Plataforma ---
+
+uint placa_nucleo_rede(void) {
+    return nucleo_rede;
+}
+
+uint placa_rede_bloqueios(void) {
+    return bloqueios;
+}
+
+uint64_t placa_rede_entrega(uint64_t chegada_us) {
+    if (cyw43_state.pm != CYW43_AGGRESSIVE_PM) return chegada_us;
+    return (chegada_us + BEACON_INTERVALO_US - 1) / BEACON_INTERVALO_US * BEACON_INTERVALO_US;
+}
+
+bool placa_rede_atender(void) {
+    bool atendeu = false;
+    if (enlace_mudou) {
+        enlace_mudou = false;
+        atendeu = true;
+    }
+    if (sntp_pendente && cyw43_state.enlace == CYW43_LINK_UP) {
+        sntp_pendente = false;
+        sntp_entregar();
+        atendeu = true;
+    }
+    atendeu |= placa_mqtt_atender();
+    for (async_when_pending_worker_t *t = contexto.trabalhadores; t; t = t->next) {
+        if (t->work_pending) {
+            t->work_pending = false;
+            t->do_work(&contexto, t);
+            atendeu = true;
+        }
+    }
+    return atendeu;
+}
+
+// --- cyw43_arch ---
+
+int cyw43_arch_init(void) {
+    iniciado = true;
+    nucleo_rede = get_core_num();
+    cyw43_state.enlace = CYW43_LINK_DOWN;
+    cyw43_state.pm = CYW43_DEFAULT_PM;
+    return 0;
+}
+
+void cyw43_arch_deinit(void) {
+    iniciado = false;
+    cyw43_state.enlace = CYW43_LINK_DOWN;
+}
+
+void cyw43_arch_enable_sta_mode(void) {
+}
+
+int cyw43_arch_wifi_connect_async(const char *ssid, const char *senha, uint32_t autenticacao) {
+    (void)ssid;
+    (void)senha;
+    (void)autenticacao;
+    if (!iniciado) return PICO_ERROR_GENERIC;
+    cyw43_state.enlace = CYW43_LINK_JOIN;
+    escalonador_agendar(placa_para_escalonador(placa_agora_us() + (uint64_t)placa_cfg.atraso_wifi_ms * 1000),
+                        enlace_de_pe, NULL);
+    return 0;
+}
+
+int cyw43_tcpip_link_status(cyw43_t *self, int itf) {
+    (void)itf;
+    return self->enlace;
+}
+
+int cyw43_wifi_pm(cyw43_t *self, uint32_t pm) {
+    self->pm = pm;
+    return 0;
+}
+
+void cyw43_arch_poll(void) {
+    placa_atender_interrupcoes();
+}
+
+void cyw43_arch_wait_for_work_until(absolute_time_t ate) {
+    // Como o semáforo do contexto: só trabalho do rádio encerra a espera antes do prazo.
+    while (!placa_atender_interrupcoes()) {
+        if (time_reached(ate)) return;
+        placa_bloquear_ate(ate);
+    }
+}
+
+void cyw43_arch_lwip_begin(void) {
+    bloqueios++;
+}
+
+void cyw43_arch_lwip_end(void) {
+    bloqueios--;
+}
+
+async_context_t *cyw43_arch_async_context(void) {
+    return iniciado ? &contexto : NULL;
+}
+
+bool async_context_add_when_pending_worker(async_context_t *context, async_when_pending_worker_t *worker) {
+    worker->next = context->trabalhadores;
+    context->trabalhadores = worker;
+    return true;
+}
+
+bool async_context_remove_when_pending_worker(async_context_t *context, async_when_pending_worker_t *worker) {
+    for (async_when_pending_worker_t **t = &context->trabalhadores; *t; t = &(*t)->next) {
+        if (*t == worker) {
+            *t = worker->next;
+            return true;
+        }
+    }
+    return false;
+}
+
+void async_context_set_work_pending(async_context_t *context, async_when_pending_worker_t *worker) {
+    (void)context;
+    worker->work_pending = true;
+    placa_acordar_nucleo(nucleo_rede);
+}
+
+// --- SNTP ---
+
+void sntp_setoperatingmode(uint8_t modo) {
+    (void)modo;
+}
+
+void sntp_setservername(uint8_t indice, const char *servidor) {
+    (void)indice;
+    (void)servidor;
+}
+
+void sntp_init(void) {
+    if (sntp_ativo) return;
+    sntp_ativo = true;
+    escalonador_agendar(placa_para_escalonador(placa_agora_us() + SNTP_PRIMEIRA_RESPOSTA_US), sntp_resposta, NULL);
+}
+
+void sntp_stop(void) {
+    sntp_ativo = false;
+}
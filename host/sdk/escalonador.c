@@ -0,0 +1,269 @@
+/**
+ * @file escalonador.c
+ * @brief Implementação do escalonador cooperativo (ucontext) com relógio virtual ou real.
+ */
+
+#define _GNU_SOURCE
+#include "escalonador.h"
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <ucontext.h>
+
+typedef enum { CORROTINA_PRONTA, CORROTINA_RODANDO, CORROTINA_BLOQUEADA, CORROTINA_TERMINADA } estado_corrotina_t;
+
+struct corrotina {
+    ucontext_t contexto;
+    void (*entrada)(void *);
+    void *arg;
+    estado_corrotina_t estado;
+    uint64_t geracao;          // Muda a cada bloqueio: prazos de bloqueios anteriores perdem a validade
+    corrotina_t *proxima;      // Fila de prontas
+};
+
+/**
+ * @brief Entrada do heap de prazos: acorda uma corrotina ou chama uma função.
+ */
+typedef struct {
+    uint64_t quando;
+    uint64_t sequencia;        // Desempate: ordem de agendamento
+    corrotina_t *corrotina;
+    uint64_t geracao;
+    void (*funcao)(void *);
+    void *ctx;
+} prazo_t;
+
+typedef struct {
+    int fd;
+    short eventos;
+    void (*pronto)(void *ctx, short revents);
+    void *ctx;
+} observado_t;
+
+static bool tempo_real;
+static uint64_t agora_virtual;
+static struct timespec origem;
+static ucontext_t contexto_escalonador;
+static corrotina_t *atual;
+static corrotina_t *primeira_pronta, *ultima_pronta;
+static prazo_t *heap;
+static size_t heap_tam, heap_cap;
+static uint64_t proxima_sequencia;
+static observado_t *observados;
+static size_t num_observados, cap_observados;
+
+// --- Funções Auxiliares ---
+
+static bool antes(const prazo_t *a, const prazo_t *b) {
+    return a->quando != b->quando ? a->quando < b->quando : a->sequencia < b->sequencia;
+}
+
+static void heap_inserir(prazo_t p) {
+    if (heap_tam == heap_cap) {
+        heap_cap = heap_cap ? heap_cap * 2 : 256;
+        heap = realloc(heap, heap_cap * sizeof(prazo_t));
+        if (!heap) abort();
+    }
+    p.sequencia = proxima_sequencia++;
+    size_t i = heap_tam++;
+    while (i > 0 && antes(&p, &heap[(i - 1) / 2])) {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap[i] = p;
+}
+
+static prazo_t heap_remover(void) {
+    prazo_t topo = heap[0];
+    prazo_t ultimo = heap[--heap_tam];
+    size_t i = 0;
+    while (true) {
+        size_t f = 2 * i + 1;
+        if (f >= heap_tam) break;
+        if (f + 1 < heap_tam && antes(&heap[f + 1], &heap[f])) f++;
+        if (!antes(&heap[f], &ultimo)) break;
+        heap[i] = heap[f];
+        i = f;
+    }
+    if (heap_tam > 0) heap[i] = ultimo;
+    return topo;
+}
+
+/**
+ * @brief Descarta do topo os prazos de corrotinas que já acordaram por outro motivo.
+ */
+static const prazo_t *heap_topo_valido(void) {
+    while (heap_tam > 0 && heap[0].corrotina &&
+           (heap[0].corrotina->estado != CORROTINA_BLOQUEADA || heap[0].corrotina->geracao != heap[0].geracao)) {
+        heap_remover();
+    }
+    return heap_tam > 0 ? &heap[0] : NULL;
+}
+
+static void tornar_pronta(corrotina_t *c) {
+    c->estado = CORROTINA_PRONTA;
+    c->proxima = NULL;
+    if (ultima_pronta) {
+        ultima_pronta->proxima = c;
+    } else {
+        primeira_pronta = c;
+    }
+    ultima_pronta = c;
+}
+
+static uint64_t relogio_real_us(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)(t.tv_sec - origem.tv_sec) * 1000000ull + (uint64_t)(t.tv_nsec / 1000) -
+           (uint64_t)(origem.tv_nsec / 1000);
+}
+
+static void trampolim(void) {
+    corrotina_t *c = atual;
+    c->entrada(c->arg);
+    c->estado = CORROTINA_TERMINADA; // O firmware não retorna de main(); aqui só por robustez
+}
+
+/**
+ * @brief Executa os prazos vencidos (chamadas e despertares).
+ */
+static void disparar_vencidos(void) {
+    const prazo_t *p;
+    uint64_t agora = escalonador_agora_us();
+    while ((p = heap_topo_valido()) && p->quando <= agora) {
+        prazo_t vencido = heap_remover();
+        if (vencido.corrotina) {
+            tornar_pronta(vencido.corrotina);
+        } else {
+            vencido.funcao(vencido.ctx);
+        }
+    }
+}
+
+/**
+ * @brief Espera (relógio real) até o instante ou até algum descritor ficar pronto.
+ */
+static void aguardar_real(uint64_t ate_us) {
+    uint64_t agora = relogio_real_us();
+    uint64_t espera = ate_us > agora ? ate_us - agora : 0;
+    struct pollfd *fds = num_observados ? calloc(num_observados, sizeof(struct pollfd)) : NULL;
+    for (size_t i = 0; i < num_observados; i++) {
+        fds[i].fd = observados[i].fd;
+        fds[i].events = observados[i].eventos;
+    }
+    struct timespec limite = { .tv_sec = (time_t)(espera / 1000000), .tv_nsec = (long)(espera % 1000000) * 1000 };
+    int n = ppoll(fds, num_observados, &limite, NULL);
+    for (size_t i = 0; n > 0 && i < num_observados; i++) {
+        if (!fds[i].revents) continue;
+        // O tratador pode esquecer descritores: localiza de novo pelo número.
+        for (size_t j = 0; j < num_observados; j++) {
+            if (observados[j].fd == fds[i].fd) {
+                observados[j].pronto(observados[j].ctx, fds[i].revents);
+                break;
+            }
+        }
+    }
+    free(fds);
+}
+
+// --- Implementação das Funções Públicas ---
+
+void escalonador_iniciar(bool real) {
+    tempo_real = real;
+    agora_virtual = 0;
+    clock_gettime(CLOCK_MONOTONIC, &origem);
+}
+
+uint64_t escalonador_agora_us(void) {
+    return tempo_real ? relogio_real_us() : agora_virtual;
+}
+
+corrotina_t *escalonador_criar(void (*entrada)(void *), void *arg, void *pilha, size_t tamanho) {
+    corrotina_t *c = calloc(1, sizeof(corrotina_t));
+    if (!c || getcontext(&c->contexto) != 0) abort();
+    c->contexto.uc_stack.ss_sp = pilha;
+    c->contexto.uc_stack.ss_size = tamanho;
+    c->contexto.uc_link = &contexto_escalonador;
+    makecontext(&c->contexto, trampolim, 0);
+    c->entrada = entrada;
+    c->arg = arg;
+    tornar_pronta(c);
+    return c;
+}
+
+corrotina_t *escalonador_atual(void) {
+    return atual;
+}
+
+void escalonador_esperar(uint64_t prazo_us) {
+    corrotina_t *c = atual;
+    if (!c) {
+        fprintf(stderr, "[escalonador] espera fora de uma corrotina\n");
+        abort();
+    }
+    c->estado = CORROTINA_BLOQUEADA;
+    c->geracao++;
+    if (prazo_us != ESCALONADOR_NUNCA) {
+        heap_inserir((prazo_t){ .quando = prazo_us, .corrotina = c, .geracao = c->geracao });
+    }
+    swapcontext(&c->contexto, &contexto_escalonador);
+}
+
+void escalonador_acordar(corrotina_t *c) {
+    if (c && c->estado == CORROTINA_BLOQUEADA) tornar_pronta(c);
+}
+
+void escalonador_agendar(uint64_t quando_us, void (*funcao)(void *), void *ctx) {
+    heap_inserir((prazo_t){ .quando = quando_us, .funcao = funcao, .ctx = ctx });
+}
+
+void escalonador_observar_fd(int fd, short eventos, void (*pronto)(void *ctx, short revents), void *ctx) {
+    for (size_t i = 0; i < num_observados; i++) {
+        if (observados[i].fd == fd) {
+            observados[i] = (observado_t){ fd, eventos, pronto, ctx };
+            return;
+        }
+    }
+    if (num_observados == cap_observados) {
+        cap_observados = cap_observados ? cap_observados * 2 : 64;
+        observados = realloc(observados, cap_observados * sizeof(observado_t));
+        if (!observados) abort();
+    }
+    observados[num_observados++] = (observado_t){ fd, eventos, pronto, ctx };
+}
+
+void escalonador_esquecer_fd(int fd) {
+    for (size_t i = 0; i < num_observados; i++) {
+        if (observados[i].fd == fd) {
+            observados[i] = observados[--num_observados];
+            return;
+        }
+    }
+}
+
+void escalonador_executar_ate(uint64_t instante_us) {
+    while (true) {
+        disparar_vencidos();
+        if (primeira_pronta) {
+            corrotina_t *c = primeira_pronta;
+            primeira_pronta = c->proxima;
+            if (!primeira_pronta) ultima_pronta = NULL;
+            c->estado = CORROTINA_RODANDO;
+            atual = c;
+            swapcontext(&contexto_escalonador, &c->contexto);
+            atual = NULL;
+            continue;
+        }
+        // Ninguém pronto: avança até o próximo prazo ou até o fim da rodada.
+        const prazo_t *p = heap_topo_valido();
+        uint64_t proximo = p && p->quando < instante_us ? p->quando : instante_us;
+        if (tempo_real) {
+            if (relogio_real_us() >= instante_us) return;
+            aguardar_real(proximo);
+        } else {
+            if (proximo > agora_virtual) agora_virtual = proximo;
+            if (!p || p->quando > instante_us) return;
+        }
+    }
+}
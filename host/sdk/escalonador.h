@@ -0,0 +1,82 @@
+/**
+ * @file escalonador.h
+ * @brief Escalonador cooperativo dos núcleos simulados no host.
+ *
+ * Cada núcleo de cada placa simulada é uma corrotina, e só uma roda por vez: a troca
+ * acontece nos pontos em que o firmware esperaria no hardware (WFE, sono, FIFO, I2C).
+ * No relógio virtual o tempo só anda quando nenhuma corrotina está pronta, saltando
+ * direto ao próximo prazo, e o resultado independe da carga da máquina. No relógio real
+ * (simulador de frota) o escalonador dorme em poll() até o próximo prazo ou descritor.
+ *
+ * Este módulo é o único estado global do processo: todo o resto do host/sdk existe uma
+ * vez por placa (ver placa.h).
+ */
+
+#ifndef ESCALONADOR_H
+#define ESCALONADOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define ESCALONADOR_NUNCA UINT64_MAX
+
+typedef struct corrotina corrotina_t;
+
+/**
+ * @brief Inicia o escalonador.
+ * @param tempo_real false: relógio virtual a partir de 0; true: CLOCK_MONOTONIC.
+ */
+void escalonador_iniciar(bool tempo_real);
+
+/**
+ * @brief Instante atual em µs (desde escalonador_iniciar).
+ */
+uint64_t escalonador_agora_us(void);
+
+/**
+ * @brief Cria uma corrotina, pronta para rodar na próxima volta do escalonador.
+ * @param pilha Memória da pilha, fornecida por quem cria (e que continua dona dela).
+ */
+corrotina_t *escalonador_criar(void (*entrada)(void *), void *arg, void *pilha, size_t tamanho);
+
+/**
+ * @brief Corrotina em execução, ou NULL fora delas.
+ */
+corrotina_t *escalonador_atual(void);
+
+/**
+ * @brief Bloqueia a corrotina atual até o prazo (absoluto) ou até escalonador_acordar().
+ * Quem chama reavalia a própria condição na volta.
+ */
+void escalonador_esperar(uint64_t prazo_us);
+
+/**
+ * @brief Torna uma corrotina bloqueada pronta (sem efeito se já estiver pronta ou rodando).
+ */
+void escalonador_acordar(corrotina_t *c);
+
+/**
+ * @brief Agenda uma chamada fora das corrotinas (entrega de rede, eventos do ensaio).
+ * Chamadas no mesmo instante rodam na ordem em que foram agendadas.
+ */
+void escalonador_agendar(uint64_t quando_us, void (*funcao)(void *), void *ctx);
+
+/**
+ * @brief Observa um descritor (só no relógio real).
+ * @param eventos Máscara de poll() (POLLIN, POLLOUT).
+ */
+void escalonador_observar_fd(int fd, short eventos, void (*pronto)(void *ctx, short revents), void *ctx);
+
+/**
+ * @brief Deixa de observar um descritor.
+ */
+void escalonador_esquecer_fd(int fd);
+
+/**
+ * @brief Roda as corrotinas e eventos até o instante indicado.
+ * Só pode ser chamada fora das corrotinas.
+ */
+void escalonador_executar_ate(uint64_t instante_us);
+
+#endif // ESCALONADOR_H
@@ -0,0 +1,27 @@
+/**
+ * @file hardware/adc.h
+ * @brief ADC no host: as conversões devolvem a leitura bruta da sonda de solo simulada.
+ */
+
+#ifndef HOST_HARDWARE_ADC_H
+#define HOST_HARDWARE_ADC_H
+
+#include "pico.h"
+
+typedef struct {
+    volatile uint32_t cs, result, fcs, fifo, div, intr, inte, intf, ints;
+} adc_hw_t;
+
+extern adc_hw_t placa_adc_hw;
+#define adc_hw (&placa_adc_hw)
+
+void adc_init(void);
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint entrada);
+void adc_fifo_setup(bool ligado, bool dreq, uint16_t limiar, bool erro, bool byte);
+void adc_set_clkdiv(float divisor);
+void adc_run(bool ligado);
+void adc_fifo_drain(void);
+uint16_t adc_read(void);
+
+#endif // HOST_HARDWARE_ADC_H
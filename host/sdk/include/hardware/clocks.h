@@ -0,0 +1,16 @@
+/**
+ * @file hardware/clocks.h
+ * @brief Clocks no host: clk_sys é o valor pedido por set_sys_clock_khz (125 MHz no boot).
+ */
+
+#ifndef HOST_HARDWARE_CLOCKS_H
+#define HOST_HARDWARE_CLOCKS_H
+
+#include "pico.h"
+
+enum clock_index { clk_gpout0 = 0, clk_gpout1, clk_gpout2, clk_gpout3, clk_ref, clk_sys, clk_peri, clk_usb, clk_adc, clk_rtc };
+
+uint32_t clock_get_hz(enum clock_index clock);
+bool set_sys_clock_khz(uint32_t khz, bool obrigatorio);
+
+#endif // HOST_HARDWARE_CLOCKS_H
@@ -0,0 +1,34 @@
+/**
+ * @file hardware/dma.h
+ * @brief DMA no host: só o caso ADC -> memória, concluído no disparo.
+ */
+
+#ifndef HOST_HARDWARE_DMA_H
+#define HOST_HARDWARE_DMA_H
+
+#include "pico.h"
+
+#define NUM_DMA_CHANNELS 12
+#define DREQ_ADC 36
+
+enum dma_channel_transfer_size { DMA_SIZE_8 = 0, DMA_SIZE_16 = 1, DMA_SIZE_32 = 2 };
+
+typedef struct {
+    uint8_t tamanho;
+    bool incrementa_leitura;
+    bool incrementa_escrita;
+    uint dreq;
+} dma_channel_config;
+
+int dma_claim_unused_channel(bool obrigatorio);
+dma_channel_config dma_channel_get_default_config(uint canal);
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size tamanho);
+void channel_config_set_read_increment(dma_channel_config *c, bool incrementa);
+void channel_config_set_write_increment(dma_channel_config *c, bool incrementa);
+void channel_config_set_dreq(dma_channel_config *c, uint dreq);
+void dma_channel_configure(uint canal, const dma_channel_config *c, volatile void *destino,
+                           const volatile void *origem, uint transferencias, bool disparar);
+bool dma_channel_is_busy(uint canal);
+void dma_channel_abort(uint canal);
+
+#endif // HOST_HARDWARE_DMA_H
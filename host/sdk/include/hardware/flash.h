@@ -0,0 +1,17 @@
+/**
+ * @file hardware/flash.h
+ * @brief Flash no host: o vetor placa_flash, com os tempos típicos de apagar e gravar.
+ */
+
+#ifndef HOST_HARDWARE_FLASH_H
+#define HOST_HARDWARE_FLASH_H
+
+#include "pico.h"
+
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+
+void flash_range_erase(uint32_t offset, size_t tamanho);
+void flash_range_program(uint32_t offset, const uint8_t *dados, size_t tamanho);
+
+#endif // HOST_HARDWARE_FLASH_H
@@ -0,0 +1,26 @@
+/**
+ * @file hardware/i2c.h
+ * @brief I2C no host: cada transferência ocupa o núcleo pelo tempo que levaria no
+ * barramento (9 bits por byte, mais o endereço) e é entregue aos dispositivos simulados
+ * da placa (AHT10, BH1750, TCA9548A e SSD1306).
+ */
+
+#ifndef HOST_HARDWARE_I2C_H
+#define HOST_HARDWARE_I2C_H
+
+#include "pico.h"
+
+typedef struct i2c_inst {
+    uint8_t indice;
+    uint32_t baudrate;
+} i2c_inst_t;
+
+extern i2c_inst_t placa_i2c[2];
+#define i2c0 (&placa_i2c[0])
+#define i2c1 (&placa_i2c[1])
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t endereco, const uint8_t *dados, size_t tamanho, bool sem_stop);
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t endereco, uint8_t *dados, size_t tamanho, bool sem_stop);
+
+#endif // HOST_HARDWARE_I2C_H
@@ -0,0 +1,22 @@
+/**
+ * @file hardware/irq.h
+ * @brief Registro de tratadores no host (guardados, não disparados: ver hardware/pwm.h).
+ */
+
+#ifndef HOST_HARDWARE_IRQ_H
+#define HOST_HARDWARE_IRQ_H
+
+#include "pico.h"
+
+#define PWM_IRQ_WRAP 4
+#define DMA_IRQ_0 11
+#define DMA_IRQ_1 12
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
+
+typedef void (*irq_handler_t)(void);
+
+void irq_add_shared_handler(uint num, irq_handler_t tratador, uint8_t prioridade);
+void irq_set_exclusive_handler(uint num, irq_handler_t tratador);
+void irq_set_enabled(uint num, bool ligado);
+
+#endif // HOST_HARDWARE_IRQ_H
@@ -0,0 +1,31 @@
+/**
+ * @file hardware/pio.h
+ * @brief PIO no host: só a escrita no FIFO da máquina de estados, com o tempo de
+ * transmissão de um pixel WS2812 (24 bits a 800 kHz).
+ */
+
+#ifndef HOST_HARDWARE_PIO_H
+#define HOST_HARDWARE_PIO_H
+
+#include "pico.h"
+
+typedef struct pio_hw {
+    uint32_t ultimo_dado[4];
+} pio_hw_t;
+
+typedef pio_hw_t *PIO;
+
+typedef struct {
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin;
+} pio_program_t;
+
+extern pio_hw_t placa_pio[2];
+#define pio0 (&placa_pio[0])
+#define pio1 (&placa_pio[1])
+
+uint pio_add_program(PIO pio, const pio_program_t *programa);
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t dado);
+
+#endif // HOST_HARDWARE_PIO_H
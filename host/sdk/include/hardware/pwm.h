@@ -0,0 +1,45 @@
+/**
+ * @file hardware/pwm.h
+ * @brief PWM no host: os registradores são guardados, mas a interrupção de fim de período
+ * não é gerada (as trajetórias do servo e os efeitos do LED não avançam no host).
+ */
+
+#ifndef HOST_HARDWARE_PWM_H
+#define HOST_HARDWARE_PWM_H
+
+#include "pico.h"
+
+#define NUM_PWM_SLICES 8
+#define PWM_CHAN_A 0
+#define PWM_CHAN_B 1
+
+typedef struct {
+    volatile uint32_t csr, div, ctr, cc, top;
+} pwm_slice_hw_t;
+
+typedef struct {
+    pwm_slice_hw_t slice[NUM_PWM_SLICES];
+    volatile uint32_t en, intr, inte, intf, ints;
+} pwm_hw_t;
+
+extern pwm_hw_t placa_pwm_hw;
+#define pwm_hw (&placa_pwm_hw)
+
+static inline uint pwm_gpio_to_slice_num(uint gpio) {
+    return (gpio >> 1u) & 7u;
+}
+
+static inline uint pwm_gpio_to_channel(uint gpio) {
+    return gpio & 1u;
+}
+
+void pwm_set_clkdiv(uint slice, float divisor);
+void pwm_set_wrap(uint slice, uint16_t wrap);
+void pwm_set_chan_level(uint slice, uint canal, uint16_t nivel);
+void pwm_set_gpio_level(uint gpio, uint16_t nivel);
+void pwm_set_enabled(uint slice, bool ligado);
+void pwm_set_irq_enabled(uint slice, bool ligado);
+void pwm_clear_irq(uint slice);
+uint32_t pwm_get_irq_status_mask(void);
+
+#endif // HOST_HARDWARE_PWM_H
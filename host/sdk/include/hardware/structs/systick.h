@@ -0,0 +1,24 @@
+/**
+ * @file hardware/structs/systick.h
+ * @brief SysTick no host: cada acesso a systick_hw recarrega cvr com o contador de ciclos do
+ * host (TSC no x86, CLOCK_MONOTONIC em ns nos demais), decrescente e em 24 bits como no M0+.
+ */
+
+#ifndef HOST_HARDWARE_STRUCTS_SYSTICK_H
+#define HOST_HARDWARE_STRUCTS_SYSTICK_H
+
+#include "pico.h"
+
+typedef struct {
+    volatile uint32_t csr, rvr, cvr, calib;
+} systick_hw_t;
+
+systick_hw_t *placa_systick(void);
+#define systick_hw (placa_systick())
+
+/**
+ * @brief Frequência do contador por trás do SysTick do host, em Hz.
+ */
+uint64_t placa_systick_hz(void);
+
+#endif // HOST_HARDWARE_STRUCTS_SYSTICK_H
@@ -0,0 +1,18 @@
+/**
+ * @file hardware/structs/xip_ctrl.h
+ * @brief Controle do XIP no host: não há cache, os contadores ficam em zero.
+ */
+
+#ifndef HOST_HARDWARE_STRUCTS_XIP_CTRL_H
+#define HOST_HARDWARE_STRUCTS_XIP_CTRL_H
+
+#include "pico.h"
+
+typedef struct {
+    volatile uint32_t ctrl, flush, stat, ctr_hit, ctr_acc, stream_addr, stream_ctr, stream_fifo;
+} xip_ctrl_hw_t;
+
+extern xip_ctrl_hw_t placa_xip_ctrl_hw;
+#define xip_ctrl_hw (&placa_xip_ctrl_hw)
+
+#endif // HOST_HARDWARE_STRUCTS_XIP_CTRL_H
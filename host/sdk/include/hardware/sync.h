@@ -0,0 +1,26 @@
+/**
+ * @file hardware/sync.h
+ * @brief Interrupções e eventos do núcleo no host.
+ * "Desligar interrupções" impede que o núcleo atenda as interrupções simuladas (GPIO no
+ * Core 0, rede no Core 1) nas suas esperas até restore_interrupts().
+ */
+
+#ifndef HOST_HARDWARE_SYNC_H
+#define HOST_HARDWARE_SYNC_H
+
+#include "pico.h"
+
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t estado);
+
+/**
+ * @brief Sinaliza um evento aos dois núcleos (termina o WFE do outro).
+ */
+void __sev(void);
+void __wfe(void);
+void __wfi(void);
+
+#define __mem_fence_acquire() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define __mem_fence_release() __atomic_thread_fence(__ATOMIC_RELEASE)
+
+#endif // HOST_HARDWARE_SYNC_H
@@ -0,0 +1,25 @@
+/**
+ * @file hardware/watchdog.h
+ * @brief Watchdog no host: um estouro não reinicia a placa, só é contado (placa.h) para o
+ * ensaio falhar.
+ */
+
+#ifndef HOST_HARDWARE_WATCHDOG_H
+#define HOST_HARDWARE_WATCHDOG_H
+
+#include "pico.h"
+
+typedef struct {
+    volatile uint32_t ctrl, load, reason, scratch[8], tick;
+} watchdog_hw_t;
+
+extern watchdog_hw_t placa_watchdog_hw;
+#define watchdog_hw (&placa_watchdog_hw)
+
+void watchdog_enable(uint32_t atraso_ms, bool pausa_depuracao);
+void watchdog_update(void);
+bool watchdog_caused_reboot(void);
+bool watchdog_enable_caused_reboot(void);
+void watchdog_reboot(uint32_t pc, uint32_t sp, uint32_t atraso_ms);
+
+#endif // HOST_HARDWARE_WATCHDOG_H
@@ -0,0 +1,27 @@
+/**
+ * @file lwip/apps/mqtt_opts.h
+ * @brief Padrões das opções do cliente MQTT do LWIP (sobrescritos pelo lwipopts.h).
+ */
+
+#ifndef HOST_LWIP_APPS_MQTT_OPTS_H
+#define HOST_LWIP_APPS_MQTT_OPTS_H
+
+#include "lwip/opt.h"
+
+#ifndef MQTT_OUTPUT_RINGBUF_SIZE
+#define MQTT_OUTPUT_RINGBUF_SIZE 256
+#endif
+#ifndef MQTT_VAR_HEADER_BUFFER_LEN
+#define MQTT_VAR_HEADER_BUFFER_LEN 128
+#endif
+#ifndef MQTT_REQ_MAX_IN_FLIGHT
+#define MQTT_REQ_MAX_IN_FLIGHT 4
+#endif
+#ifndef MQTT_REQ_TIMEOUT
+#define MQTT_REQ_TIMEOUT 30
+#endif
+#ifndef MQTT_CONNECT_TIMOUT
+#define MQTT_CONNECT_TIMOUT 100
+#endif
+
+#endif // HOST_LWIP_APPS_MQTT_OPTS_H
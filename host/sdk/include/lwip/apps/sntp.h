@@ -0,0 +1,25 @@
+/**
+ * @file lwip/apps/sntp.h
+ * @brief Cliente SNTP no host: as respostas chegam com o horário de parede da placa
+ * simulada (placa.h) pelo SNTP_SET_SYSTEM_TIME_US do lwipopts.h, como na pilha real.
+ */
+
+#ifndef HOST_LWIP_APPS_SNTP_H
+#define HOST_LWIP_APPS_SNTP_H
+
+#include "lwip/opt.h"
+#include <stdint.h>
+
+#define SNTP_OPMODE_POLL 0
+#define SNTP_OPMODE_LISTENONLY 1
+
+#ifndef SNTP_UPDATE_DELAY
+#define SNTP_UPDATE_DELAY 3600000
+#endif
+
+void sntp_setoperatingmode(uint8_t modo);
+void sntp_setservername(uint8_t indice, const char *servidor);
+void sntp_init(void);
+void sntp_stop(void);
+
+#endif // HOST_LWIP_APPS_SNTP_H
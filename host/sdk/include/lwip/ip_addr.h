@@ -0,0 +1,22 @@
+/**
+ * @file lwip/ip_addr.h
+ * @brief Endereço IPv4 do LWIP (ordem de rede, como IP_ADDR4 monta).
+ */
+
+#ifndef HOST_LWIP_IP_ADDR_H
+#define HOST_LWIP_IP_ADDR_H
+
+#include <stdint.h>
+
+typedef uint8_t u8_t;
+typedef uint16_t u16_t;
+typedef uint32_t u32_t;
+
+typedef struct {
+    u32_t addr;
+} ip_addr_t;
+
+#define IP_ADDR4(ip, a, b, c, d) \
+    ((ip)->addr = (u32_t)(a) | ((u32_t)(b) << 8) | ((u32_t)(c) << 16) | ((u32_t)(d) << 24))
+
+#endif // HOST_LWIP_IP_ADDR_H
@@ -0,0 +1,19 @@
+/**
+ * @file lwip/opt.h
+ * @brief Opções do LWIP no host: as do lwipopts.h do projeto, sem as estatísticas de pools
+ * (não há pilha LWIP no host, só o cliente MQTT simulado).
+ */
+
+#ifndef HOST_LWIP_OPT_H
+#define HOST_LWIP_OPT_H
+
+#include "lwipopts.h"
+
+#undef LWIP_STATS
+#undef MEM_STATS
+#undef MEMP_STATS
+#define LWIP_STATS 0
+#define MEM_STATS 0
+#define MEMP_STATS 0
+
+#endif // HOST_LWIP_OPT_H
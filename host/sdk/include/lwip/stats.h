@@ -0,0 +1,11 @@
+/**
+ * @file lwip/stats.h
+ * @brief Estatísticas do LWIP: desligadas no host (lwip/opt.h).
+ */
+
+#ifndef HOST_LWIP_STATS_H
+#define HOST_LWIP_STATS_H
+
+#include "lwip/opt.h"
+
+#endif // HOST_LWIP_STATS_H
@@ -0,0 +1,44 @@
+/**
+ * @file pico.h
+ * @brief Tipos e macros básicos do SDK do Pico para a compilação do firmware no host.
+ *
+ * Só o que o firmware usa. Os atributos de seção (SRAM, scratch) não têm efeito no host,
+ * e os endereços fixos do RP2040 viram memória comum de cada placa simulada (placa.h).
+ */
+
+#ifndef HOST_PICO_H
+#define HOST_PICO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef unsigned int uint;
+
+#define _u(x) x##u
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+
+#define __not_in_flash(grupo)
+#define __not_in_flash_func(nome) nome
+#define __time_critical_func(nome) nome
+#define __scratch_x(grupo)
+#define __scratch_y(grupo)
+#define __uninitialized_ram(nome) nome
+#define __noinline __attribute__((noinline))
+#define __force_inline inline __attribute__((always_inline))
+#define __isr
+
+#define PICO_OK 0
+#define PICO_ERROR_GENERIC -1
+#define PICO_ERROR_TIMEOUT -1
+
+// A flash é um vetor da placa simulada; XIP_BASE aponta para ele.
+#define PICO_FLASH_SIZE_BYTES (2 * 1024 * 1024)
+extern uint8_t placa_flash[PICO_FLASH_SIZE_BYTES];
+#define XIP_BASE ((uintptr_t)placa_flash)
+
+void placa_panico(const char *motivo, const char *arquivo, int linha) __attribute__((noreturn));
+#define hard_assert(x) ((x) ? (void)0 : placa_panico("hard_assert(" #x ")", __FILE__, __LINE__))
+#define panic(...) placa_panico("panic", __FILE__, __LINE__)
+
+#endif // HOST_PICO_H
@@ -0,0 +1,25 @@
+/**
+ * @file pico/async_context.h
+ * @brief Contexto assíncrono do CYW43 no host: os trabalhadores rodam no Core 1, nas
+ * mesmas esperas em que a rede simulada é atendida.
+ */
+
+#ifndef HOST_PICO_ASYNC_CONTEXT_H
+#define HOST_PICO_ASYNC_CONTEXT_H
+
+#include "pico.h"
+
+typedef struct async_context async_context_t;
+
+typedef struct async_when_pending_worker {
+    struct async_when_pending_worker *next;
+    void (*do_work)(async_context_t *context, struct async_when_pending_worker *worker);
+    bool work_pending;
+    void *user_data;
+} async_when_pending_worker_t;
+
+bool async_context_add_when_pending_worker(async_context_t *context, async_when_pending_worker_t *worker);
+bool async_context_remove_when_pending_worker(async_context_t *context, async_when_pending_worker_t *worker);
+void async_context_set_work_pending(async_context_t *context, async_when_pending_worker_t *worker);
+
+#endif // HOST_PICO_ASYNC_CONTEXT_H
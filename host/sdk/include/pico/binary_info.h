@@ -0,0 +1,11 @@
+/**
+ * @file pico/binary_info.h
+ * @brief Sem metadados de binário no host.
+ */
+
+#ifndef HOST_PICO_BINARY_INFO_H
+#define HOST_PICO_BINARY_INFO_H
+
+#define bi_decl(...)
+
+#endif // HOST_PICO_BINARY_INFO_H
@@ -0,0 +1,57 @@
+/**
+ * @file pico/cyw43_arch.h
+ * @brief cyw43_arch (threadsafe_background) no host.
+ *
+ * O enlace sobe um tempo configurável após a associação (placa.h). As "interrupções" do
+ * CYW43 e do LWIP (bytes recebidos, temporizadores do MQTT e do SNTP, trabalhadores do
+ * contexto assíncrono) são atendidas no Core 1 sempre que ele espera fora de
+ * cyw43_arch_lwip_begin()/end() e com as interrupções ligadas.
+ */
+
+#ifndef HOST_PICO_CYW43_ARCH_H
+#define HOST_PICO_CYW43_ARCH_H
+
+#include "pico/stdlib.h"
+#include "pico/async_context.h"
+
+#define CYW43_ITF_STA 0
+#define CYW43_ITF_AP 1
+
+#define CYW43_LINK_DOWN 0
+#define CYW43_LINK_JOIN 1
+#define CYW43_LINK_NOIP 2
+#define CYW43_LINK_UP 3
+#define CYW43_LINK_FAIL -1
+#define CYW43_LINK_NONET -2
+#define CYW43_LINK_BADAUTH -3
+
+#define CYW43_AUTH_OPEN 0
+#define CYW43_AUTH_WPA_TKIP_PSK 0x00200002
+#define CYW43_AUTH_WPA2_AES_PSK 0x00400004
+#define CYW43_AUTH_WPA2_MIXED_PSK 0x00400006
+
+#define CYW43_NO_POWERSAVE_MODE 0xa11140
+#define CYW43_PERFORMANCE_PM 0x111022
+#define CYW43_AGGRESSIVE_PM 0xa11c82
+#define CYW43_DEFAULT_PM CYW43_PERFORMANCE_PM
+
+typedef struct {
+    int enlace;
+    uint32_t pm;
+} cyw43_t;
+
+extern cyw43_t cyw43_state;
+
+int cyw43_arch_init(void);
+void cyw43_arch_deinit(void);
+void cyw43_arch_enable_sta_mode(void);
+int cyw43_arch_wifi_connect_async(const char *ssid, const char *senha, uint32_t autenticacao);
+int cyw43_tcpip_link_status(cyw43_t *self, int itf);
+int cyw43_wifi_pm(cyw43_t *self, uint32_t pm);
+void cyw43_arch_poll(void);
+void cyw43_arch_wait_for_work_until(absolute_time_t ate);
+void cyw43_arch_lwip_begin(void);
+void cyw43_arch_lwip_end(void);
+async_context_t *cyw43_arch_async_context(void);
+
+#endif // HOST_PICO_CYW43_ARCH_H
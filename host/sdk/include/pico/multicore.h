@@ -0,0 +1,22 @@
+/**
+ * @file pico/multicore.h
+ * @brief Segundo núcleo e FIFOs do SIO no host (8 palavras em cada sentido, como no RP2040).
+ */
+
+#ifndef HOST_PICO_MULTICORE_H
+#define HOST_PICO_MULTICORE_H
+
+#include "pico/stdlib.h"
+
+#define SIO_FIFO_PROFUNDIDADE 8
+
+void multicore_launch_core1(void (*entrada)(void));
+bool multicore_fifo_rvalid(void);
+bool multicore_fifo_wready(void);
+void multicore_fifo_push_blocking(uint32_t dado);
+bool multicore_fifo_push_timeout_us(uint32_t dado, uint64_t timeout_us);
+uint32_t multicore_fifo_pop_blocking(void);
+bool multicore_fifo_pop_timeout_us(uint64_t timeout_us, uint32_t *dado);
+void multicore_fifo_drain(void);
+
+#endif // HOST_PICO_MULTICORE_H
@@ -0,0 +1,24 @@
+/**
+ * @file pico/platform.h
+ * @brief Núcleo atual e barreiras no host.
+ */
+
+#ifndef HOST_PICO_PLATFORM_H
+#define HOST_PICO_PLATFORM_H
+
+#include "pico.h"
+
+/**
+ * @brief Núcleo da corrotina em execução (0 fora das corrotinas).
+ */
+uint get_core_num(void);
+
+/**
+ * @brief Espera ativa: cede o núcleo por um instante para o outro andar.
+ */
+void tight_loop_contents(void);
+
+#define __compiler_memory_barrier() __asm__ volatile("" ::: "memory")
+#define __dmb() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+#endif // HOST_PICO_PLATFORM_H
@@ -0,0 +1,18 @@
+/**
+ * @file pico/stdlib.h
+ * @brief Subconjunto de pico/stdlib.h para o host.
+ */
+
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+#include "pico.h"
+#include "pico/platform.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+
+bool stdio_init_all(void);
+void stdio_flush(void);
+int getchar_timeout_us(uint32_t timeout_us);
+
+#endif // HOST_PICO_STDLIB_H
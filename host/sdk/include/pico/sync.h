@@ -0,0 +1,22 @@
+/**
+ * @file pico/sync.h
+ * @brief Seções críticas no host.
+ * Os núcleos só trocam nos pontos de espera, então a seção crítica só precisa bloquear
+ * as interrupções simuladas do núcleo que a ocupa.
+ */
+
+#ifndef HOST_PICO_SYNC_H
+#define HOST_PICO_SYNC_H
+
+#include "hardware/sync.h"
+
+typedef struct {
+    uint32_t estado_salvo;
+    bool iniciada;
+} critical_section_t;
+
+void critical_section_init(critical_section_t *secao);
+void critical_section_enter_blocking(critical_section_t *secao);
+void critical_section_exit(critical_section_t *secao);
+
+#endif // HOST_PICO_SYNC_H
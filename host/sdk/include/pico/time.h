@@ -0,0 +1,73 @@
+/**
+ * @file pico/time.h
+ * @brief Tempo do firmware no host: µs desde o boot da placa simulada, no relógio do escalonador.
+ * As esperas cedem o núcleo; o tempo só passa nelas (e nas transferências de I2C, PIO e flash).
+ */
+
+#ifndef HOST_PICO_TIME_H
+#define HOST_PICO_TIME_H
+
+#include "pico/types.h"
+
+uint64_t time_us_64(void);
+
+static inline uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+static inline absolute_time_t get_absolute_time(void) {
+    return time_us_64();
+}
+
+static inline uint64_t to_us_since_boot(absolute_time_t t) {
+    return t;
+}
+
+static inline uint32_t to_ms_since_boot(absolute_time_t t) {
+    return (uint32_t)(t / 1000);
+}
+
+static inline absolute_time_t from_us_since_boot(uint64_t us) {
+    return us;
+}
+
+static inline int64_t absolute_time_diff_us(absolute_time_t de, absolute_time_t ate) {
+    return (int64_t)(ate - de);
+}
+
+static inline absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us) {
+    return t + us;
+}
+
+static inline absolute_time_t delayed_by_ms(absolute_time_t t, uint32_t ms) {
+    return t + (uint64_t)ms * 1000;
+}
+
+static inline absolute_time_t make_timeout_time_us(uint64_t us) {
+    return time_us_64() + us;
+}
+
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) {
+    return time_us_64() + (uint64_t)ms * 1000;
+}
+
+static inline bool time_reached(absolute_time_t t) {
+    return time_us_64() >= t;
+}
+
+#define at_the_end_of_time ((absolute_time_t)INT64_MAX) // Como no SDK: comparável por absolute_time_diff_us()
+#define nil_time ((absolute_time_t)0)
+
+void sleep_until(absolute_time_t t);
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+void busy_wait_us(uint64_t us);
+void busy_wait_ms(uint32_t ms);
+
+/**
+ * @brief WFE com prazo: volta no prazo, em um evento (SEV, FIFO) ou após uma interrupção.
+ * @return true se o prazo foi atingido.
+ */
+bool best_effort_wfe_or_timeout(absolute_time_t t);
+
+#endif // HOST_PICO_TIME_H
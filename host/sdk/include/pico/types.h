@@ -0,0 +1,13 @@
+/**
+ * @file pico/types.h
+ * @brief absolute_time_t como no SDK sem PICO_OPAQUE_ABSOLUTE_TIME_T.
+ */
+
+#ifndef HOST_PICO_TYPES_H
+#define HOST_PICO_TYPES_H
+
+#include "pico.h"
+
+typedef uint64_t absolute_time_t;
+
+#endif // HOST_PICO_TYPES_H
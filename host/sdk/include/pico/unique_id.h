@@ -0,0 +1,20 @@
+/**
+ * @file pico/unique_id.h
+ * @brief Número de série da flash: vem da configuração da placa simulada.
+ */
+
+#ifndef HOST_PICO_UNIQUE_ID_H
+#define HOST_PICO_UNIQUE_ID_H
+
+#include "pico.h"
+
+#define PICO_UNIQUE_BOARD_ID_SIZE_BYTES 8
+
+typedef struct {
+    uint8_t id[PICO_UNIQUE_BOARD_ID_SIZE_BYTES];
+} pico_unique_board_id_t;
+
+void pico_get_unique_board_id(pico_unique_board_id_t *id);
+void pico_get_unique_board_id_string(char *destino, uint tamanho);
+
+#endif // HOST_PICO_UNIQUE_ID_H
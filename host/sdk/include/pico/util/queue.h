@@ -0,0 +1,30 @@
+/**
+ * @file pico/util/queue.h
+ * @brief Fila de elementos de tamanho fixo, com a mesma semântica da do SDK.
+ */
+
+#ifndef HOST_PICO_UTIL_QUEUE_H
+#define HOST_PICO_UTIL_QUEUE_H
+
+#include "pico.h"
+
+typedef struct {
+    uint8_t *dados;
+    uint tamanho_elemento;
+    uint capacidade;      // Elementos
+    uint inicio;
+    uint ocupados;
+} queue_t;
+
+void queue_init(queue_t *q, uint element_size, uint element_count);
+void queue_free(queue_t *q);
+uint queue_get_level(queue_t *q);
+bool queue_is_empty(queue_t *q);
+bool queue_is_full(queue_t *q);
+bool queue_try_add(queue_t *q, const void *data);
+bool queue_try_remove(queue_t *q, void *data);
+bool queue_try_peek(queue_t *q, void *data);
+void queue_add_blocking(queue_t *q, const void *data);
+void queue_remove_blocking(queue_t *q, void *data);
+
+#endif // HOST_PICO_UTIL_QUEUE_H
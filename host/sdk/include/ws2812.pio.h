@@ -0,0 +1,23 @@
+/**
+ * @file ws2812.pio.h
+ * @brief No lugar do cabeçalho gerado por pico_generate_pio_header: o programa não roda no
+ * host, só a escrita dos pixels (hardware/pio.h).
+ */
+
+#ifndef HOST_WS2812_PIO_H
+#define HOST_WS2812_PIO_H
+
+#include "hardware/pio.h"
+
+static const pio_program_t ws2812_program = { .instructions = NULL, .length = 4, .origin = -1 };
+
+static inline void ws2812_program_init(PIO pio, uint sm, uint offset, uint pino, float frequencia, bool rgbw) {
+    (void)pio;
+    (void)sm;
+    (void)offset;
+    (void)pino;
+    (void)frequencia;
+    (void)rgbw;
+}
+
+#endif // HOST_WS2812_PIO_H
@@ -0,0 +1,393 @@
+/**
+ * @file mqtt_cliente.c
+ * @brief Cliente MQTT do LWIP (lwip/apps/mqtt.h) sobre o transporte da placa simulada.
+ *
+ * Os eventos do transporte entram numa fila e são atendidos no núcleo da rede, no instante
+ * em que o rádio os entregaria (placa_rede_entrega()). Como no LWIP: até
+ * MQTT_REQ_MAX_IN_FLIGHT requisições (as QoS 0 até os bytes deixarem o buffer de saída,
+ * as demais até a confirmação ou MQTT_REQ_TIMEOUT s), ERR_MEM com o buffer de saída cheio
+ * e, na queda da sessão, requisições descartadas sem callback antes do aviso de
+ * MQTT_CONNECT_DISCONNECTED.
+ */
+
+#include "placa_interna.h"
+#include "mqtt_pacote.h"
+#include "lwip/apps/mqtt.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum { CLIENTE_DESCONECTADO, CLIENTE_CONECTANDO_TCP, CLIENTE_AGUARDANDO_CONNACK, CLIENTE_CONECTADO } estado_cliente_t;
+
+typedef enum { EVENTO_CONECTADA, EVENTO_RECUSADA, EVENTO_RECEBIDOS, EVENTO_ENVIADOS, EVENTO_CAIU } tipo_evento_t;
+
+typedef struct evento_rede {
+    struct evento_rede *proximo;
+    tipo_evento_t tipo;
+    uint32_t sessao;
+    uint64_t quando;
+    size_t tamanho;
+    uint8_t dados[];
+} evento_rede_t;
+
+typedef struct {
+    bool usada;
+    uint16_t id;            // 0: QoS 0, concluída quando os bytes saem do buffer
+    uint64_t fim_envio;     // Posição do fim do pacote no fluxo de saída (QoS 0)
+    uint64_t prazo;
+    mqtt_request_cb_t cb;
+    void *arg;
+} requisicao_t;
+
+struct mqtt_client_s {
+    estado_cliente_t estado;
+    mqtt_connection_cb_t cb_conexao;
+    void *arg_conexao;
+    mqtt_incoming_publish_cb_t cb_publish;
+    mqtt_incoming_data_cb_t cb_dados;
+    void *arg_entrada;
+    char client_id[64];
+    uint16_t keep_alive;
+    uint64_t prazo_conexao;
+    uint16_t proximo_id;
+    uint64_t enviados_total;    // Bytes entregues ao transporte desde a conexão
+    requisicao_t requisicoes[MQTT_REQ_MAX_IN_FLIGHT];
+    uint8_t *rx;
+    size_t rx_tamanho, rx_capacidade;
+};
+
+static mqtt_client_t *cliente;       // O firmware usa um só cliente
+static uint32_t sessao;              // Eventos de sessões anteriores são descartados
+static evento_rede_t *fila_inicio, *fila_fim;
+
+// --- Funções Auxiliares ---
+
+static void acordar_rede(void *ctx) {
+    (void)ctx;
+    placa_acordar_nucleo(placa_nucleo_rede());
+}
+
+static void agendar_despertar(uint64_t instante_us) {
+    escalonador_agendar(placa_para_escalonador(instante_us), acordar_rede, NULL);
+}
+
+/**
+ * @brief Enfileira um evento do transporte para entrega pelo rádio.
+ */
+static void enfileirar(tipo_evento_t tipo, const uint8_t *dados, size_t tamanho) {
+    evento_rede_t *e = malloc(sizeof(evento_rede_t) + tamanho);
+    if (!e) placa_panico("evento de rede sem memoria", __FILE__, __LINE__);
+    e->proximo = NULL;
+    e->tipo = tipo;
+    e->sessao = sessao;
+    e->tamanho = tamanho;
+    if (tamanho) memcpy(e->dados, dados, tamanho);
+    e->quando = placa_rede_entrega(placa_agora_us());
+    if (fila_fim && e->quando < fila_fim->quando) e->quando = fila_fim->quando; // Em ordem
+    if (fila_fim) {
+        fila_fim->proximo = e;
+    } else {
+        fila_inicio = e;
+    }
+    fila_fim = e;
+    agendar_despertar(e->quando);
+}
+
+static void evento_conectada(bool ok) {
+    enfileirar(ok ? EVENTO_CONECTADA : EVENTO_RECUSADA, NULL, 0);
+}
+
+static void evento_receber(const uint8_t *dados, size_t tamanho) {
+    enfileirar(EVENTO_RECEBIDOS, dados, tamanho);
+}
+
+static void evento_enviados(void) {
+    enfileirar(EVENTO_ENVIADOS, NULL, 0);
+}
+
+static void evento_caiu(void) {
+    enfileirar(EVENTO_CAIU, NULL, 0);
+}
+
+static const placa_rede_eventos_t eventos = {
+    .conectada = evento_conectada,
+    .receber = evento_receber,
+    .enviados = evento_enviados,
+    .caiu = evento_caiu,
+};
+
+static size_t pendentes_transporte(void) {
+    return placa_cfg.transporte.pendentes ? placa_cfg.transporte.pendentes(placa_cfg.transporte.ctx) : 0;
+}
+
+static void enviar(mqtt_client_t *c, const uint8_t *dados, size_t tamanho) {
+    c->enviados_total += tamanho;
+    placa_cfg.transporte.enviar(placa_cfg.transporte.ctx, dados, tamanho);
+}
+
+static requisicao_t *criar_requisicao(mqtt_client_t *c, uint16_t id, mqtt_request_cb_t cb, void *arg) {
+    for (int i = 0; i < MQTT_REQ_MAX_IN_FLIGHT; i++) {
+        requisicao_t *r = &c->requisicoes[i];
+        if (!r->usada) {
+            *r = (requisicao_t){ .usada = true, .id = id, .cb = cb, .arg = arg };
+            if (id) {
+                r->prazo = placa_agora_us() + (uint64_t)MQTT_REQ_TIMEOUT * 1000000;
+                agendar_despertar(r->prazo);
+            }
+            return r;
+        }
+    }
+    return NULL;
+}
+
+static void concluir_requisicao(mqtt_client_t *c, uint16_t id) {
+    for (int i = 0; i < MQTT_REQ_MAX_IN_FLIGHT; i++) {
+        requisicao_t *r = &c->requisicoes[i];
+        if (r->usada && r->id == id) {
+            r->usada = false;
+            if (r->cb) r->cb(r->arg, ERR_OK);
+            return;
+        }
+    }
+}
+
+static uint16_t gerar_id(mqtt_client_t *c) {
+    if (++c->proximo_id == 0) c->proximo_id = 1;
+    return c->proximo_id;
+}
+
+/**
+ * @brief Encerra a sessão: requisições descartadas sem callback, transporte fechado.
+ */
+static void encerrar(mqtt_client_t *c, mqtt_connection_status_t motivo, bool avisar) {
+    bool fechar = c->estado != CLIENTE_DESCONECTADO;
+    c->estado = CLIENTE_DESCONECTADO;
+    memset(c->requisicoes, 0, sizeof(c->requisicoes));
+    c->rx_tamanho = 0;
+    sessao++;
+    if (fechar && placa_cfg.transporte.fechar) placa_cfg.transporte.fechar(placa_cfg.transporte.ctx);
+    if (avisar && c->cb_conexao) c->cb_conexao(c, c->arg_conexao, motivo);
+}
+
+static void entregar_publish(mqtt_client_t *c, const mqtt_publish_t *p) {
+    char topico[MQTT_VAR_HEADER_BUFFER_LEN];
+    if (p->topico_tamanho + 1 > sizeof(topico)) {
+        // O LWIP recusa um tópico maior que o buffer de cabeçalho e encerra a sessão.
+        encerrar(c, MQTT_CONNECT_REFUSED_PROTOCOL_VERSION, true);
+        return;
+    }
+    memcpy(topico, p->topico, p->topico_tamanho);
+    topico[p->topico_tamanho] = '\0';
+    if (c->cb_publish) c->cb_publish(c->arg_entrada, topico, (u32_t)p->payload_tamanho);
+    size_t entregue = 0;
+    do {
+        size_t n = p->payload_tamanho - entregue;
+        if (n > MQTT_VAR_HEADER_BUFFER_LEN) n = MQTT_VAR_HEADER_BUFFER_LEN;
+        bool ultimo = entregue + n == p->payload_tamanho;
+        if (c->cb_dados) c->cb_dados(c->arg_entrada, p->payload + entregue, (u16_t)n, ultimo ? MQTT_DATA_FLAG_LAST : 0);
+        entregue += n;
+    } while (entregue < p->payload_tamanho);
+    if (p->qos > 0 && c->estado == CLIENTE_CONECTADO) {
+        uint8_t puback[4];
+        enviar(c, puback, mqtt_pacote_puback(puback, p->id));
+    }
+}
+
+static void tratar_pacote(mqtt_client_t *c, const mqtt_pacote_t *pacote) {
+    switch (pacote->tipo) {
+        case MQTT_PACOTE_CONNACK:
+            if (c->estado != CLIENTE_AGUARDANDO_CONNACK || pacote->tamanho < 2) break;
+            if (pacote->corpo[1] != 0) {
+                encerrar(c, (mqtt_connection_status_t)pacote->corpo[1], true);
+                break;
+            }
+            c->estado = CLIENTE_CONECTADO;
+            if (c->cb_conexao) c->cb_conexao(c, c->arg_conexao, MQTT_CONNECT_ACCEPTED);
+            break;
+        case MQTT_PACOTE_PUBACK:
+        case MQTT_PACOTE_SUBACK:
+            concluir_requisicao(c, mqtt_pacote_id(pacote));
+            break;
+        case MQTT_PACOTE_PUBLISH: {
+            mqtt_publish_t p;
+            if (mqtt_pacote_ler_publish(pacote, &p)) entregar_publish(c, &p);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static void receber(mqtt_client_t *c, const uint8_t *dados, size_t tamanho) {
+    if (c->rx_tamanho + tamanho > c->rx_capacidade) {
+        c->rx_capacidade = (c->rx_tamanho + tamanho) * 2;
+        c->rx = realloc(c->rx, c->rx_capacidade);
+        if (!c->rx) placa_panico("buffer de recepcao sem memoria", __FILE__, __LINE__);
+    }
+    memcpy(c->rx + c->rx_tamanho, dados, tamanho);
+    c->rx_tamanho += tamanho;
+    uint32_t sessao_atual = sessao;
+    size_t lidos = 0;
+    while (sessao == sessao_atual) {
+        mqtt_pacote_t pacote;
+        long n = mqtt_pacote_extrair(c->rx + lidos, c->rx_tamanho - lidos, &pacote);
+        if (n < 0) {
+            encerrar(c, MQTT_CONNECT_DISCONNECTED, true);
+            return;
+        }
+        if (n == 0) break;
+        lidos += (size_t)n;
+        tratar_pacote(c, &pacote);
+    }
+    if (sessao != sessao_atual) return; // Sessão encerrada por um dos pacotes
+    memmove(c->rx, c->rx + lidos, c->rx_tamanho - lidos);
+    c->rx_tamanho -= lidos;
+}
+
+static void concluir_enviados(mqtt_client_t *c) {
+    uint64_t entregues = c->enviados_total - pendentes_transporte();
+    for (int i = 0; i < MQTT_REQ_MAX_IN_FLIGHT; i++) {
+        requisicao_t *r = &c->requisicoes[i];
+        if (r->usada && r->id == 0 && r->fim_envio <= entregues) {
+            r->usada = false;
+            if (r->cb) r->cb(r->arg, ERR_OK);
+        }
+    }
+}
+
+static void tratar_evento(mqtt_client_t *c, const evento_rede_t *e) {
+    switch (e->tipo) {
+        case EVENTO_CONECTADA: {
+            if (c->estado != CLIENTE_CONECTANDO_TCP) break;
+            uint8_t connect[MQTT_PACOTE_CABECALHO_MAX + 12 + sizeof(c->client_id)];
+            enviar(c, connect, mqtt_pacote_connect(connect, c->client_id, c->keep_alive));
+            c->estado = CLIENTE_AGUARDANDO_CONNACK;
+            break;
+        }
+        case EVENTO_RECUSADA:
+        case EVENTO_CAIU:
+            encerrar(c, MQTT_CONNECT_DISCONNECTED, true);
+            break;
+        case EVENTO_RECEBIDOS:
+            receber(c, e->dados, e->tamanho);
+            break;
+        case EVENTO_ENVIADOS:
+            concluir_enviados(c);
+            break;
+    }
+}
+
+static bool verificar_prazos(mqtt_client_t *c) {
+    uint64_t agora = placa_agora_us();
+    bool atendeu = false;
+    if ((c->estado == CLIENTE_CONECTANDO_TCP || c->estado == CLIENTE_AGUARDANDO_CONNACK) && agora >= c->prazo_conexao) {
+        encerrar(c, MQTT_CONNECT_TIMEOUT, true);
+        return true;
+    }
+    for (int i = 0; i < MQTT_REQ_MAX_IN_FLIGHT; i++) {
+        requisicao_t *r = &c->requisicoes[i];
+        if (r->usada && r->id && agora >= r->prazo) {
+            r->usada = false;
+            if (r->cb) r->cb(r->arg, ERR_TIMEOUT);
+            atendeu = true;
+        }
+    }
+    return atendeu;
+}
+
+// --- Interface com a Plataforma ---
+
+bool placa_mqtt_atender(void) {
+    bool atendeu = false;
+    uint64_t agora = placa_agora_us();
+    while (fila_inicio && fila_inicio->quando <= agora) {
+        evento_rede_t *e = fila_inicio;
+        fila_inicio = e->proximo;
+        if (!fila_inicio) fila_fim = NULL;
+        if (cliente && e->sessao == sessao) tratar_evento(cliente, e);
+        free(e);
+        atendeu = true;
+    }
+    if (cliente) atendeu |= verificar_prazos(cliente);
+    return atendeu;
+}
+
+// --- API do LWIP ---
+
+mqtt_client_t *mqtt_client_new(void) {
+    mqtt_client_t *c = calloc(1, sizeof(mqtt_client_t));
+    if (c && !cliente) cliente = c;
+    return c;
+}
+
+void mqtt_client_free(mqtt_client_t *client) {
+    if (client == cliente) cliente = NULL;
+    free(client->rx);
+    free(client);
+}
+
+err_t mqtt_client_connect(mqtt_client_t *client, const ip_addr_t *ipaddr, u16_t port, mqtt_connection_cb_t cb,
+                          void *arg, const struct mqtt_connect_client_info_t *client_info) {
+    (void)ipaddr; // O destino é o do transporte configurado
+    (void)port;
+    if (client->estado != CLIENTE_DESCONECTADO) return ERR_ISCONN;
+    if (!placa_cfg.transporte.abrir) return ERR_RTE;
+    client->cb_conexao = cb;
+    client->arg_conexao = arg;
+    strncpy(client->client_id, client_info->client_id, sizeof(client->client_id) - 1);
+    client->keep_alive = client_info->keep_alive;
+    client->enviados_total = 0;
+    client->rx_tamanho = 0;
+    client->estado = CLIENTE_CONECTANDO_TCP;
+    client->prazo_conexao = placa_agora_us() + (uint64_t)MQTT_CONNECT_TIMOUT * 1000000;
+    agendar_despertar(client->prazo_conexao);
+    sessao++;
+    if (!placa_cfg.transporte.abrir(placa_cfg.transporte.ctx, &eventos)) {
+        client->estado = CLIENTE_DESCONECTADO;
+        return ERR_RTE;
+    }
+    return ERR_OK;
+}
+
+void mqtt_disconnect(mqtt_client_t *client) {
+    encerrar(client, MQTT_CONNECT_DISCONNECTED, false);
+}
+
+u8_t mqtt_client_is_connected(mqtt_client_t *client) {
+    return client->estado == CLIENTE_CONECTADO;
+}
+
+void mqtt_set_inpub_callback(mqtt_client_t *client, mqtt_incoming_publish_cb_t pub_cb,
+                             mqtt_incoming_data_cb_t data_cb, void *arg) {
+    client->cb_publish = pub_cb;
+    client->cb_dados = data_cb;
+    client->arg_entrada = arg;
+}
+
+err_t mqtt_sub_unsub(mqtt_client_t *client, const char *topic, u8_t qos, mqtt_request_cb_t cb, void *arg, u8_t sub) {
+    if (!sub) return ERR_VAL; // A estufa não cancela assinaturas
+    if (client->estado != CLIENTE_CONECTADO) return ERR_CONN;
+    size_t tamanho = MQTT_PACOTE_CABECALHO_MAX + 5 + strlen(topic);
+    if (pendentes_transporte() + tamanho > MQTT_OUTPUT_RINGBUF_SIZE) return ERR_MEM;
+    requisicao_t *r = criar_requisicao(client, gerar_id(client), cb, arg);
+    if (!r) return ERR_MEM;
+    uint8_t *pacote = malloc(tamanho);
+    if (!pacote) placa_panico("subscribe sem memoria", __FILE__, __LINE__);
+    enviar(client, pacote, mqtt_pacote_subscribe(pacote, r->id, topic, qos));
+    free(pacote);
+    return ERR_OK;
+}
+
+err_t mqtt_publish(mqtt_client_t *client, const char *topic, const void *payload, u16_t payload_length, u8_t qos,
+                   u8_t retain, mqtt_request_cb_t cb, void *arg) {
+    if (client->estado != CLIENTE_CONECTADO) return ERR_CONN;
+    size_t tamanho = mqtt_pacote_tamanho_publish(strlen(topic), payload_length, qos);
+    if (pendentes_transporte() + tamanho > MQTT_OUTPUT_RINGBUF_SIZE) return ERR_MEM;
+    requisicao_t *r = criar_requisicao(client, qos ? gerar_id(client) : 0, cb, arg);
+    if (!r) return ERR_MEM;
+    uint8_t *pacote = malloc(tamanho);
+    if (!pacote) placa_panico("publish sem memoria", __FILE__, __LINE__);
+    enviar(client, pacote, mqtt_pacote_publish(pacote, topic, payload, payload_length, qos, retain, r->id));
+    free(pacote);
+    r->fim_envio = client->enviados_total;
+    return ERR_OK;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file mqtt_pacote.c
+ * @brief Implementação do codec MQTT 3.1.1 (só os pacotes que a estufa troca).
+ */
+
+#include "mqtt_pacote.h"
+#include <string.h>
+
+// --- Funções Auxiliares ---
+
+static size_t escrever_cabecalho(uint8_t *destino, uint8_t tipo_flags, size_t restante) {
+    size_t n = 0;
+    destino[n++] = tipo_flags;
+    do {
+        uint8_t b = restante & 0x7F;
+        restante >>= 7;
+        destino[n++] = restante ? b | 0x80 : b;
+    } while (restante);
+    return n;
+}
+
+static size_t tamanho_cabecalho(size_t restante) {
+    size_t n = 2;
+    while (restante >= 128) {
+        restante >>= 7;
+        n++;
+    }
+    return n;
+}
+
+static size_t escrever_u16(uint8_t *destino, uint16_t valor) {
+    destino[0] = (uint8_t)(valor >> 8);
+    destino[1] = (uint8_t)valor;
+    return 2;
+}
+
+static size_t escrever_texto(uint8_t *destino, const char *texto) {
+    size_t n = strlen(texto);
+    escrever_u16(destino, (uint16_t)n);
+    memcpy(destino + 2, texto, n);
+    return n + 2;
+}
+
+static uint16_t ler_u16(const uint8_t *p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+// --- Implementação das Funções Públicas ---
+
+long mqtt_pacote_extrair(const uint8_t *dados, size_t tamanho, mqtt_pacote_t *pacote) {
+    if (tamanho < 2) return 0;
+    size_t restante = 0;
+    size_t i = 1;
+    for (unsigned deslocamento = 0;; deslocamento += 7) {
+        if (i >= tamanho) return 0;
+        if (i > 4) return -1;
+        restante |= (size_t)(dados[i] & 0x7F) << deslocamento;
+        if (!(dados[i++] & 0x80)) break;
+    }
+    if (tamanho - i < restante) return 0;
+    pacote->tipo = dados[0] >> 4;
+    pacote->flags = dados[0] & 0x0F;
+    pacote->corpo = dados + i;
+    pacote->tamanho = restante;
+    return (long)(i + restante);
+}
+
+bool mqtt_pacote_ler_publish(const mqtt_pacote_t *pacote, mqtt_publish_t *publish) {
+    if (pacote->tipo != MQTT_PACOTE_PUBLISH || pacote->tamanho < 2) return false;
+    const uint8_t *p = pacote->corpo;
+    size_t n = ler_u16(p);
+    publish->qos = (pacote->flags >> 1) & 3;
+    publish->reter = pacote->flags & 1;
+    size_t cabecalho = 2 + n + (publish->qos ? 2 : 0);
+    if (cabecalho > pacote->tamanho) return false;
+    publish->topico = (const char *)p + 2;
+    publish->topico_tamanho = n;
+    publish->id = publish->qos ? ler_u16(p + 2 + n) : 0;
+    publish->payload = p + cabecalho;
+    publish->payload_tamanho = pacote->tamanho - cabecalho;
+    return true;
+}
+
+uint16_t mqtt_pacote_id(const mqtt_pacote_t *pacote) {
+    return pacote->tamanho >= 2 ? ler_u16(pacote->corpo) : 0;
+}
+
+size_t mqtt_pacote_tamanho_publish(size_t topico, size_t payload, uint8_t qos) {
+    size_t restante = 2 + topico + (qos ? 2 : 0) + payload;
+    return tamanho_cabecalho(restante) + restante;
+}
+
+size_t mqtt_pacote_connect(uint8_t *destino, const char *client_id, uint16_t keep_alive) {
+    size_t restante = 10 + 2 + strlen(client_id);
+    size_t n = escrever_cabecalho(destino, MQTT_PACOTE_CONNECT << 4, restante);
+    n += escrever_texto(destino + n, "MQTT");
+    destino[n++] = 4;    // Nível do protocolo: 3.1.1
+    destino[n++] = 0x02; // Sessão limpa
+    n += escrever_u16(destino + n, keep_alive);
+    n += escrever_texto(destino + n, client_id);
+    return n;
+}
+
+size_t mqtt_pacote_connack(uint8_t *destino, uint8_t codigo) {
+    size_t n = escrever_cabecalho(destino, MQTT_PACOTE_CONNACK << 4, 2);
+    destino[n++] = 0;
+    destino[n++] = codigo;
+    return n;
+}
+
+size_t mqtt_pacote_publish(uint8_t *destino, const char *topico, const void *payload, size_t tamanho,
+                           uint8_t qos, bool reter, uint16_t id) {
+    size_t restante = 2 + strlen(topico) + (qos ? 2 : 0) + tamanho;
+    size_t n = escrever_cabecalho(destino, (uint8_t)((MQTT_PACOTE_PUBLISH << 4) | (qos << 1) | (reter ? 1 : 0)), restante);
+    n += escrever_texto(destino + n, topico);
+    if (qos) n += escrever_u16(destino + n, id);
+    memcpy(destino + n, payload, tamanho);
+    return n + tamanho;
+}
+
+size_t mqtt_pacote_puback(uint8_t *destino, uint16_t id) {
+    size_t n = escrever_cabecalho(destino, MQTT_PACOTE_PUBACK << 4, 2);
+    return n + escrever_u16(destino + n, id);
+}
+
+size_t mqtt_pacote_subscribe(uint8_t *destino, uint16_t id, const char *topico, uint8_t qos) {
+    size_t restante = 2 + 2 + strlen(topico) + 1;
+    size_t n = escrever_cabecalho(destino, (MQTT_PACOTE_SUBSCRIBE << 4) | 0x02, restante);
+    n += escrever_u16(destino + n, id);
+    n += escrever_texto(destino + n, topico);
+    destino[n++] = qos;
+    return n;
+}
+
+size_t mqtt_pacote_suback(uint8_t *destino, uint16_t id, uint8_t qos) {
+    size_t n = escrever_cabecalho(destino, MQTT_PACOTE_SUBACK << 4, 3);
+    n += escrever_u16(destino + n, id);
+    destino[n++] = qos;
+    return n;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file mqtt_pacote.h
+ * @brief Codificação e decodificação dos pacotes MQTT 3.1.1 usados pela estufa, comuns ao
+ * cliente da placa simulada e ao broker do ensaio.
+ */
+
+#ifndef MQTT_PACOTE_H
+#define MQTT_PACOTE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+enum {
+    MQTT_PACOTE_CONNECT = 1,
+    MQTT_PACOTE_CONNACK = 2,
+    MQTT_PACOTE_PUBLISH = 3,
+    MQTT_PACOTE_PUBACK = 4,
+    MQTT_PACOTE_SUBSCRIBE = 8,
+    MQTT_PACOTE_SUBACK = 9,
+    MQTT_PACOTE_PINGREQ = 12,
+    MQTT_PACOTE_PINGRESP = 13,
+    MQTT_PACOTE_DISCONNECT = 14,
+};
+
+#define MQTT_PACOTE_CABECALHO_MAX 5 // Tipo + até 4 bytes de comprimento restante
+
+/**
+ * @brief Pacote decodificado; os ponteiros apontam para o buffer de entrada.
+ */
+typedef struct {
+    uint8_t tipo;
+    uint8_t flags;
+    const uint8_t *corpo;
+    size_t tamanho;
+} mqtt_pacote_t;
+
+/**
+ * @brief PUBLISH decodificado.
+ */
+typedef struct {
+    const char *topico;     ///< Não terminado em '\0'
+    size_t topico_tamanho;
+    const uint8_t *payload;
+    size_t payload_tamanho;
+    uint8_t qos;
+    bool reter;
+    uint16_t id;
+} mqtt_publish_t;
+
+/**
+ * @brief Extrai o próximo pacote completo do buffer.
+ * @return Bytes consumidos; 0 se o pacote ainda não chegou inteiro; -1 se malformado.
+ */
+long mqtt_pacote_extrair(const uint8_t *dados, size_t tamanho, mqtt_pacote_t *pacote);
+
+bool mqtt_pacote_ler_publish(const mqtt_pacote_t *pacote, mqtt_publish_t *publish);
+
+/**
+ * @brief Primeiro identificador de pacote do corpo (PUBACK, SUBACK, SUBSCRIBE).
+ */
+uint16_t mqtt_pacote_id(const mqtt_pacote_t *pacote);
+
+/**
+ * @brief Tamanho total de um PUBLISH, para checar o espaço antes de montá-lo.
+ */
+size_t mqtt_pacote_tamanho_publish(size_t topico, size_t payload, uint8_t qos);
+
+// Montagem: cada função escreve em destino (com espaço suficiente) e devolve o tamanho.
+size_t mqtt_pacote_connect(uint8_t *destino, const char *client_id, uint16_t keep_alive);
+size_t mqtt_pacote_connack(uint8_t *destino, uint8_t codigo);
+size_t mqtt_pacote_publish(uint8_t *destino, const char *topico, const void *payload, size_t tamanho,
+                           uint8_t qos, bool reter, uint16_t id);
+size_t mqtt_pacote_puback(uint8_t *destino, uint16_t id);
+size_t mqtt_pacote_subscribe(uint8_t *destino, uint16_t id, const char *topico, uint8_t qos);
+size_t mqtt_pacote_suback(uint8_t *destino, uint16_t id, uint8_t qos);
+
+#endif // MQTT_PACOTE_H
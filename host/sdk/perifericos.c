@@ -0,0 +1,447 @@
+/**
+ * @file perifericos.c
+ * @brief GPIO, PWM, I2C (com os sensores simulados), PIO, ADC e DMA da placa simulada.
+ *
+ * As transferências ocupam o núcleo pelo tempo que levariam no barramento: I2C a 9 bits
+ * por byte (mais o endereço) no baudrate configurado e 30 µs por LED no PIO do WS2812.
+ * O wrap de cada slice do PWM é agendado no escalonador enquanto a interrupção do slice
+ * estiver habilitada, no período dado pelo divisor, pelo wrap e pelo clk_sys.
+ */
+
+#include "placa_interna.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/i2c.h"
+#include "hardware/irq.h"
+#include "hardware/pio.h"
+#include "hardware/pwm.h"
+#include "pico/platform.h"
+#include <string.h>
+
+#define NUM_IRQS 32
+#define IRQ_TRATADORES_MAX 4
+#define PIO_PALAVRA_US 30         // 24 bits a 800 kHz
+#define I2C_BITS_POR_BYTE 9       // 8 bits de dados + ACK
+
+#define AHT10_ENDERECO 0x38
+#define BH1750_ENDERECO 0x23
+#define TCA9548A_ENDERECO 0x70
+#define SSD1306_ENDERECO 0x3C
+
+typedef struct {
+    uint8_t funcao;
+    bool saida;
+    bool valor;
+    bool pull_up;
+} pino_t;
+
+typedef struct {
+    float divisor;
+    bool agendado;            // Há um wrap agendado no escalonador
+    uint64_t inicio_ns;       // Instante (da placa) em que o slice foi habilitado
+    uint64_t proximo_ns;
+} slice_t;
+
+typedef struct {
+    irq_handler_t tratadores[IRQ_TRATADORES_MAX];
+    uint num_tratadores;
+    bool habilitada;
+    uint nucleo;
+} irq_t;
+
+typedef struct {
+    bool ativo;
+    volatile void *destino;
+    uint transferencias;
+} canal_dma_t;
+
+pwm_hw_t placa_pwm_hw;
+i2c_inst_t placa_i2c[2] = { { .indice = 0 }, { .indice = 1 } };
+pio_hw_t placa_pio[2];
+adc_hw_t placa_adc_hw;
+
+static pino_t pinos[NUM_BANK0_GPIOS];
+static slice_t slices[NUM_PWM_SLICES];
+static irq_t irqs[NUM_IRQS];
+static gpio_irq_callback_t callback_gpio; // Sem entradas externas no host: o botão nunca é apertado
+
+static struct {
+    uint8_t bruto[6];
+} aht10;
+static uint16_t bh1750_bruto;
+static uint8_t tca9548a_mascara;
+
+static struct {
+    float divisor;
+    bool rodando;
+    uint64_t inicio_us;
+    uint entrada;
+} adc;
+static canal_dma_t canais_dma[NUM_DMA_CHANNELS];
+static uint canais_dma_usados;
+
+// --- Funções Auxiliares ---
+
+static void ler_ambiente(uint8_t endereco, placa_ambiente_t *ambiente) {
+    *ambiente = (placa_ambiente_t){ .temp_c100 = 2500, .umid_c100 = 5000, .luz_mlux = 500000, .solo_adc = 2000 };
+    if (placa_cfg.ambiente) placa_cfg.ambiente(placa_cfg.ctx, placa_agora_us(), endereco, ambiente);
+}
+
+static uint64_t pwm_periodo_ns(uint s) {
+    double ciclos = (double)slices[s].divisor * ((double)pwm_hw->slice[s].top + 1.0);
+    return (uint64_t)(ciclos * 1e9 / (double)clock_get_hz(clk_sys));
+}
+
+static bool pwm_interrupcao_armada(uint s) {
+    return (pwm_hw->slice[s].csr & 1u) && (pwm_hw->inte & (1u << s));
+}
+
+static void pwm_wrap(void *ctx);
+
+static void pwm_agendar(uint s, uint64_t quando_ns) {
+    slices[s].proximo_ns = quando_ns;
+    slices[s].agendado = true;
+    escalonador_agendar(placa_para_escalonador((quando_ns + 999) / 1000), pwm_wrap, (void *)(uintptr_t)s);
+}
+
+/**
+ * @brief Wrap de um slice: marca a interrupção e agenda o próximo enquanto ela estiver armada.
+ */
+static void pwm_wrap(void *ctx) {
+    uint s = (uint)(uintptr_t)ctx;
+    if (!pwm_interrupcao_armada(s)) {
+        slices[s].agendado = false;
+        return;
+    }
+    pwm_hw->intr |= 1u << s;
+    if (irqs[PWM_IRQ_WRAP].habilitada) placa_acordar_nucleo(irqs[PWM_IRQ_WRAP].nucleo);
+    uint64_t periodo = pwm_periodo_ns(s);
+    uint64_t agora_ns = placa_agora_us() * 1000;
+    uint64_t proximo = slices[s].proximo_ns + periodo;
+    if (proximo <= agora_ns) proximo = agora_ns + periodo;
+    pwm_agendar(s, proximo);
+}
+
+/**
+ * @brief Agenda o próximo wrap, em fase com a habilitação do slice, se a interrupção acabou de ser armada.
+ */
+static void pwm_atualizar(uint s) {
+    if (slices[s].agendado || !pwm_interrupcao_armada(s)) return;
+    uint64_t periodo = pwm_periodo_ns(s);
+    if (periodo == 0) periodo = 1;
+    uint64_t agora_ns = placa_agora_us() * 1000;
+    uint64_t decorridos = (agora_ns - slices[s].inicio_ns) / periodo + 1;
+    pwm_agendar(s, slices[s].inicio_ns + decorridos * periodo);
+}
+
+static uint64_t i2c_duracao_us(const i2c_inst_t *i2c, size_t tamanho) {
+    uint32_t baudrate = i2c->baudrate ? i2c->baudrate : 100000;
+    uint64_t us = ((uint64_t)tamanho + 1) * I2C_BITS_POR_BYTE * 1000000ull / baudrate;
+    return us ? us : 1;
+}
+
+static void aht10_medir(void) {
+    placa_ambiente_t amb;
+    ler_ambiente(AHT10_ENDERECO, &amb);
+    int32_t umid = amb.umid_c100 < 0 ? 0 : amb.umid_c100 > 10000 ? 10000 : amb.umid_c100;
+    int32_t temp = amb.temp_c100 < -5000 ? -5000 : amb.temp_c100 > 15000 ? 15000 : amb.temp_c100;
+    uint32_t h = (uint32_t)(((uint64_t)umid << 20) / 10000);
+    uint32_t t = (uint32_t)(((uint64_t)(temp + 5000) << 20) / 20000);
+    if (h > 0xFFFFF) h = 0xFFFFF;
+    if (t > 0xFFFFF) t = 0xFFFFF;
+    aht10.bruto[0] = 0x08; // Calibrado, livre
+    aht10.bruto[1] = (uint8_t)(h >> 12);
+    aht10.bruto[2] = (uint8_t)(h >> 4);
+    aht10.bruto[3] = (uint8_t)(((h & 0x0F) << 4) | (t >> 16));
+    aht10.bruto[4] = (uint8_t)(t >> 8);
+    aht10.bruto[5] = (uint8_t)t;
+}
+
+static void bh1750_medir(void) {
+    placa_ambiente_t amb;
+    ler_ambiente(BH1750_ENDERECO, &amb);
+    uint64_t bruto = ((uint64_t)amb.luz_mlux * 3 + 1250) / 2500; // Inverso de bh1750_converter_bruto
+    bh1750_bruto = bruto > 0xFFFF ? 0xFFFF : (uint16_t)bruto;
+}
+
+/**
+ * @brief Dispositivos do barramento: AHT10, BH1750 e TCA9548A no I2C0; SSD1306 no I2C1.
+ * @return false se ninguém responde no endereço.
+ */
+static bool i2c_escrever_dispositivo(uint barramento, uint8_t endereco, const uint8_t *dados, size_t tamanho) {
+    if (barramento == 1) return endereco == SSD1306_ENDERECO;
+    switch (endereco) {
+        case AHT10_ENDERECO:
+            if (tamanho > 0 && dados[0] == 0xAC) aht10_medir();
+            return true;
+        case BH1750_ENDERECO:
+            if (tamanho > 0 && dados[0] == 0x20) bh1750_medir();
+            return true;
+        case TCA9548A_ENDERECO:
+            if (tamanho > 0) tca9548a_mascara = dados[0];
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool i2c_ler_dispositivo(uint barramento, uint8_t endereco, uint8_t *dados, size_t tamanho) {
+    if (barramento != 0) return false;
+    switch (endereco) {
+        case AHT10_ENDERECO:
+            for (size_t i = 0; i < tamanho; i++) dados[i] = i < sizeof(aht10.bruto) ? aht10.bruto[i] : 0;
+            return true;
+        case BH1750_ENDERECO:
+            for (size_t i = 0; i < tamanho; i++) dados[i] = i == 0 ? (uint8_t)(bh1750_bruto >> 8) : i == 1 ? (uint8_t)bh1750_bruto : 0;
+            return true;
+        case TCA9548A_ENDERECO:
+            memset(dados, tca9548a_mascara, tamanho);
+            return true;
+        default:
+            return false;
+    }
+}
+
+// --- Interrupções ---
+
+bool placa_perifericos_atender(uint nucleo) {
+    irq_t *irq = &irqs[PWM_IRQ_WRAP];
+    if (!irq->habilitada || irq->nucleo != nucleo) return false;
+    uint32_t pendentes = pwm_hw->intr & pwm_hw->inte;
+    if (!pendentes) return false;
+    for (uint i = 0; i < irq->num_tratadores; i++) {
+        irq->tratadores[i]();
+    }
+    // Um bit que nenhum tratador limpa travaria o RP2040 em interrupção; aqui é descartado.
+    pwm_hw->intr &= ~pendentes;
+    return true;
+}
+
+void irq_add_shared_handler(uint num, irq_handler_t tratador, uint8_t prioridade) {
+    (void)prioridade;
+    irq_t *irq = &irqs[num];
+    hard_assert(irq->num_tratadores < IRQ_TRATADORES_MAX);
+    irq->tratadores[irq->num_tratadores++] = tratador;
+}
+
+void irq_set_exclusive_handler(uint num, irq_handler_t tratador) {
+    irqs[num].tratadores[0] = tratador;
+    irqs[num].num_tratadores = 1;
+}
+
+void irq_set_enabled(uint num, bool ligado) {
+    irqs[num].habilitada = ligado;
+    irqs[num].nucleo = get_core_num(); // Como no RP2040: a interrupção vai para o núcleo que a habilitou
+}
+
+// --- GPIO ---
+
+void gpio_init(uint gpio) {
+    pinos[gpio] = (pino_t){ .funcao = GPIO_FUNC_SIO };
+}
+
+void gpio_set_dir(uint gpio, bool saida) {
+    pinos[gpio].saida = saida;
+}
+
+void gpio_pull_up(uint gpio) {
+    pinos[gpio].pull_up = true;
+}
+
+void gpio_pull_down(uint gpio) {
+    pinos[gpio].pull_up = false;
+}
+
+void gpio_disable_pulls(uint gpio) {
+    pinos[gpio].pull_up = false;
+}
+
+void gpio_put(uint gpio, bool valor) {
+    pinos[gpio].valor = valor;
+}
+
+bool gpio_get(uint gpio) {
+    return pinos[gpio].saida ? pinos[gpio].valor : pinos[gpio].pull_up;
+}
+
+void gpio_set_function(uint gpio, enum gpio_function funcao) {
+    pinos[gpio].funcao = (uint8_t)funcao;
+    if (placa_cfg.gpio_funcao) placa_cfg.gpio_funcao(placa_cfg.ctx, gpio, funcao, placa_agora_us());
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t eventos, bool ligado, gpio_irq_callback_t callback) {
+    (void)gpio;
+    (void)eventos;
+    (void)ligado;
+    callback_gpio = callback;
+}
+
+// --- PWM ---
+
+void pwm_set_clkdiv(uint slice, float divisor) {
+    slices[slice].divisor = divisor;
+    pwm_hw->slice[slice].div = (uint32_t)(divisor * 16.0f); // Ponto fixo 8.4
+}
+
+void pwm_set_wrap(uint slice, uint16_t wrap) {
+    pwm_hw->slice[slice].top = wrap;
+}
+
+void pwm_set_chan_level(uint slice, uint canal, uint16_t nivel) {
+    uint32_t cc = pwm_hw->slice[slice].cc;
+    pwm_hw->slice[slice].cc = canal ? (cc & 0xFFFFu) | ((uint32_t)nivel << 16) : (cc & 0xFFFF0000u) | nivel;
+}
+
+void pwm_set_gpio_level(uint gpio, uint16_t nivel) {
+    pwm_set_chan_level(pwm_gpio_to_slice_num(gpio), pwm_gpio_to_channel(gpio), nivel);
+}
+
+void pwm_set_enabled(uint slice, bool ligado) {
+    if (ligado && !(pwm_hw->slice[slice].csr & 1u)) {
+        slices[slice].inicio_ns = placa_agora_us() * 1000;
+        if (slices[slice].divisor == 0.0f) slices[slice].divisor = 1.0f;
+    }
+    pwm_hw->slice[slice].csr = ligado ? pwm_hw->slice[slice].csr | 1u : pwm_hw->slice[slice].csr & ~1u;
+    pwm_atualizar(slice);
+}
+
+void pwm_set_irq_enabled(uint slice, bool ligado) {
+    pwm_hw->inte = ligado ? pwm_hw->inte | (1u << slice) : pwm_hw->inte & ~(1u << slice);
+    pwm_atualizar(slice);
+}
+
+void pwm_clear_irq(uint slice) {
+    pwm_hw->intr &= ~(1u << slice);
+}
+
+uint32_t pwm_get_irq_status_mask(void) {
+    return pwm_hw->intr & pwm_hw->inte;
+}
+
+// --- I2C ---
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+    i2c->baudrate = baudrate;
+    return baudrate;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t endereco, const uint8_t *dados, size_t tamanho, bool sem_stop) {
+    (void)sem_stop;
+    bool respondeu = i2c_escrever_dispositivo(i2c->indice, endereco, dados, tamanho);
+    placa_ocupar_us(i2c_duracao_us(i2c, respondeu ? tamanho : 0)); // Sem ACK, a transferência para no endereço
+    return respondeu ? (int)tamanho : PICO_ERROR_GENERIC;
+}
+
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t endereco, uint8_t *dados, size_t tamanho, bool sem_stop) {
+    (void)sem_stop;
+    bool respondeu = i2c_ler_dispositivo(i2c->indice, endereco, dados, tamanho);
+    placa_ocupar_us(i2c_duracao_us(i2c, respondeu ? tamanho : 0));
+    return respondeu ? (int)tamanho : PICO_ERROR_GENERIC;
+}
+
+// --- PIO ---
+
+uint pio_add_program(PIO pio, const pio_program_t *programa) {
+    (void)pio;
+    (void)programa;
+    return 0;
+}
+
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t dado) {
+    pio->ultimo_dado[sm] = dado;
+    placa_ocupar_us(PIO_PALAVRA_US);
+}
+
+// --- ADC e DMA ---
+
+void adc_init(void) {
+    adc.divisor = 0.0f;
+    adc.rodando = false;
+}
+
+void adc_gpio_init(uint gpio) {
+    pinos[gpio].funcao = GPIO_FUNC_NULL;
+}
+
+void adc_select_input(uint entrada) {
+    adc.entrada = entrada;
+}
+
+void adc_fifo_setup(bool ligado, bool dreq, uint16_t limiar, bool erro, bool byte) {
+    (void)ligado;
+    (void)dreq;
+    (void)limiar;
+    (void)erro;
+    (void)byte;
+}
+
+void adc_set_clkdiv(float divisor) {
+    adc.divisor = divisor;
+}
+
+void adc_run(bool ligado) {
+    adc.rodando = ligado;
+    adc.inicio_us = placa_agora_us();
+}
+
+void adc_fifo_drain(void) {
+}
+
+uint16_t adc_read(void) {
+    placa_ambiente_t amb;
+    ler_ambiente(0, &amb);
+    return amb.solo_adc & 0x0FFF;
+}
+
+int dma_claim_unused_channel(bool obrigatorio) {
+    if (canais_dma_usados < NUM_DMA_CHANNELS) return (int)canais_dma_usados++;
+    if (obrigatorio) placa_panico("sem canal de DMA livre", __FILE__, __LINE__);
+    return -1;
+}
+
+dma_channel_config dma_channel_get_default_config(uint canal) {
+    (void)canal;
+    return (dma_channel_config){ .tamanho = DMA_SIZE_32, .incrementa_leitura = true };
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size tamanho) {
+    c->tamanho = (uint8_t)tamanho;
+}
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incrementa) {
+    c->incrementa_leitura = incrementa;
+}
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incrementa) {
+    c->incrementa_escrita = incrementa;
+}
+
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) {
+    c->dreq = dreq;
+}
+
+void dma_channel_configure(uint canal, const dma_channel_config *c, volatile void *destino,
+                           const volatile void *origem, uint transferencias, bool disparar) {
+    (void)c;
+    (void)origem;
+    canais_dma[canal] = (canal_dma_t){ .ativo = disparar, .destino = destino, .transferencias = transferencias };
+}
+
+bool dma_channel_is_busy(uint canal) {
+    canal_dma_t *d = &canais_dma[canal];
+    if (!d->ativo) return false;
+    // Cada transferência espera uma conversão do ADC (DREQ_ADC), a clk_adc / (divisor + 1).
+    uint64_t periodo_ns = (uint64_t)(((double)adc.divisor + 1.0) * 1e9 / clock_get_hz(clk_adc));
+    if (!adc.rodando || (placa_agora_us() - adc.inicio_us) * 1000 < periodo_ns * d->transferencias) return true;
+    uint16_t leitura = adc_read();
+    volatile uint16_t *destino = d->destino;
+    for (uint i = 0; i < d->transferencias; i++) destino[i] = leitura;
+    d->ativo = false;
+    return false;
+}
+
+void dma_channel_abort(uint canal) {
+    canais_dma[canal].ativo = false;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file placa.h
+ * @brief Placa simulada: o firmware inteiro (main.c e demais módulos, sem alterações)
+ * compilado para o host sobre o SDK de include/.
+ *
+ * Cada placa tem dois núcleos (corrotinas do escalonador), flash, FIFOs, PWM, I2C com
+ * AHT10/BH1750/SSD1306 simulados e o rádio com o cliente MQTT do LWIP. O mundo externo
+ * entra pela configuração: o ambiente lido pelos sensores, o transporte até o broker e o
+ * horário de parede do SNTP.
+ *
+ * O estado da placa é estático no próprio módulo: o ensaio de latência liga uma placa por
+ * processo, e o simulador de frota carrega uma cópia do módulo por placa (dlopen).
+ */
+
+#ifndef PLACA_H
+#define PLACA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define PLACA_API __attribute__((visibility("default")))
+
+/**
+ * @brief Grandezas do ambiente, lidas pelos sensores no instante da medição.
+ */
+typedef struct {
+    int32_t temp_c100;  ///< Temperatura em centésimos de °C
+    int32_t umid_c100;  ///< Umidade relativa em centésimos de %
+    uint32_t luz_mlux;  ///< Luminosidade em mlux
+    uint16_t solo_adc;  ///< Leitura bruta (12 bits) da sonda de solo
+} placa_ambiente_t;
+
+/**
+ * @brief Eventos do transporte para a placa. Chamados fora das corrotinas (eventos do
+ * escalonador ou descritores prontos); a placa os atende no Core 1, como interrupções.
+ */
+typedef struct {
+    void (*conectada)(bool ok);
+    void (*receber)(const uint8_t *dados, size_t tamanho);
+    void (*enviados)(void); ///< Bytes deixaram o buffer de saída (o tcp_sent do LWIP)
+    void (*caiu)(void);
+} placa_rede_eventos_t;
+
+/**
+ * @brief Conexão de transporte até o broker (o TCP do LWIP, no firmware real).
+ */
+typedef struct {
+    void *ctx;
+    /** Inicia a conexão; o resultado chega por eventos->conectada. */
+    bool (*abrir)(void *ctx, const placa_rede_eventos_t *eventos);
+    void (*enviar)(void *ctx, const uint8_t *dados, size_t tamanho);
+    void (*fechar)(void *ctx);
+    /** Bytes enviados e ainda não entregues (ocupação do buffer de saída do LWIP). */
+    size_t (*pendentes)(void *ctx);
+} placa_transporte_t;
+
+typedef struct {
+    const char *device_id;        ///< NULL ou "": ID de fábrica derivado do número de série
+    uint64_t numero_serie;        ///< pico_get_unique_board_id()
+    placa_transporte_t transporte;
+    uint32_t atraso_wifi_ms;      ///< Da associação até o enlace de pé
+    FILE *console;                ///< Saída do printf do firmware; NULL descarta
+    void *ctx;                    ///< Repassado aos callbacks abaixo
+    /** Ambiente no instante da medição; endereco é o do sensor no I2C (0 para o ADC). */
+    void (*ambiente)(void *ctx, uint64_t agora_us, uint8_t endereco, placa_ambiente_t *ambiente);
+    /** Observador de gpio_set_function() (ex: o servo energizado). Opcional. */
+    void (*gpio_funcao)(void *ctx, unsigned gpio, unsigned funcao, uint64_t agora_us);
+    /** Horário UTC em µs enviado nas respostas do SNTP. NULL: 2026-01-01 mais o tempo ligado. */
+    uint64_t (*hora_utc_us)(void *ctx, uint64_t agora_us);
+} placa_config_t;
+
+/**
+ * @brief Liga a placa: o Core 0 começa a rodar o main() do firmware na próxima volta do
+ * escalonador. O tempo da placa conta a partir daqui.
+ * @param cfg Copiada; os ponteiros dentro dela precisam continuar válidos.
+ */
+PLACA_API void placa_ligar(const placa_config_t *cfg);
+
+/**
+ * @brief Tempo desde que a placa foi ligada, em µs (o time_us_64() do firmware).
+ */
+PLACA_API uint64_t placa_agora_us(void);
+
+/**
+ * @brief Quantas vezes o watchdog teria reiniciado a placa (o reset não é simulado).
+ */
+PLACA_API uint32_t placa_estouros_watchdog(void);
+
+#endif // PLACA_H
@@ -0,0 +1,25 @@
+/**
+ * @file placa_firmware.h
+ * @brief Incluído à força (-include) em cada arquivo do firmware compilado para o host.
+ *
+ * O stdio do firmware é o USB da placa: aqui ele vai para o console configurado em
+ * placa.h, com várias placas no mesmo processo sem misturar a saída.
+ */
+
+#ifndef PLACA_FIRMWARE_H
+#define PLACA_FIRMWARE_H
+
+#include <stdio.h>
+
+int placa_printf(const char *formato, ...) __attribute__((format(printf, 1, 2)));
+int placa_putchar(int c);
+
+/**
+ * @brief DEVICE_ID compilado no firmware: o da configuração da placa, ou "" (ID de fábrica).
+ */
+const char *placa_device_id(void);
+
+#define printf(...) placa_printf(__VA_ARGS__)
+#define putchar(c) placa_putchar(c)
+
+#endif // PLACA_FIRMWARE_H
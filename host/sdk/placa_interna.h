@@ -0,0 +1,77 @@
+/**
+ * @file placa_interna.h
+ * @brief Ligações entre os módulos da placa simulada (plataforma, rádio e cliente MQTT).
+ */
+
+#ifndef PLACA_INTERNA_H
+#define PLACA_INTERNA_H
+
+#include "placa.h"
+#include "escalonador.h"
+#include "pico.h"
+
+extern placa_config_t placa_cfg;
+
+/**
+ * @brief Converte um instante da placa para o relógio do escalonador.
+ */
+uint64_t placa_para_escalonador(uint64_t instante_us);
+
+/**
+ * @brief Acorda um núcleo bloqueado para que ele atenda suas interrupções.
+ */
+void placa_acordar_nucleo(uint nucleo);
+
+/**
+ * @brief Bloqueia o núcleo atual até o instante (da placa) ou até ser acordado.
+ */
+void placa_bloquear_ate(uint64_t instante_us);
+
+/**
+ * @brief Atende as interrupções pendentes do núcleo atual, se ele não as mascarou.
+ * @return true se algum tratador rodou.
+ */
+bool placa_atender_interrupcoes(void);
+
+/**
+ * @brief Ocupa o núcleo atual pela duração de uma transferência (I2C, PIO, flash),
+ * atendendo as interrupções no meio, se não estiverem mascaradas.
+ */
+void placa_ocupar_us(uint64_t duracao_us);
+
+/**
+ * @brief Atende as interrupções de periféricos (GPIO, wrap do PWM) habilitadas no núcleo.
+ * @return true se algum tratador rodou.
+ */
+bool placa_perifericos_atender(uint nucleo);
+
+/**
+ * @brief Núcleo que atende o rádio e o LWIP (o que chamou cyw43_arch_init()).
+ */
+uint placa_nucleo_rede(void);
+
+/**
+ * @brief Atende o rádio: enlace, SNTP, trabalhadores assíncronos e o cliente MQTT.
+ * Chamado pela plataforma no núcleo da rede, fora de cyw43_arch_lwip_begin()/end().
+ * @return true se algum trabalho foi feito.
+ */
+bool placa_rede_atender(void);
+
+/**
+ * @brief Profundidade de cyw43_arch_lwip_begin() no núcleo da rede.
+ */
+uint placa_rede_bloqueios(void);
+
+/**
+ * @brief Instante (da placa) em que bytes que chegam agora ao rádio são entregues ao LWIP.
+ * No modo de economia agressivo, o rádio só ouve o AP no próximo beacon.
+ */
+uint64_t placa_rede_entrega(uint64_t chegada_us);
+
+/**
+ * @brief Cliente MQTT: atende eventos do transporte e prazos vencidos.
+ * @return true se algum trabalho foi feito.
+ */
+bool placa_mqtt_atender(void);
+
+#endif // PLACA_INTERNA_H
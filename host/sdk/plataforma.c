@@ -0,0 +1,516 @@
+/**
+ * @file plataforma.c
+ * @brief Núcleos, tempo, sincronização, FIFOs, stdio, clocks, flash e watchdog da placa
+ * simulada.
+ *
+ * O tempo da placa é o do escalonador desde placa_ligar(). Cada núcleo é uma corrotina que
+ * só cede nos pontos em que o RP2040 esperaria (sono, WFE, FIFO, transferências), e as
+ * interrupções pendentes são atendidas nesses mesmos pontos, se o núcleo não as mascarou.
+ */
+
+#define _GNU_SOURCE
+#include "placa_interna.h"
+#include "hardware/clocks.h"
+#include "hardware/flash.h"
+#include "hardware/structs/systick.h"
+#include "hardware/structs/xip_ctrl.h"
+#include "hardware/sync.h"
+#include "hardware/watchdog.h"
+#include "pico/multicore.h"
+#include "pico/sync.h"
+#include "pico/unique_id.h"
+#include "pico/util/queue.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define PILHA_TAMANHO (64 * 1024)           // Por núcleo: o printf da glibc pede bem mais que os 2 KB do RP2040
+#define FLASH_APAGADA_BYTES (64 * 1024)     // Fim da flash, onde fica a configuração
+#define FLASH_APAGAR_SETOR_US 45000         // Apagamento de um setor de 4 KB
+#define FLASH_GRAVAR_PAGINA_US 800          // Gravação de uma página de 256 bytes
+#define ESPERA_ATIVA_PASSO_US 10            // Passo de tempo de tight_loop_contents()
+#define RELOGIO_REFERENCIA_HZ 12000000u
+#define RELOGIO_USB_ADC_HZ 48000000u
+
+typedef struct {
+    corrotina_t *corrotina;
+    bool evento;                                // Registrador de evento do WFE
+    bool mascarado;                             // PRIMASK
+    bool em_interrupcao;                        // Sem aninhamento de tratadores
+    uint32_t fifo[SIO_FIFO_PROFUNDIDADE];       // FIFO de entrada deste núcleo
+    uint fifo_inicio, fifo_ocupados;
+} nucleo_t;
+
+placa_config_t placa_cfg;
+uint8_t placa_flash[PICO_FLASH_SIZE_BYTES];
+watchdog_hw_t placa_watchdog_hw;
+xip_ctrl_hw_t placa_xip_ctrl_hw;
+
+static uint64_t inicio_us;
+static nucleo_t nucleos[2];
+static uint32_t clk_sys_khz = 125000;
+static systick_hw_t systick;
+
+static struct {
+    bool ligado;
+    bool agendado;
+    uint64_t atraso_us;
+    uint64_t ultima_alimentacao;
+    uint32_t estouros;
+} watchdog;
+
+// Pilhas dos núcleos e símbolos do script de ligação que memoria.c lê: cada núcleo pinta e
+// mede a própria pilha. O heap do firmware é o da glibc; só o tamanho nominal é usado.
+static uint8_t pilha_nucleo0[PILHA_TAMANHO] __attribute__((aligned(16), used));
+static uint8_t pilha_nucleo1[PILHA_TAMANHO] __attribute__((aligned(16), used));
+static uint8_t heap_nominal[16] __attribute__((used));
+
+#define PLACA_STR(x) #x
+#define PLACA_XSTR(x) PLACA_STR(x)
+#define PLACA_SIMBOLO(nome, valor) ".globl " #nome "\n.hidden " #nome "\n.set " #nome ", " valor "\n"
+__asm__(PLACA_SIMBOLO(__scratch_y_end__, "pilha_nucleo0")
+        PLACA_SIMBOLO(__StackBottom, "pilha_nucleo0")
+        PLACA_SIMBOLO(__StackTop, "pilha_nucleo0 + " PLACA_XSTR(PILHA_TAMANHO))
+        PLACA_SIMBOLO(__scratch_x_end__, "pilha_nucleo1")
+        PLACA_SIMBOLO(__StackOneBottom, "pilha_nucleo1")
+        PLACA_SIMBOLO(__StackOneTop, "pilha_nucleo1 + " PLACA_XSTR(PILHA_TAMANHO))
+        PLACA_SIMBOLO(__end__, "heap_nominal")
+        PLACA_SIMBOLO(__HeapLimit, "heap_nominal + 0x38000"));
+
+int estufa_main(void);
+
+// --- Funções Auxiliares ---
+
+static nucleo_t *nucleo_atual(void) {
+    return &nucleos[get_core_num()];
+}
+
+static void entrada_nucleo0(void *arg) {
+    (void)arg;
+    estufa_main();
+}
+
+static void entrada_nucleo1(void *arg) {
+    ((void (*)(void))arg)();
+}
+
+/**
+ * @brief Espera até o instante atendendo interrupções (sono, espera ativa, transferências).
+ */
+static void esperar_ate(uint64_t instante) {
+    while (time_us_64() < instante) {
+        if (!placa_atender_interrupcoes()) placa_bloquear_ate(instante);
+    }
+}
+
+static void verificar_watchdog(void *ctx) {
+    (void)ctx;
+    uint64_t agora = time_us_64();
+    if (!watchdog.ligado) {
+        watchdog.agendado = false;
+        return;
+    }
+    if (agora - watchdog.ultima_alimentacao >= watchdog.atraso_us) {
+        watchdog.estouros++;
+        watchdog.ultima_alimentacao = agora; // A placa real reiniciaria aqui
+        placa_printf("[placa] watchdog estourou em %llu ms (reset nao simulado)\n", (unsigned long long)(agora / 1000));
+    }
+    escalonador_agendar(placa_para_escalonador(watchdog.ultima_alimentacao + watchdog.atraso_us), verificar_watchdog, NULL);
+}
+
+static uint64_t contador_systick(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000ull + (uint64_t)t.tv_nsec;
+#endif
+}
+
+// --- Placa ---
+
+void placa_ligar(const placa_config_t *cfg) {
+    placa_cfg = *cfg;
+    inicio_us = escalonador_agora_us();
+    memset(placa_flash + PICO_FLASH_SIZE_BYTES - FLASH_APAGADA_BYTES, 0xFF, FLASH_APAGADA_BYTES);
+    nucleos[0].corrotina = escalonador_criar(entrada_nucleo0, NULL, pilha_nucleo0, sizeof(pilha_nucleo0));
+}
+
+uint64_t placa_agora_us(void) {
+    return escalonador_agora_us() - inicio_us;
+}
+
+uint32_t placa_estouros_watchdog(void) {
+    return watchdog.estouros;
+}
+
+uint64_t placa_para_escalonador(uint64_t instante_us) {
+    return instante_us >= INT64_MAX ? ESCALONADOR_NUNCA : instante_us + inicio_us;
+}
+
+void placa_acordar_nucleo(uint nucleo) {
+    if (nucleo < 2) escalonador_acordar(nucleos[nucleo].corrotina);
+}
+
+void placa_bloquear_ate(uint64_t instante_us) {
+    escalonador_esperar(placa_para_escalonador(instante_us));
+}
+
+bool placa_atender_interrupcoes(void) {
+    uint n = get_core_num();
+    nucleo_t *c = &nucleos[n];
+    if (c->mascarado || c->em_interrupcao) return false;
+    c->em_interrupcao = true;
+    bool atendeu = placa_perifericos_atender(n);
+    if (n == placa_nucleo_rede() && placa_rede_bloqueios() == 0) {
+        atendeu |= placa_rede_atender();
+    }
+    c->em_interrupcao = false;
+    return atendeu;
+}
+
+void placa_ocupar_us(uint64_t duracao_us) {
+    esperar_ate(time_us_64() + duracao_us);
+}
+
+void placa_panico(const char *motivo, const char *arquivo, int linha) {
+    fprintf(stderr, "[placa] %s em %s:%d\n", motivo, arquivo, linha);
+    abort();
+}
+
+// --- stdio ---
+
+int placa_printf(const char *formato, ...) {
+    if (!placa_cfg.console) return 0;
+    va_list args;
+    va_start(args, formato);
+    int n = vfprintf(placa_cfg.console, formato, args);
+    va_end(args);
+    return n;
+}
+
+int placa_putchar(int c) {
+    return placa_cfg.console ? fputc(c, placa_cfg.console) : c;
+}
+
+const char *placa_device_id(void) {
+    return placa_cfg.device_id ? placa_cfg.device_id : "";
+}
+
+bool stdio_init_all(void) {
+    return true;
+}
+
+void stdio_flush(void) {
+    if (placa_cfg.console) fflush(placa_cfg.console);
+}
+
+int getchar_timeout_us(uint32_t timeout_us) {
+    sleep_us(timeout_us); // Sem entrada no console simulado
+    return PICO_ERROR_TIMEOUT;
+}
+
+// --- Núcleos e Sincronização ---
+
+uint get_core_num(void) {
+    corrotina_t *atual = escalonador_atual();
+    return atual && atual == nucleos[1].corrotina ? 1 : 0;
+}
+
+void tight_loop_contents(void) {
+    placa_atender_interrupcoes();
+    placa_bloquear_ate(time_us_64() + ESPERA_ATIVA_PASSO_US);
+}
+
+uint32_t save_and_disable_interrupts(void) {
+    nucleo_t *c = nucleo_atual();
+    uint32_t estado = c->mascarado ? 1 : 0;
+    c->mascarado = true;
+    return estado;
+}
+
+void restore_interrupts(uint32_t estado) {
+    nucleo_atual()->mascarado = estado != 0;
+}
+
+void __sev(void) {
+    nucleos[0].evento = nucleos[1].evento = true;
+    placa_acordar_nucleo(1 - get_core_num());
+}
+
+void __wfe(void) {
+    nucleo_t *c = nucleo_atual();
+    if (!c->evento && !placa_atender_interrupcoes()) {
+        placa_bloquear_ate(UINT64_MAX);
+        placa_atender_interrupcoes();
+    }
+    c->evento = false;
+}
+
+void __wfi(void) {
+    if (!placa_atender_interrupcoes()) {
+        placa_bloquear_ate(UINT64_MAX);
+        placa_atender_interrupcoes();
+    }
+}
+
+void critical_section_init(critical_section_t *secao) {
+    secao->iniciada = true;
+}
+
+void critical_section_enter_blocking(critical_section_t *secao) {
+    // Um núcleo só perde a vez esperando: a trava entre núcleos não tem disputa.
+    secao->estado_salvo = save_and_disable_interrupts();
+}
+
+void critical_section_exit(critical_section_t *secao) {
+    restore_interrupts(secao->estado_salvo);
+}
+
+// --- Tempo ---
+
+uint64_t time_us_64(void) {
+    return placa_agora_us();
+}
+
+void sleep_until(absolute_time_t t) {
+    esperar_ate(t);
+}
+
+void sleep_us(uint64_t us) {
+    esperar_ate(time_us_64() + us);
+}
+
+void sleep_ms(uint32_t ms) {
+    esperar_ate(time_us_64() + (uint64_t)ms * 1000);
+}
+
+void busy_wait_us(uint64_t us) {
+    esperar_ate(time_us_64() + us);
+}
+
+void busy_wait_ms(uint32_t ms) {
+    esperar_ate(time_us_64() + (uint64_t)ms * 1000);
+}
+
+bool best_effort_wfe_or_timeout(absolute_time_t t) {
+    nucleo_t *c = nucleo_atual();
+    if (!c->evento && !placa_atender_interrupcoes() && !time_reached(t)) {
+        placa_bloquear_ate(t);
+        placa_atender_interrupcoes();
+    }
+    c->evento = false;
+    return time_reached(t);
+}
+
+// --- Multicore ---
+
+void multicore_launch_core1(void (*entrada)(void)) {
+    nucleos[1].corrotina = escalonador_criar(entrada_nucleo1, (void *)entrada, pilha_nucleo1, sizeof(pilha_nucleo1));
+}
+
+bool multicore_fifo_rvalid(void) {
+    return nucleo_atual()->fifo_ocupados > 0;
+}
+
+bool multicore_fifo_wready(void) {
+    return nucleos[1 - get_core_num()].fifo_ocupados < SIO_FIFO_PROFUNDIDADE;
+}
+
+void multicore_fifo_push_blocking(uint32_t dado) {
+    while (!multicore_fifo_wready()) tight_loop_contents();
+    nucleo_t *destino = &nucleos[1 - get_core_num()];
+    destino->fifo[(destino->fifo_inicio + destino->fifo_ocupados++) % SIO_FIFO_PROFUNDIDADE] = dado;
+    __sev();
+}
+
+bool multicore_fifo_push_timeout_us(uint32_t dado, uint64_t timeout_us) {
+    absolute_time_t prazo = make_timeout_time_us(timeout_us);
+    while (!multicore_fifo_wready()) {
+        if (time_reached(prazo)) return false;
+        tight_loop_contents();
+    }
+    multicore_fifo_push_blocking(dado);
+    return true;
+}
+
+uint32_t multicore_fifo_pop_blocking(void) {
+    nucleo_t *c = nucleo_atual();
+    while (!c->fifo_ocupados) __wfe();
+    uint32_t dado = c->fifo[c->fifo_inicio];
+    c->fifo_inicio = (c->fifo_inicio + 1) % SIO_FIFO_PROFUNDIDADE;
+    c->fifo_ocupados--;
+    return dado;
+}
+
+bool multicore_fifo_pop_timeout_us(uint64_t timeout_us, uint32_t *dado) {
+    absolute_time_t prazo = make_timeout_time_us(timeout_us);
+    while (!multicore_fifo_rvalid()) {
+        if (best_effort_wfe_or_timeout(prazo)) return false;
+    }
+    *dado = multicore_fifo_pop_blocking();
+    return true;
+}
+
+void multicore_fifo_drain(void) {
+    nucleo_atual()->fifo_ocupados = 0;
+}
+
+// --- Fila ---
+
+void queue_init(queue_t *q, uint element_size, uint element_count) {
+    q->dados = calloc(element_count, element_size);
+    if (!q->dados) placa_panico("queue_init sem memoria", __FILE__, __LINE__);
+    q->tamanho_elemento = element_size;
+    q->capacidade = element_count;
+    q->inicio = 0;
+    q->ocupados = 0;
+}
+
+void queue_free(queue_t *q) {
+    free(q->dados);
+    q->dados = NULL;
+}
+
+uint queue_get_level(queue_t *q) {
+    return q->ocupados;
+}
+
+bool queue_is_empty(queue_t *q) {
+    return q->ocupados == 0;
+}
+
+bool queue_is_full(queue_t *q) {
+    return q->ocupados == q->capacidade;
+}
+
+bool queue_try_add(queue_t *q, const void *data) {
+    if (queue_is_full(q)) return false;
+    uint i = (q->inicio + q->ocupados) % q->capacidade;
+    memcpy(q->dados + (size_t)i * q->tamanho_elemento, data, q->tamanho_elemento);
+    q->ocupados++;
+    return true;
+}
+
+bool queue_try_peek(queue_t *q, void *data) {
+    if (queue_is_empty(q)) return false;
+    memcpy(data, q->dados + (size_t)q->inicio * q->tamanho_elemento, q->tamanho_elemento);
+    return true;
+}
+
+bool queue_try_remove(queue_t *q, void *data) {
+    if (!queue_try_peek(q, data)) return false;
+    q->inicio = (q->inicio + 1) % q->capacidade;
+    q->ocupados--;
+    return true;
+}
+
+void queue_add_blocking(queue_t *q, const void *data) {
+    while (!queue_try_add(q, data)) tight_loop_contents();
+}
+
+void queue_remove_blocking(queue_t *q, void *data) {
+    while (!queue_try_remove(q, data)) tight_loop_contents();
+}
+
+// --- Clocks ---
+
+uint32_t clock_get_hz(enum clock_index clock) {
+    switch (clock) {
+        case clk_ref: return RELOGIO_REFERENCIA_HZ;
+        case clk_usb:
+        case clk_adc: return RELOGIO_USB_ADC_HZ;
+        default: return clk_sys_khz * 1000u;
+    }
+}
+
+bool set_sys_clock_khz(uint32_t khz, bool obrigatorio) {
+    (void)obrigatorio;
+    clk_sys_khz = khz;
+    return true;
+}
+
+systick_hw_t *placa_systick(void) {
+    if (systick.csr & 1u) systick.cvr = (uint32_t)~contador_systick() & 0x00FFFFFFu; // Decrescente, 24 bits
+    return &systick;
+}
+
+uint64_t placa_systick_hz(void) {
+    static uint64_t hz;
+    if (!hz) {
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        uint64_t c0 = contador_systick();
+        do {
+            clock_gettime(CLOCK_MONOTONIC, &t1);
+        } while ((t1.tv_sec - t0.tv_sec) * 1000000000ll + (t1.tv_nsec - t0.tv_nsec) < 50000000ll);
+        uint64_t c1 = contador_systick();
+        int64_t ns = (t1.tv_sec - t0.tv_sec) * 1000000000ll + (t1.tv_nsec - t0.tv_nsec);
+        hz = (c1 - c0) * 1000000000ull / (uint64_t)ns;
+    }
+    return hz;
+}
+
+// --- Flash ---
+
+void flash_range_erase(uint32_t offset, size_t tamanho) {
+    hard_assert(offset % FLASH_SECTOR_SIZE == 0 && offset + tamanho <= PICO_FLASH_SIZE_BYTES);
+    memset(placa_flash + offset, 0xFF, tamanho);
+    placa_ocupar_us((uint64_t)FLASH_APAGAR_SETOR_US * ((tamanho + FLASH_SECTOR_SIZE - 1) / FLASH_SECTOR_SIZE));
+}
+
+void flash_range_program(uint32_t offset, const uint8_t *dados, size_t tamanho) {
+    hard_assert(offset % FLASH_PAGE_SIZE == 0 && offset + tamanho <= PICO_FLASH_SIZE_BYTES);
+    for (size_t i = 0; i < tamanho; i++) {
+        placa_flash[offset + i] &= dados[i]; // A gravação só leva bits de 1 a 0
+    }
+    placa_ocupar_us((uint64_t)FLASH_GRAVAR_PAGINA_US * ((tamanho + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE));
+}
+
+void pico_get_unique_board_id(pico_unique_board_id_t *id) {
+    for (int i = 0; i < PICO_UNIQUE_BOARD_ID_SIZE_BYTES; i++) {
+        id->id[i] = (uint8_t)(placa_cfg.numero_serie >> (8 * (PICO_UNIQUE_BOARD_ID_SIZE_BYTES - 1 - i)));
+    }
+}
+
+void pico_get_unique_board_id_string(char *destino, uint tamanho) {
+    snprintf(destino, tamanho, "%016llX", (unsigned long long)placa_cfg.numero_serie);
+}
+
+// --- Watchdog ---
+
+void watchdog_enable(uint32_t atraso_ms, bool pausa_depuracao) {
+    (void)pausa_depuracao;
+    watchdog.ligado = true;
+    watchdog.atraso_us = (uint64_t)atraso_ms * 1000;
+    watchdog.ultima_alimentacao = time_us_64();
+    if (!watchdog.agendado) {
+        watchdog.agendado = true;
+        escalonador_agendar(placa_para_escalonador(watchdog.ultima_alimentacao + watchdog.atraso_us),
+                            verificar_watchdog, NULL);
+    }
+}
+
+void watchdog_update(void) {
+    watchdog.ultima_alimentacao = time_us_64();
+}
+
+bool watchdog_caused_reboot(void) {
+    return false;
+}
+
+bool watchdog_enable_caused_reboot(void) {
+    return false;
+}
+
+void watchdog_reboot(uint32_t pc, uint32_t sp, uint32_t atraso_ms) {
+    (void)pc;
+    (void)sp;
+    (void)atraso_ms;
+    placa_panico("watchdog_reboot (reset nao simulado)", __FILE__, __LINE__);
+}
@@ -0,0 +1,481 @@
+/**
+ * @file simular_frota.c
+ * @brief Frota de placas simuladas em um só processo, contra um broker MQTT de verdade.
+ *
+ * Cada placa é uma cópia do módulo placa_frota (o firmware inteiro sobre o SDK simulado)
+ * carregada com dlopen, com o próprio estado estático, os dois núcleos e a própria sessão
+ * MQTT. Todas rodam no escalonador deste processo em relógio real, e o transporte de cada
+ * uma é um socket TCP até o broker. O ambiente de cada estufa é um passeio aleatório com
+ * semente fixa pelo índice; o horário do SNTP é o do host.
+ *
+ * Uso: simular_frota [--broker host[:porta]] [-n N] [--prefixo P] [--rampa s] [--duracao s]
+ *                    [--console] [id ...]
+ *
+ * Sem IDs na linha de comando, as placas se chamam <prefixo><n> (estufa_sim_0000, ...).
+ * As placas são ligadas aos poucos ao longo da rampa, para o broker não receber a frota
+ * inteira no mesmo instante. --console mostra a saída de todas, prefixada pelo ID.
+ */
+
+#define _GNU_SOURCE
+#include "escalonador.h"
+#include "placa.h"
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#define PORTA_PADRAO "1883"
+#define RELATORIO_US 10000000ull
+#define RECEPCAO_MAX 2048
+#define NUMERO_SERIE_BASE 0xE57F0A0000000000ull
+#define MQTT_TIPO_PUBLISH 3
+
+/**
+ * @brief Uma placa da frota: a cópia do módulo e a conexão TCP dela até o broker.
+ */
+typedef struct {
+    char id[64];
+    void (*ligar)(const placa_config_t *cfg);
+    placa_config_t cfg;
+    FILE *console;
+    bool inicio_linha;
+    // Passeio aleatório do ambiente
+    uint64_t semente;
+    uint64_t ultimo_passo_us;
+    double temp, umid, lux;
+    // Transporte
+    const placa_rede_eventos_t *eventos;
+    int fd;
+    bool conectando;
+    uint32_t sessao;            // Avisos agendados de conexões anteriores são descartados
+    uint8_t *saida;
+    size_t saida_tamanho, saida_capacidade;
+    // Contagem das publicações no fluxo de saída (cabeçalho fixo do MQTT)
+    size_t pacote_restante;
+    uint32_t pacote_comprimento, pacote_multiplicador;
+    bool lendo_comprimento, pacote_publish;
+    uint64_t publicadas;
+} placa_frota_t;
+
+typedef struct {
+    placa_frota_t *placa;
+    uint32_t sessao;
+} aviso_t;
+
+static struct sockaddr_storage broker;
+static socklen_t broker_tamanho;
+static uint64_t enviados_bytes, recebidos_bytes;
+
+// --- Funções Auxiliares ---
+
+static void uso(void) {
+    fprintf(stderr, "Uso: simular_frota [--broker host[:porta]] [-n N] [--prefixo P] [--rampa s] "
+                    "[--duracao s] [--console] [id ...]\n");
+    exit(2);
+}
+
+static bool resolver_broker(const char *endereco) {
+    char host[256];
+    snprintf(host, sizeof(host), "%s", endereco);
+    char *porta = strrchr(host, ':');
+    if (porta) *porta++ = '\0';
+    struct addrinfo dica = { .ai_family = AF_UNSPEC, .ai_socktype = SOCK_STREAM }, *r;
+    int erro = getaddrinfo(host, porta && *porta ? porta : PORTA_PADRAO, &dica, &r);
+    if (erro) {
+        fprintf(stderr, "[frota] broker %s: %s\n", endereco, gai_strerror(erro));
+        return false;
+    }
+    memcpy(&broker, r->ai_addr, r->ai_addrlen);
+    broker_tamanho = r->ai_addrlen;
+    freeaddrinfo(r);
+    return true;
+}
+
+/**
+ * @brief Carrega mais uma cópia do módulo. O dlopen devolve o mesmo módulo para o mesmo
+ * arquivo, então cada placa abre uma cópia própria, apagada assim que carregada.
+ */
+static void *carregar_modulo(const char *diretorio, const uint8_t *imagem, size_t tamanho, unsigned indice) {
+    char caminho[4096];
+    snprintf(caminho, sizeof(caminho), "%s/placa_%u.so", diretorio, indice);
+    FILE *f = fopen(caminho, "wb");
+    if (!f) return NULL;
+    bool escrito = fwrite(imagem, 1, tamanho, f) == tamanho;
+    void *modulo = NULL;
+    if (!fclose(f) && escrito) {
+        modulo = dlopen(caminho, RTLD_NOW | RTLD_LOCAL);
+        if (!modulo) fprintf(stderr, "[frota] %s\n", dlerror());
+    }
+    unlink(caminho);
+    return modulo;
+}
+
+static uint8_t *ler_arquivo(const char *caminho, size_t *tamanho) {
+    FILE *f = fopen(caminho, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    rewind(f);
+    uint8_t *dados = n > 0 ? malloc((size_t)n) : NULL;
+    if (dados && fread(dados, 1, (size_t)n, f) != (size_t)n) {
+        free(dados);
+        dados = NULL;
+    }
+    fclose(f);
+    *tamanho = (size_t)n;
+    return dados;
+}
+
+/**
+ * @brief O módulo fica ao lado do executável.
+ */
+static void caminho_modulo(char *caminho, size_t tamanho) {
+    ssize_t n = readlink("/proc/self/exe", caminho, tamanho - 1);
+    caminho[n > 0 ? n : 0] = '\0';
+    char *barra = strrchr(caminho, '/');
+    size_t base = barra ? (size_t)(barra - caminho) + 1 : 0;
+    snprintf(caminho + base, tamanho - base, "%s", MODULO_PLACA);
+}
+
+// --- Console ---
+
+static ssize_t console_escrever(void *ctx, const char *dados, size_t tamanho) {
+    placa_frota_t *p = ctx;
+    for (size_t i = 0; i < tamanho; i++) {
+        if (p->inicio_linha) printf("[%s] ", p->id);
+        putchar(dados[i]);
+        p->inicio_linha = dados[i] == '\n';
+    }
+    return (ssize_t)tamanho;
+}
+
+// --- Ambiente ---
+
+static double aleatorio_normal(placa_frota_t *p) {
+    // xorshift64* e Box-Muller
+    double u[2];
+    for (int i = 0; i < 2; i++) {
+        p->semente ^= p->semente >> 12;
+        p->semente ^= p->semente << 25;
+        p->semente ^= p->semente >> 27;
+        u[i] = ((double)((p->semente * 0x2545F4914F6CDD1Dull) >> 11) + 0.5) / 9007199254740992.0;
+    }
+    return sqrt(-2.0 * log(u[0])) * cos(2.0 * M_PI * u[1]);
+}
+
+static double limitar(double v, double min, double max) {
+    return v < min ? min : v > max ? max : v;
+}
+
+/**
+ * @brief Um passo do passeio por segundo de placa, como as leituras do simulador antigo.
+ */
+static void ambiente(void *ctx, uint64_t agora_us, uint8_t endereco, placa_ambiente_t *amb) {
+    (void)endereco;
+    placa_frota_t *p = ctx;
+    while (agora_us - p->ultimo_passo_us >= 1000000) {
+        p->ultimo_passo_us += 1000000;
+        p->temp = limitar(p->temp + 0.2 * aleatorio_normal(p), 5.0, 45.0);
+        p->umid = limitar(p->umid + 0.5 * aleatorio_normal(p), 10.0, 100.0);
+        p->lux = limitar(p->lux + 150.0 * aleatorio_normal(p), 0.0, 5000.0);
+    }
+    amb->temp_c100 = (int32_t)lround(p->temp * 100.0);
+    amb->umid_c100 = (int32_t)lround(p->umid * 100.0);
+    amb->luz_mlux = (uint32_t)lround(p->lux * 1000.0);
+}
+
+static uint64_t hora_utc_us(void *ctx, uint64_t agora_us) {
+    (void)ctx;
+    (void)agora_us;
+    struct timespec t;
+    clock_gettime(CLOCK_REALTIME, &t);
+    return (uint64_t)t.tv_sec * 1000000ull + (uint64_t)(t.tv_nsec / 1000);
+}
+
+// --- Transporte TCP ---
+
+/**
+ * @brief Conta os PUBLISH pelo cabeçalho fixo (tipo e comprimento restante).
+ */
+static void contar_pacotes(placa_frota_t *p, const uint8_t *dados, size_t tamanho) {
+    for (size_t i = 0; i < tamanho;) {
+        if (p->pacote_restante) {
+            size_t n = tamanho - i < p->pacote_restante ? tamanho - i : p->pacote_restante;
+            p->pacote_restante -= n;
+            i += n;
+        } else if (!p->lendo_comprimento) {
+            p->pacote_publish = dados[i++] >> 4 == MQTT_TIPO_PUBLISH;
+            p->lendo_comprimento = true;
+            p->pacote_comprimento = 0;
+            p->pacote_multiplicador = 1;
+        } else {
+            p->pacote_comprimento += (dados[i] & 0x7Fu) * p->pacote_multiplicador;
+            p->pacote_multiplicador *= 128;
+            if (!(dados[i++] & 0x80)) {
+                p->lendo_comprimento = false;
+                p->pacote_restante = p->pacote_comprimento;
+                if (p->pacote_publish) p->publicadas++;
+            }
+        }
+    }
+}
+
+static void socket_pronto(void *ctx, short revents);
+
+static void observar(placa_frota_t *p) {
+    escalonador_observar_fd(p->fd, (short)(POLLIN | (p->saida_tamanho ? POLLOUT : 0)), socket_pronto, p);
+}
+
+/**
+ * @brief Entrega ao kernel o que couber do buffer de saída.
+ * @return true se algum byte saiu.
+ */
+static bool escoar(placa_frota_t *p) {
+    size_t total = 0;
+    while (total < p->saida_tamanho) {
+        ssize_t n = send(p->fd, p->saida + total, p->saida_tamanho - total, MSG_NOSIGNAL);
+        if (n <= 0) break;
+        total += (size_t)n;
+    }
+    memmove(p->saida, p->saida + total, p->saida_tamanho - total);
+    p->saida_tamanho -= total;
+    enviados_bytes += total;
+    return total > 0;
+}
+
+static void encerrar_socket(placa_frota_t *p) {
+    if (p->fd >= 0) {
+        escalonador_esquecer_fd(p->fd);
+        close(p->fd);
+    }
+    p->fd = -1;
+    p->conectando = false;
+    p->saida_tamanho = 0;
+    p->sessao++;
+}
+
+static void socket_pronto(void *ctx, short revents) {
+    placa_frota_t *p = ctx;
+    if (p->conectando) {
+        int erro = 0;
+        socklen_t n = sizeof(erro);
+        getsockopt(p->fd, SOL_SOCKET, SO_ERROR, &erro, &n);
+        if (erro) {
+            encerrar_socket(p);
+            p->eventos->conectada(false);
+            return;
+        }
+        p->conectando = false;
+        observar(p);
+        p->eventos->conectada(true);
+        return;
+    }
+    if (revents & POLLIN) {
+        uint8_t buffer[RECEPCAO_MAX];
+        ssize_t n = recv(p->fd, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            recebidos_bytes += (uint64_t)n;
+            p->eventos->receber(buffer, (size_t)n);
+        } else if (n == 0 || (errno != EAGAIN && errno != EINTR)) {
+            encerrar_socket(p);
+            p->eventos->caiu();
+            return;
+        }
+    } else if (revents & (POLLERR | POLLHUP)) {
+        encerrar_socket(p);
+        p->eventos->caiu();
+        return;
+    }
+    if (revents & POLLOUT) {
+        if (escoar(p)) p->eventos->enviados();
+        observar(p);
+    }
+}
+
+static void avisar_enviados(void *ctx) {
+    aviso_t *a = ctx;
+    if (a->sessao == a->placa->sessao && a->placa->fd >= 0) a->placa->eventos->enviados();
+    free(a);
+}
+
+static bool transporte_abrir(void *ctx, const placa_rede_eventos_t *eventos) {
+    placa_frota_t *p = ctx;
+    encerrar_socket(p);
+    p->eventos = eventos;
+    p->pacote_restante = 0;
+    p->lendo_comprimento = false;
+    p->fd = socket(broker.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (p->fd < 0) return false;
+    int um = 1;
+    setsockopt(p->fd, IPPROTO_TCP, TCP_NODELAY, &um, sizeof(um)); // Como o LWIP com TCP_NODELAY
+    if (connect(p->fd, (struct sockaddr *)&broker, broker_tamanho) < 0 && errno != EINPROGRESS) {
+        encerrar_socket(p);
+        return false;
+    }
+    p->conectando = true;
+    escalonador_observar_fd(p->fd, POLLOUT, socket_pronto, p);
+    return true;
+}
+
+static void transporte_enviar(void *ctx, const uint8_t *dados, size_t tamanho) {
+    placa_frota_t *p = ctx;
+    if (p->fd < 0) return;
+    contar_pacotes(p, dados, tamanho);
+    if (p->saida_tamanho + tamanho > p->saida_capacidade) {
+        p->saida_capacidade = (p->saida_tamanho + tamanho) * 2;
+        p->saida = realloc(p->saida, p->saida_capacidade);
+        if (!p->saida) abort();
+    }
+    memcpy(p->saida + p->saida_tamanho, dados, tamanho);
+    p->saida_tamanho += tamanho;
+    if (p->conectando) return;
+    // Chamado dentro da corrotina da placa: o aviso de enviados sai em um evento.
+    if (escoar(p)) {
+        aviso_t *a = malloc(sizeof(aviso_t));
+        if (!a) abort();
+        *a = (aviso_t){ p, p->sessao };
+        escalonador_agendar(escalonador_agora_us(), avisar_enviados, a);
+    }
+    observar(p);
+}
+
+static void transporte_fechar(void *ctx) {
+    encerrar_socket(ctx);
+}
+
+static size_t transporte_pendentes(void *ctx) {
+    return ((placa_frota_t *)ctx)->saida_tamanho;
+}
+
+// --- Frota ---
+
+static void ligar_placa(void *ctx) {
+    placa_frota_t *p = ctx;
+    p->ligar(&p->cfg);
+}
+
+static void relatorio(placa_frota_t *frota, unsigned n, uint64_t agora_us, uint64_t janela_us,
+                      uint64_t *publicadas_antes) {
+    unsigned conectadas = 0;
+    uint64_t publicadas = 0;
+    for (unsigned i = 0; i < n; i++) {
+        conectadas += frota[i].fd >= 0 && !frota[i].conectando;
+        publicadas += frota[i].publicadas;
+    }
+    printf("[frota] %6.0f s conectadas=%u/%u publicadas=%llu taxa=%.1f msg/s enviados=%llu KiB recebidos=%llu KiB\n",
+           (double)agora_us / 1e6, conectadas, n, (unsigned long long)publicadas,
+           (double)(publicadas - *publicadas_antes) * 1e6 / (double)janela_us,
+           (unsigned long long)(enviados_bytes / 1024), (unsigned long long)(recebidos_bytes / 1024));
+    fflush(stdout);
+    *publicadas_antes = publicadas;
+}
+
+int main(int argc, char **argv) {
+    const char *endereco = "localhost:" PORTA_PADRAO;
+    const char *prefixo = "estufa_sim_";
+    unsigned n = 100;
+    double rampa_s = 10.0, duracao_s = 0.0;
+    bool console = false;
+    int primeiro_id = argc;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--broker") && i + 1 < argc) {
+            endereco = argv[++i];
+        } else if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            n = (unsigned)strtoul(argv[++i], NULL, 10);
+        } else if (!strcmp(argv[i], "--prefixo") && i + 1 < argc) {
+            prefixo = argv[++i];
+        } else if (!strcmp(argv[i], "--rampa") && i + 1 < argc) {
+            rampa_s = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--duracao") && i + 1 < argc) {
+            duracao_s = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--console")) {
+            console = true;
+        } else if (argv[i][0] == '-') {
+            uso();
+        } else {
+            primeiro_id = i;
+            break;
+        }
+    }
+    if (primeiro_id < argc) n = (unsigned)(argc - primeiro_id);
+    if (n == 0) uso();
+    if (!resolver_broker(endereco)) return 1;
+
+    char caminho[4096];
+    caminho_modulo(caminho, sizeof(caminho));
+    size_t tamanho_imagem;
+    uint8_t *imagem = ler_arquivo(caminho, &tamanho_imagem);
+    if (!imagem) {
+        fprintf(stderr, "[frota] modulo %s: %s\n", caminho, strerror(errno));
+        return 1;
+    }
+
+    char diretorio[] = "/tmp/frota.XXXXXX";
+    if (!mkdtemp(diretorio)) {
+        fprintf(stderr, "[frota] %s: %s\n", diretorio, strerror(errno));
+        return 1;
+    }
+
+    escalonador_iniciar(true);
+    placa_frota_t *frota = calloc(n, sizeof(placa_frota_t));
+    if (!frota) abort();
+    for (unsigned i = 0; i < n; i++) {
+        placa_frota_t *p = &frota[i];
+        if (primeiro_id < argc) {
+            snprintf(p->id, sizeof(p->id), "%s", argv[primeiro_id + (int)i]);
+        } else {
+            snprintf(p->id, sizeof(p->id), "%s%04u", prefixo, i);
+        }
+        void *modulo = carregar_modulo(diretorio, imagem, tamanho_imagem, i);
+        p->ligar = modulo ? (void (*)(const placa_config_t *))dlsym(modulo, "placa_ligar") : NULL;
+        if (!p->ligar) {
+            fprintf(stderr, "[frota] %s: modulo nao carregou\n", p->id);
+            rmdir(diretorio);
+            return 1;
+        }
+        p->fd = -1;
+        p->semente = 0x9E3779B97F4A7C15ull * (i + 1);
+        p->temp = 25.0;
+        p->umid = 60.0;
+        p->lux = 1500.0;
+        p->inicio_linha = true;
+        if (console) {
+            p->console = fopencookie(p, "w", (cookie_io_functions_t){ .write = console_escrever });
+            setvbuf(p->console, NULL, _IOLBF, 0);
+        }
+        p->cfg = (placa_config_t){
+            .device_id = p->id,
+            .numero_serie = NUMERO_SERIE_BASE + i + 1,
+            .transporte = { p, transporte_abrir, transporte_enviar, transporte_fechar, transporte_pendentes },
+            .atraso_wifi_ms = 1500,
+            .console = p->console,
+            .ctx = p,
+            .ambiente = ambiente,
+            .hora_utc_us = hora_utc_us,
+        };
+        escalonador_agendar((uint64_t)(rampa_s * 1e6 * i / n), ligar_placa, p);
+    }
+    free(imagem);
+    rmdir(diretorio);
+    printf("[frota] %u placas contra %s\n", n, endereco);
+
+    uint64_t fim = duracao_s > 0 ? (uint64_t)(duracao_s * 1e6) : ESCALONADOR_NUNCA;
+    uint64_t agora = 0, publicadas_antes = 0;
+    while (agora < fim) {
+        uint64_t anterior = agora;
+        agora = fim - agora > RELATORIO_US ? agora + RELATORIO_US : fim;
+        escalonador_executar_ate(agora);
+        relatorio(frota, n, agora, agora - anterior, &publicadas_antes);
+    }
+    return 0;
+}
@@ -0,0 +1,252 @@
+/**
+ * @file teste_latencia.c
+ * @brief Ensaio de latência de ponta a ponta: o firmware inteiro (Core 0 e Core 1) no host,
+ * conectado ao broker em processo, com luz e temperatura injetadas pelos sensores I2C.
+ *
+ * Cada ciclo de 60 s tem luz acima de LUZ_MAXIMA_ESTUFA nos primeiros 20 s (alarme) e um
+ * comando IRRIGAR aos 40 s. Medidas, todas no relógio virtual da placa:
+ *   sensor_envio: aquisição da amostra (mono_ms do JSON) até o PUBLISH chegar ao broker;
+ *   alarme:       primeira leitura do BH1750 acima do limiar até o alarme "ativo" no broker;
+ *   cmd_irrigar:  PUBLISH do comando no broker até o servo ser energizado (pino em PWM).
+ * Depois dos ciclos, INTERVALO=1 por 60 s mede a vazão e as amostras perdidas.
+ *
+ * O relatório JSON tem o formato lido por tools/verificar_latencia.py, que aplica o
+ * orçamento. Sai com 1 se a placa não conectou, se o watchdog estourou, se alguma amostra
+ * se perdeu ou se faltou alguma medida.
+ *
+ * Uso: teste_latencia [--ciclos N] [--saida arquivo.json] [--console]
+ */
+
+#include "broker.h"
+#include "escalonador.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEVICE_ID_ENSAIO "estufa_teste"
+#define LATENCIA_ENLACE_US 3000     // Cada sentido, placa até o broker
+#define ATRASO_WIFI_MS 1500
+#define CONEXAO_PRAZO_US 60000000ull
+#define CICLO_US 60000000ull
+#define LUZ_ALTA_US 20000000ull
+#define COMANDO_EM_US 40000000ull
+#define LUZ_ALTA_MLUX 3000000u      // Acima de LUZ_MAXIMA_ESTUFA (2000 lux)
+#define LUZ_BAIXA_MLUX 800000u
+#define TEMPERATURA_PERIODO_US 600000000.0
+#define VAZAO_JANELA_US 60000000ull
+#define VAZAO_ACOMODAR_US 5000000ull
+#define AMOSTRA_FALTA_MS 1500       // Buraco entre amostras com INTERVALO=1
+#define SERVO_PIN 2
+#define GPIO_FUNC_PWM 4
+#define BH1750_ENDERECO 0x23
+#define MEDIDAS_MAX 4096
+
+typedef struct {
+    const char *nome;
+    uint32_t us[MEDIDAS_MAX];
+    size_t n;
+} medida_t;
+
+typedef struct {
+    uint64_t inicio_ciclos;         // 0 até a placa estar pronta: luz baixa
+    uint32_t ciclos;
+    uint64_t luz_alta_desde;        // Primeira leitura acima do limiar ainda sem alarme
+    bool alarme_pendente;
+    uint64_t comando_publicado;     // 0: nenhum comando esperando o servo
+    medida_t sensor_envio, alarme, cmd_irrigar;
+    bool contando_vazao;
+    uint32_t publicacoes_janela;
+    uint32_t amostras_janela;
+    uint64_t ultima_amostra_ms;
+    uint32_t amostras_perdidas;
+} ensaio_t;
+
+// --- Funções Auxiliares ---
+
+static void registrar(medida_t *m, uint64_t duracao_us) {
+    if (m->n < MEDIDAS_MAX) m->us[m->n++] = duracao_us > UINT32_MAX ? UINT32_MAX : (uint32_t)duracao_us;
+}
+
+static bool luz_alta(const ensaio_t *e, uint64_t agora_us) {
+    return e->inicio_ciclos && agora_us >= e->inicio_ciclos && (agora_us - e->inicio_ciclos) % CICLO_US < LUZ_ALTA_US &&
+           agora_us - e->inicio_ciclos < (uint64_t)e->ciclos * CICLO_US;
+}
+
+static void ambiente(void *ctx, uint64_t agora_us, uint8_t endereco, placa_ambiente_t *amb) {
+    ensaio_t *e = ctx;
+    // Temperatura em senoide de 24 ± 4 °C com período de 10 min.
+    amb->temp_c100 = (int32_t)lround(2400 + 400 * sin(2 * M_PI * (double)agora_us / TEMPERATURA_PERIODO_US));
+    amb->umid_c100 = 7000; // Acima do alvo: nenhuma rega automática no meio do ensaio
+    amb->luz_mlux = luz_alta(e, agora_us) ? LUZ_ALTA_MLUX : LUZ_BAIXA_MLUX;
+    amb->solo_adc = 2048;
+    if (endereco == BH1750_ENDERECO && luz_alta(e, agora_us) && !e->alarme_pendente && !e->luz_alta_desde) {
+        e->luz_alta_desde = agora_us;
+    }
+}
+
+static void gpio_funcao(void *ctx, unsigned gpio, unsigned funcao, uint64_t agora_us) {
+    ensaio_t *e = ctx;
+    if (gpio == SERVO_PIN && funcao == GPIO_FUNC_PWM && e->comando_publicado) {
+        registrar(&e->cmd_irrigar, agora_us - e->comando_publicado);
+        e->comando_publicado = 0;
+    }
+}
+
+static void recebido(void *ctx, const char *topico, const char *payload, size_t tamanho) {
+    (void)tamanho;
+    ensaio_t *e = ctx;
+    uint64_t agora = placa_agora_us();
+    if (e->contando_vazao) e->publicacoes_janela++;
+    if (strcmp(topico, DEVICE_ID_ENSAIO "/sensores/amostra") == 0) {
+        const char *campo = strstr(payload, "\"mono_ms\":");
+        if (!campo) return;
+        uint64_t mono_ms = strtoull(campo + strlen("\"mono_ms\":"), NULL, 10);
+        registrar(&e->sensor_envio, agora - mono_ms * 1000);
+        if (e->contando_vazao) {
+            if (e->amostras_janela && mono_ms - e->ultima_amostra_ms > AMOSTRA_FALTA_MS) {
+                e->amostras_perdidas += (uint32_t)((mono_ms - e->ultima_amostra_ms + 500) / 1000 - 1);
+            }
+            e->amostras_janela++;
+            e->ultima_amostra_ms = mono_ms;
+        }
+    } else if (strcmp(topico, DEVICE_ID_ENSAIO "/alarme") == 0 && strstr(payload, "\"ativo\"")) {
+        if (e->luz_alta_desde) registrar(&e->alarme, agora - e->luz_alta_desde);
+        e->luz_alta_desde = 0;
+        e->alarme_pendente = true;
+    } else if (strcmp(topico, DEVICE_ID_ENSAIO "/alarme") == 0) {
+        e->alarme_pendente = false;
+    }
+}
+
+static int comparar_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void escrever_medida(FILE *f, const medida_t *m) {
+    uint32_t ordenadas[MEDIDAS_MAX];
+    memcpy(ordenadas, m->us, m->n * sizeof(uint32_t));
+    qsort(ordenadas, m->n, sizeof(uint32_t), comparar_u32);
+    // Percentis pelo posto mais próximo.
+    double p50 = m->n ? ordenadas[(m->n * 50 + 99) / 100 - 1] / 1000.0 : 0;
+    double p99 = m->n ? ordenadas[(m->n * 99 + 99) / 100 - 1] / 1000.0 : 0;
+    double max = m->n ? ordenadas[m->n - 1] / 1000.0 : 0;
+    fprintf(f, "\"%s\":{\"n\":%zu,\"p50\":%.1f,\"p99\":%.1f,\"max\":%.1f}", m->nome, m->n, p50, p99, max);
+}
+
+static void escrever_relatorio(FILE *f, const ensaio_t *e, double pub_s) {
+    fputc('{', f);
+    escrever_medida(f, &e->sensor_envio);
+    fputc(',', f);
+    escrever_medida(f, &e->alarme);
+    fputc(',', f);
+    escrever_medida(f, &e->cmd_irrigar);
+    fprintf(f, ",\"pub_s\":%.2f,\"ciclos\":%u,\"amostras_perdidas\":%u,\"estouros_watchdog\":%u}\n",
+            pub_s, e->ciclos, e->amostras_perdidas, placa_estouros_watchdog());
+}
+
+static void publicar_comando(broker_t *b, const char *comando) {
+    if (!broker_publicar(b, DEVICE_ID_ENSAIO "/comando/estado", comando)) {
+        fprintf(stderr, "teste_latencia: placa sem sessao ao publicar %s\n", comando);
+    }
+}
+
+// --- Ensaio ---
+
+int main(int argc, char **argv) {
+    static ensaio_t e = {
+        .ciclos = 10,
+        .sensor_envio.nome = "sensor_envio",
+        .alarme.nome = "alarme",
+        .cmd_irrigar.nome = "cmd_irrigar",
+    };
+    const char *saida = NULL;
+    bool console = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--ciclos") == 0 && i + 1 < argc) {
+            e.ciclos = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--saida") == 0 && i + 1 < argc) {
+            saida = argv[++i];
+        } else if (strcmp(argv[i], "--console") == 0) {
+            console = true;
+        } else {
+            fprintf(stderr, "uso: %s [--ciclos N] [--saida arquivo.json] [--console]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    escalonador_iniciar(false);
+    broker_t *broker = broker_criar(LATENCIA_ENLACE_US, recebido, &e);
+    placa_config_t cfg = {
+        .device_id = DEVICE_ID_ENSAIO,
+        .numero_serie = 0xE57F0A0000000001ull,
+        .transporte = broker_transporte(broker),
+        .atraso_wifi_ms = ATRASO_WIFI_MS,
+        .console = console ? stdout : NULL,
+        .ctx = &e,
+        .ambiente = ambiente,
+        .gpio_funcao = gpio_funcao,
+    };
+    placa_ligar(&cfg);
+    // A placa é ligada no instante 0 do escalonador: os dois relógios coincidem.
+
+    uint64_t t = 0;
+    while (!broker_placa_pronta(broker)) {
+        if (t >= CONEXAO_PRAZO_US) {
+            fprintf(stderr, "teste_latencia: a placa nao conectou ao broker em %llu s\n",
+                    (unsigned long long)(CONEXAO_PRAZO_US / 1000000));
+            return 1;
+        }
+        t += 100000;
+        escalonador_executar_ate(t);
+    }
+
+    e.inicio_ciclos = (t / 1000000 + 2) * 1000000;
+    for (uint32_t c = 0; c < e.ciclos; c++) {
+        uint64_t inicio = e.inicio_ciclos + (uint64_t)c * CICLO_US;
+        escalonador_executar_ate(inicio + COMANDO_EM_US);
+        if (e.comando_publicado) fprintf(stderr, "teste_latencia: o servo nao armou no ciclo %u\n", c);
+        e.comando_publicado = placa_agora_us();
+        publicar_comando(broker, "IRRIGAR");
+        escalonador_executar_ate(inicio + CICLO_US);
+    }
+    e.comando_publicado = 0;
+
+    uint64_t vazao_inicio = e.inicio_ciclos + (uint64_t)e.ciclos * CICLO_US;
+    publicar_comando(broker, "INTERVALO=1");
+    escalonador_executar_ate(vazao_inicio + VAZAO_ACOMODAR_US);
+    e.contando_vazao = true;
+    escalonador_executar_ate(vazao_inicio + VAZAO_ACOMODAR_US + VAZAO_JANELA_US);
+    e.contando_vazao = false;
+    double pub_s = e.publicacoes_janela / (VAZAO_JANELA_US / 1e6);
+    publicar_comando(broker, "INTERVALO=10");
+    escalonador_executar_ate(placa_agora_us() + VAZAO_ACOMODAR_US);
+
+    escrever_relatorio(stdout, &e, pub_s);
+    if (saida) {
+        FILE *f = fopen(saida, "w");
+        if (!f) {
+            perror(saida);
+            return 1;
+        }
+        escrever_relatorio(f, &e, pub_s);
+        fclose(f);
+    }
+
+    int falhas = 0;
+    if (placa_estouros_watchdog()) {
+        fprintf(stderr, "FALHA: %u estouro(s) do watchdog\n", placa_estouros_watchdog());
+        falhas++;
+    }
+    if (e.amostras_perdidas || !e.amostras_janela) {
+        fprintf(stderr, "FALHA: %u amostra(s) perdida(s) com INTERVALO=1 (%u recebidas)\n", e.amostras_perdidas,
+                e.amostras_janela);
+        falhas++;
+    }
+    if (e.alarme.n < e.ciclos || e.cmd_irrigar.n < e.ciclos || !e.sensor_envio.n) {
+        fprintf(stderr, "FALHA: medidas faltando (alarme %zu, cmd_irrigar %zu de %u ciclos; sensor_envio %zu)\n",
+                e.alarme.n, e.cmd_irrigar.n, e.ciclos, e.sensor_envio.n);
+        falhas++;
+    }
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file teste_relogio.c
+ * @brief Teste do modelo do relógio SNTP (relogio.c) no relógio virtual do host.
+ *
+ * Um servidor simulado anda com a deriva escolhida em relação ao tempo monotônico da
+ * placa, e cada sincronização entrega o horário dele a relogio_sntp_recebido(), como o
+ * LWIP faria. Confere o deslocamento inicial, a deriva suavizada em 0,25 só com intervalos
+ * de ao menos RELOGIO_INTERVALO_MIN_DERIVA_S, o limite de ±RELOGIO_DERIVA_MAX_PPM e que a
+ * conversão preserva a ordem das amostras com a deriva nos dois extremos.
+ *
+ * Uso: teste_relogio
+ */
+
+#include "escalonador.h"
+#include "relogio.h"
+#include <math.h>
+#include <stdio.h>
+
+#define EPOCH_INICIAL_US 1767225600123456ull // 2026-01-01 00:00:00.123456 UTC
+#define TOLERANCIA_PPM 0.01f
+
+static uint64_t mono_us;      // Tempo da placa (time_us_64)
+static uint64_t servidor_us;  // Horário do servidor simulado
+static int falhas;
+
+#define CHECAR(condicao, ...)                                              \
+    do {                                                                   \
+        if (!(condicao)) {                                                 \
+            fprintf(stderr, "FALHA %s:%d: ", __FILE__, __LINE__);          \
+            fprintf(stderr, __VA_ARGS__);                                  \
+            fputc('\n', stderr);                                           \
+            falhas++;                                                      \
+        }                                                                  \
+    } while (0)
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Avança a placa; o servidor avança o mesmo intervalo mais a deriva do cristal local.
+ */
+static void avancar(uint64_t intervalo_us, double deriva_ppm) {
+    mono_us += intervalo_us;
+    servidor_us += intervalo_us + (uint64_t)llround((double)intervalo_us * deriva_ppm * 1e-6);
+    escalonador_executar_ate(mono_us);
+}
+
+static void sincronizar(void) {
+    relogio_sntp_recebido((uint32_t)(servidor_us / 1000000), (uint32_t)(servidor_us % 1000000));
+}
+
+static void checar_deriva(float esperada) {
+    CHECAR(fabsf(relogio_deriva_ppm() - esperada) < TOLERANCIA_PPM, "deriva %.4f ppm, esperada %.4f ppm",
+           relogio_deriva_ppm(), esperada);
+}
+
+/**
+ * @brief A conversão não pode inverter a ordem de duas amostras, antes ou depois da base.
+ */
+static void checar_monotonia(void) {
+    uint64_t anterior = 0;
+    for (int64_t d = -20000000; d <= 20000000; d += 997) {
+        uint64_t ms = relogio_epoch_ms(mono_us + d);
+        CHECAR(ms >= anterior, "epoch_ms voltou de %llu para %llu em %+lld us (deriva %.1f ppm)",
+               (unsigned long long)anterior, (unsigned long long)ms, (long long)d, relogio_deriva_ppm());
+        if (ms < anterior) return;
+        anterior = ms;
+    }
+}
+
+// --- Casos ---
+
+static void caso_deslocamento(void) {
+    CHECAR(!relogio_sincronizado() && relogio_epoch_ms(mono_us) == 0, "horario antes da primeira sincronizacao");
+    uint64_t amostra_antes = mono_us - 4000000; // Colhida 4 s antes da sincronização
+    sincronizar();
+    CHECAR(relogio_sincronizado(), "nao sincronizou");
+    CHECAR(relogio_epoch_ms(mono_us) == EPOCH_INICIAL_US / 1000, "epoch %llu na base",
+           (unsigned long long)relogio_epoch_ms(mono_us));
+    CHECAR(relogio_epoch_ms(mono_us + 2500000) == EPOCH_INICIAL_US / 1000 + 2500, "epoch %llu 2,5 s depois",
+           (unsigned long long)relogio_epoch_ms(mono_us + 2500000));
+    CHECAR(relogio_epoch_ms(amostra_antes) == EPOCH_INICIAL_US / 1000 - 4000, "amostra anterior: epoch %llu",
+           (unsigned long long)relogio_epoch_ms(amostra_antes));
+    checar_deriva(0.0f);
+}
+
+static void caso_intervalo_curto(void) {
+    // Abaixo do intervalo mínimo a deriva não muda, mas a base segue o servidor.
+    avancar((RELOGIO_INTERVALO_MIN_DERIVA_S - 1) * 1000000ull, 200.0);
+    sincronizar();
+    checar_deriva(0.0f);
+    CHECAR(relogio_epoch_ms(mono_us) == servidor_us / 1000, "base nao acompanhou o servidor");
+}
+
+static void caso_suavizacao(void) {
+    // Cada medida de 100 ppm move a estimativa 1/4 do caminho.
+    float esperada = 0.0f;
+    for (int i = 0; i < 3; i++) {
+        avancar(RELOGIO_INTERVALO_MIN_DERIVA_S * 1000000ull, 100.0);
+        sincronizar();
+        esperada += 0.25f * (100.0f - esperada);
+        checar_deriva(esperada);
+    }
+    // A conversão aplica a deriva estimada ao intervalo desde a base.
+    uint64_t depois = mono_us + 1000000000ull; // 1000 s
+    uint64_t previsto = (servidor_us + 1000000000ull + (uint64_t)llroundf(1000000000.0f * esperada * 1e-6f)) / 1000;
+    uint64_t obtido = relogio_epoch_ms(depois);
+    CHECAR(obtido + 1 >= previsto && obtido <= previsto + 1, "epoch %llu ms, previsto %llu ms",
+           (unsigned long long)obtido, (unsigned long long)previsto);
+    checar_monotonia();
+}
+
+static void caso_limite(double deriva_ppm, float limite) {
+    for (int i = 0; i < 20; i++) {
+        avancar(10 * RELOGIO_INTERVALO_MIN_DERIVA_S * 1000000ull, deriva_ppm);
+        sincronizar();
+        CHECAR(fabsf(relogio_deriva_ppm()) <= RELOGIO_DERIVA_MAX_PPM, "deriva %.1f ppm fora do limite",
+               relogio_deriva_ppm());
+    }
+    checar_deriva(limite);
+    checar_monotonia();
+}
+
+int main(void) {
+    escalonador_iniciar(false);
+    mono_us = 5000000; // Primeira resposta 5 s após o boot
+    servidor_us = EPOCH_INICIAL_US;
+    escalonador_executar_ate(mono_us);
+
+    caso_deslocamento();
+    caso_intervalo_curto();
+    caso_suavizacao();
+    caso_limite(2000.0, RELOGIO_DERIVA_MAX_PPM);
+    caso_limite(-2000.0, -RELOGIO_DERIVA_MAX_PPM);
+
+    if (falhas) {
+        fprintf(stderr, "%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("relogio: OK\n");
+    return 0;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file irrigacao_auto.c
+ * @brief Implementação do controlador automático de irrigação (PI com anti-windup).
+ *
+ * A saída do controlador é a duração da rega: duracao = Kp * erro + Ki * integral(erro).
+ * O cálculo é feito em ponto fixo (erro em centésimos de %, integral em centésimos
+ * de %·s, saída em ms), com produtos intermediários em 64 bits. Como a resposta da
+ * umidade à rega é lenta, após cada irrigação o controlador fica bloqueado por
+ * IRRIGACAO_BLOQUEIO_S e o integrador é zerado.
+ */
+
+#include "irrigacao_auto.h"
+#include "configura_geral.h"
+#include "configuracao.h"
+#include "reproducao.h"
+#include <stdio.h>
+#include <string.h>
+
+// --- Definições Internas ---
+#define DURACAO_MAX_MS ((int64_t)IRRIGACAO_DURACAO_MAX_S * 1000)
+// Integral que, sozinha, satura a saída: MAX_MS / (KI_US / 1000) %·s, em centésimos.
+#define INTEGRAL_MAX_C100 ((int32_t)(DURACAO_MAX_MS * 100000 / IRRIGACAO_KI_US))
+
+// --- Estado Interno ---
+static int32_t integral;               // Integral do erro (centésimos de %·s)
+static int32_t umidade_ar_alvo = IRRIGACAO_UMIDADE_AR_ALVO * 100;
+static absolute_time_t ultima_avaliacao;
+static bool avaliou_alguma_vez;
+static absolute_time_t ultima_irrigacao;
+static bool irrigou_alguma_vez;
+
+static irrigacao_decisao_t historico[IRRIGACAO_AUTO_HISTORICO_TAM];
+static uint8_t historico_proximo;
+static uint32_t total_decisoes;
+
+static const char *const nomes_decisao[] = { "aguardar", "irrigar", "bloqueado" };
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Saída PI em ms: Kp[ms/%] * erro[c100] / 100 + Ki[µs/%·s] * integral[c100·s] / 100000.
+ */
+static int64_t saida_ms(int32_t erro_c100, int32_t integral_c100) {
+    return ((int64_t)IRRIGACAO_KP_MS * erro_c100) / 100 +
+           ((int64_t)IRRIGACAO_KI_US * integral_c100) / 100000;
+}
+
+/**
+ * @brief Imprime um valor em centésimos com uma casa decimal.
+ */
+static void imprimir_c100(int32_t v) {
+    if (v < 0) { putchar('-'); v = -v; }
+    printf("%ld.%ld", (long)(v / 100), (long)(v % 100 / 10));
+}
+
+/**
+ * @brief Guarda a decisão no histórico circular e a imprime via stdio.
+ */
+static void registrar_decisao(const irrigacao_decisao_t *d) {
+    historico[historico_proximo] = *d;
+    historico_proximo = (historico_proximo + 1) % IRRIGACAO_AUTO_HISTORICO_TAM;
+    total_decisoes++;
+    printf("[irrigacao] %s: %s=", nomes_decisao[d->decisao], d->fonte == FONTE_UMIDADE_SOLO ? "solo" : "ar");
+    imprimir_c100(d->medida);
+    printf("%% erro=");
+    imprimir_c100(d->erro);
+    printf(" int=%ld dur=%us\n", (long)(d->integral / 100), d->duracao_s);
+}
+
+// --- Implementação das Funções Públicas ---
+
+void irrigacao_auto_init(void) {
+    integral = 0;
+    avaliou_alguma_vez = false;
+    irrigou_alguma_vez = false;
+    historico_proximo = 0;
+    total_decisoes = 0;
+    memset(historico, 0, sizeof(historico));
+}
+
+uint16_t irrigacao_auto_avaliar(int32_t umidade_ar_c100, int32_t umidade_solo_c100) {
+    absolute_time_t agora = estufa_agora();
+    irrigacao_decisao_t d = { .tempo_us = to_us_since_boot(agora) };
+
+    // A sonda de solo, quando presente, descreve melhor a necessidade da planta.
+    if (umidade_solo_c100 >= 0) {
+        d.fonte = FONTE_UMIDADE_SOLO;
+        d.medida = umidade_solo_c100;
+        d.erro = IRRIGACAO_UMIDADE_SOLO_ALVO * 100 - umidade_solo_c100;
+    } else {
+        d.fonte = FONTE_UMIDADE_AR;
+        d.medida = umidade_ar_c100;
+        d.erro = umidade_ar_alvo - umidade_ar_c100;
+    }
+
+    // O controlador só é avaliado em MODO_ESTUFA_OK: as horas passadas em alerta ou irrigando
+    // não são tempo de integração. O passo fica limitado a um período de amostragem.
+    int64_t dt_ms = avaliou_alguma_vez ? absolute_time_diff_us(ultima_avaliacao, agora) / 1000 : 0;
+    int64_t dt_max_ms = (int64_t)configuracao()->intervalo_leitura_s * 1000;
+    if (dt_ms > dt_max_ms) dt_ms = dt_max_ms;
+    ultima_avaliacao = agora;
+    avaliou_alguma_vez = true;
+
+    // Bloqueio: dá tempo à água de chegar ao sensor. O integrador fica congelado
+    // para não acumular um erro que a rega anterior ainda vai corrigir.
+    if (irrigou_alguma_vez &&
+        absolute_time_diff_us(ultima_irrigacao, agora) < (int64_t)IRRIGACAO_BLOQUEIO_S * 1000000) {
+        d.decisao = DECISAO_BLOQUEADO;
+        d.integral = integral;
+        registrar_decisao(&d);
+        return 0;
+    }
+
+    // Dentro da banda morta a umidade está adequada: nada a fazer.
+    if (d.erro <= IRRIGACAO_BANDA_MORTA_C100) {
+        if (integral > 0 && d.erro < 0) integral = 0; // Umidade acima do alvo descarrega o integrador
+        d.decisao = DECISAO_AGUARDAR;
+        d.integral = integral;
+        registrar_decisao(&d);
+        return 0;
+    }
+
+    // Anti-windup por integração condicional: só integra se a saída não estiver
+    // saturada no máximo; além disso o integrador é limitado ao que sozinho saturaria.
+    int64_t saida = saida_ms(d.erro, integral);
+    if (saida < DURACAO_MAX_MS) {
+        int64_t nova = integral + (int64_t)d.erro * dt_ms / 1000;
+        if (nova > INTEGRAL_MAX_C100) nova = INTEGRAL_MAX_C100;
+        integral = (int32_t)nova;
+        saida = saida_ms(d.erro, integral);
+    }
+    if (saida > DURACAO_MAX_MS) saida = DURACAO_MAX_MS;
+    d.integral = integral;
+
+    if (saida < (int64_t)IRRIGACAO_DURACAO_MIN_S * 1000) {
+        d.decisao = DECISAO_AGUARDAR;
+        registrar_decisao(&d);
+        return 0;
+    }
+
+    d.decisao = DECISAO_IRRIGAR;
+    d.duracao_s = (uint16_t)((saida + 500) / 1000);
+    registrar_decisao(&d);
+    return d.duracao_s;
+}
+
+void irrigacao_auto_definir_alvo(int32_t alvo_c100) {
+    umidade_ar_alvo = alvo_c100;
+    integral = 0; // O erro acumulado se referia ao alvo anterior
+}
+
+void irrigacao_auto_registrar_irrigacao(void) {
+    ultima_irrigacao = estufa_agora();
+    irrigou_alguma_vez = true;
+    integral = 0;
+}
+
+const irrigacao_decisao_t *irrigacao_auto_ultima_decisao(void) {
+    if (total_decisoes == 0) return NULL;
+    return &historico[(historico_proximo + IRRIGACAO_AUTO_HISTORICO_TAM - 1) % IRRIGACAO_AUTO_HISTORICO_TAM];
+}
@@ -0,0 +1,78 @@
+/**
+ * @file irrigacao_auto.h
+ * @brief Controlador automático de irrigação em malha fechada.
+ * Decide quando e por quanto tempo irrigar a partir da umidade medida, usando uma
+ * política PI com banda morta, anti-windup e período de bloqueio entre regas.
+ * Toda a aritmética é inteira: umidades em centésimos de % e tempos em ms.
+ */
+
+#ifndef IRRIGACAO_AUTO_H
+#define IRRIGACAO_AUTO_H
+
+#include "pico/stdlib.h" // Para tipos básicos e absolute_time_t
+
+#define IRRIGACAO_AUTO_HISTORICO_TAM 8 // Decisões mantidas em memória para diagnóstico
+
+/**
+ * @brief Resultado de uma avaliação do controlador.
+ */
+enum DecisaoIrrigacao {
+    DECISAO_AGUARDAR,  ///< Umidade dentro da banda morta ou abaixo da duração mínima.
+    DECISAO_IRRIGAR,   ///< Irrigação recomendada pela duração calculada.
+    DECISAO_BLOQUEADO  ///< Dentro do período de bloqueio após a última irrigação.
+};
+
+/**
+ * @brief Origem da medida usada na decisão.
+ */
+enum FonteUmidade {
+    FONTE_UMIDADE_AR,  ///< Umidade relativa do AHT10.
+    FONTE_UMIDADE_SOLO ///< Sonda de umidade do solo (tem prioridade quando presente).
+};
+
+/**
+ * @struct irrigacao_decisao_t
+ * @brief Registro de uma decisão do controlador.
+ */
+typedef struct {
+    uint64_t tempo_us;   ///< Instante da avaliação (µs desde o boot).
+    int32_t medida;      ///< Umidade usada na decisão (centésimos de %).
+    int32_t erro;        ///< Alvo - medida (centésimos de %).
+    int32_t integral;    ///< Estado do integrador após a avaliação (centésimos de %·s).
+    uint16_t duracao_s;  ///< Duração de rega recomendada (0 se não irrigar).
+    uint8_t decisao;     ///< Valor de enum DecisaoIrrigacao.
+    uint8_t fonte;       ///< Valor de enum FonteUmidade.
+} irrigacao_decisao_t;
+
+/**
+ * @brief Inicializa o controlador com os parâmetros de configura_geral.h e zera o integrador.
+ */
+void irrigacao_auto_init(void);
+
+/**
+ * @brief Avalia a necessidade de irrigação. Deve ser chamada a cada nova leitura dos sensores.
+ * Cada avaliação é registrada no histórico e impressa via stdio.
+ * @param umidade_ar_c100 Umidade relativa do ar em centésimos de %.
+ * @param umidade_solo_c100 Umidade do solo em centésimos de %, ou valor negativo se não houver sonda.
+ * @return Duração de rega recomendada em segundos, ou 0 se não deve irrigar agora.
+ */
+uint16_t irrigacao_auto_avaliar(int32_t umidade_ar_c100, int32_t umidade_solo_c100);
+
+/**
+ * @brief Altera o alvo de umidade relativa do ar (ajuste remoto).
+ * @param alvo_c100 Novo alvo em centésimos de %.
+ */
+void irrigacao_auto_definir_alvo(int32_t alvo_c100);
+
+/**
+ * @brief Informa ao controlador que uma irrigação começou (automática ou manual).
+ * Zera o integrador e inicia o período de bloqueio.
+ */
+void irrigacao_auto_registrar_irrigacao(void);
+
+/**
+ * @brief Retorna a decisão mais recente, ou NULL se nenhuma avaliação foi feita.
+ */
+const irrigacao_decisao_t *irrigacao_auto_ultima_decisao(void);
+
+#endif // IRRIGACAO_AUTO_H
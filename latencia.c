@@ -0,0 +1,113 @@
+/**
+ * @file latencia.c
+ * @brief Implementação das medidas de latência de ponta a ponta.
+ */
+
+#include "latencia.h"
+#include "formato.h"
+#include "mqtt_lwip.h"
+#include "na_ram.h"
+#include "hardware/sync.h"
+
+/**
+ * @struct estatistica_latencia_t
+ * @brief Estatísticas acumuladas de uma medida desde o boot.
+ */
+typedef struct {
+    uint32_t contagem;
+    uint32_t max_us;
+    uint32_t faixas[LATENCIA_NUM_FAIXAS]; ///< faixas[k] conta medições em [2^(k-1), 2^k) µs
+} estatistica_latencia_t;
+
+static estatistica_latencia_t estatisticas[NUM_MEDIDAS_LATENCIA];
+static volatile uint32_t marcas[NUM_MEDIDAS_LATENCIA];
+static volatile bool marca_ativa[NUM_MEDIDAS_LATENCIA];
+
+static const char *const nomes_medida[NUM_MEDIDAS_LATENCIA] = {
+    [LAT_SENSOR_ENVIO] = "sensor_envio",
+    [LAT_ALARME] = "alarme",
+    [LAT_COMANDO_IRRIGAR] = "cmd_irrigar",
+};
+
+// --- Funções Auxiliares ---
+
+static inline uint8_t faixa_de(uint32_t duracao_us) {
+    uint8_t k = duracao_us ? (uint8_t)(32 - __builtin_clz(duracao_us)) : 0;
+    return k < LATENCIA_NUM_FAIXAS ? k : LATENCIA_NUM_FAIXAS - 1;
+}
+
+/**
+ * @brief Estima um percentil pelo limite superior da faixa que o contém (como em perfil.c).
+ * @param permil Percentil em milésimos (ex: 990 para p99).
+ */
+static uint32_t percentil_us(const estatistica_latencia_t *e, uint32_t permil) {
+    uint32_t alvo = (uint32_t)(((uint64_t)e->contagem * permil + 999) / 1000);
+    uint32_t acumulado = 0;
+    for (uint8_t k = 0; k < LATENCIA_NUM_FAIXAS; k++) {
+        acumulado += e->faixas[k];
+        if (acumulado >= alvo) {
+            uint32_t limite = k ? (1u << k) - 1 : 0;
+            return limite < e->max_us ? limite : e->max_us;
+        }
+    }
+    return e->max_us;
+}
+
+// --- Implementação das Funções Públicas ---
+
+void NA_RAM(latencia_registrar)(uint8_t medida, uint32_t inicio_us) {
+    uint32_t duracao = time_us_32() - inicio_us;
+    estatistica_latencia_t *e = &estatisticas[medida];
+    e->contagem++;
+    if (duracao > e->max_us) e->max_us = duracao;
+    e->faixas[faixa_de(duracao)]++;
+}
+
+void latencia_marcar(uint8_t medida, uint32_t inicio_us) {
+    marcas[medida] = inicio_us;
+    __mem_fence_release();
+    marca_ativa[medida] = true;
+}
+
+void NA_RAM(latencia_concluir)(uint8_t medida) {
+    if (!marca_ativa[medida]) return;
+    __mem_fence_acquire();
+    uint32_t inicio = marcas[medida];
+    marca_ativa[medida] = false;
+    // Uma marca velha é de um pedido que não resultou em ação (ex: IRRIGAR recusado pelo modo atual).
+    if (time_us_32() - inicio > LATENCIA_VALIDADE_MARCA_US) return;
+    latencia_registrar(medida, inicio);
+}
+
+int latencia_formatar(char *destino, size_t tamanho) {
+    static uint32_t ultimo_relatorio_us, ultimas_publicadas;
+    uint32_t agora = time_us_32();
+    uint32_t janela_ms = (agora - ultimo_relatorio_us) / 1000;
+    uint32_t publicadas = mqtt_contadores()->publicadas;
+    // Vazão em décimos de mensagem por segundo.
+    uint32_t vazao_d10 = janela_ms ? (uint32_t)((uint64_t)(publicadas - ultimas_publicadas) * 10000 / janela_ms) : 0;
+    ultimo_relatorio_us = agora;
+    ultimas_publicadas = publicadas;
+
+    formato_t f;
+    formato_iniciar(&f, destino, tamanho);
+    formato_caractere(&f, '{');
+    for (uint8_t m = 0; m < NUM_MEDIDAS_LATENCIA; m++) {
+        const estatistica_latencia_t *e = &estatisticas[m];
+        formato_caractere(&f, '"');
+        formato_texto(&f, nomes_medida[m]);
+        formato_texto(&f, "\":{\"n\":");
+        formato_uint(&f, e->contagem);
+        formato_texto(&f, ",\"p50\":");
+        formato_decimal(&f, (int32_t)(percentil_us(e, 500) / 100), 1);
+        formato_texto(&f, ",\"p99\":");
+        formato_decimal(&f, (int32_t)(percentil_us(e, 990) / 100), 1);
+        formato_texto(&f, ",\"max\":");
+        formato_decimal(&f, (int32_t)(e->max_us / 100), 1);
+        formato_texto(&f, "},");
+    }
+    formato_texto(&f, "\"pub_s\":");
+    formato_decimal(&f, (int32_t)vazao_d10, 1);
+    formato_caractere(&f, '}');
+    return (int)formato_tamanho(&f);
+}
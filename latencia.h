@@ -0,0 +1,54 @@
+/**
+ * @file latencia.h
+ * @brief Latências de ponta a ponta medidas no próprio dispositivo.
+ * Cada medida tem um início e um fim, possivelmente em núcleos diferentes: o início é
+ * marcado com latencia_marcar() (ou passado direto a latencia_registrar()) e o fim,
+ * com latencia_concluir(). As durações vão para um histograma logarítmico por medida,
+ * escrito sempre pelo núcleo que conclui a medida.
+ */
+
+#ifndef LATENCIA_H
+#define LATENCIA_H
+
+#include "pico/stdlib.h" // Para tipos básicos e time_us_32
+#include <stddef.h>
+
+#define LATENCIA_NUM_FAIXAS 26          // [0], [1], [2-3], ... até >= 2^24 µs (~17 s)
+#define LATENCIA_VALIDADE_MARCA_US 10000000 // Marcas mais antigas que isso são descartadas
+
+/**
+ * @brief Medidas de ponta a ponta.
+ */
+enum MedidaLatencia {
+    LAT_SENSOR_ENVIO,    ///< Aquisição da amostra -> JSON da amostra aceito pelo cliente MQTT (Core 1).
+    LAT_ALARME,          ///< Amostra que cruzou o limiar de luz -> alarme aceito pelo cliente MQTT.
+    LAT_COMANDO_IRRIGAR, ///< Chegada do comando IRRIGAR -> servo acionado (Core 0).
+    NUM_MEDIDAS_LATENCIA
+};
+
+/**
+ * @brief Marca o início de uma medida que será concluída em outro ponto (ou núcleo).
+ * @param medida Valor de enum MedidaLatencia.
+ * @param inicio_us Instante do início em time_us_32().
+ */
+void latencia_marcar(uint8_t medida, uint32_t inicio_us);
+
+/**
+ * @brief Conclui a medida marcada, se houver uma marca válida, e a consome.
+ */
+void latencia_concluir(uint8_t medida);
+
+/**
+ * @brief Registra diretamente uma medida cujo início é conhecido no ponto de conclusão.
+ * @param inicio_us Instante do início em time_us_32().
+ */
+void latencia_registrar(uint8_t medida, uint32_t inicio_us);
+
+/**
+ * @brief Formata em JSON, por medida, contagem, p50, p99 e máximo (ms, desde o boot) e a
+ * vazão de publicações (mensagens/s) desde o relatório anterior. Chamada pelo Core 1.
+ * @return Número de caracteres escritos (sem o '\0'; o texto é truncado se não couber).
+ */
+int latencia_formatar(char *destino, size_t tamanho);
+
+#endif // LATENCIA_H
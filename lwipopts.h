@@ -75,12 +75,33 @@
 #define DHCP_DOES_ARP_CHECK         0
 #define LWIP_DHCP_DOES_ACD_CHECK    0
 
+// SNTP: o horário recebido alimenta o modelo de relogio.c (não há RTC de sistema).
+#define SNTP_SERVER_DNS             1
+#define SNTP_UPDATE_DELAY           900000  // 15 min: intervalo longo o bastante para medir a deriva
+#include <stdint.h>
+void relogio_sntp_recebido(uint32_t segundos, uint32_t microssegundos);
+#define SNTP_SET_SYSTEM_TIME_US(sec, us) relogio_sntp_recebido((sec), (us))
+
+// MQTT: publicações QoS 0 não esperam confirmação e se acumulam no buffer de saída
+// do cliente; 1 KB comporta várias mensagens completas (tópico + até 160 bytes).
+#define MQTT_OUTPUT_RINGBUF_SIZE    1024
+
 #ifndef NDEBUG
 #define LWIP_DEBUG                  1
 #define LWIP_STATS                  1
 #define LWIP_STATS_DISPLAY          1
 #endif
 
+// Com o perfilador ligado, os pools registram o pico de uso (impresso por memoria.c).
+#if defined(ESTUFA_PERFIL) && ESTUFA_PERFIL
+#undef MEM_STATS
+#undef MEMP_STATS
+#undef LWIP_STATS
+#define LWIP_STATS                  1
+#define MEM_STATS                   1
+#define MEMP_STATS                  1
+#endif
+
 #define ETHARP_DEBUG                LWIP_DBG_OFF
 #define NETIF_DEBUG                 LWIP_DBG_OFF
 #define PBUF_DEBUG                  LWIP_DBG_OFF
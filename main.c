@@ -6,7 +6,6 @@
 #include "configura_geral.h"
 #include <stdio.h>
 #include <string.h>
-#include <math.h>
 
 #include "pico/multicore.h"
 #include "pico/cyw43_arch.h"
@@ -22,7 +21,25 @@
 #include "buzzer.h"
 #include "servo.h"
 #include "aht10.h"
-#include "bh1750.h"
+#include "sensores.h"
+#include "maquina_estados.h"
+#include "irrigacao_auto.h"
+#include "perfil.h"
+#include "publicacao.h"
+#include "bench.h"
+#include "configuracao.h"
+#include "rede.h"
+#include "tempos_boot.h"
+#include "supervisor.h"
+#include "energia.h"
+#include "memoria.h"
+#include "cache_xip.h"
+#include "na_ram.h"
+#include "amostras.h"
+#include "relogio.h"
+#include "formato.h"
+#include "latencia.h"
+#include "reproducao.h"
 
 /* Estruturas de Dados */
 typedef struct {
@@ -32,16 +49,13 @@ typedef struct {
 } TimerNaoBloqueante;
 
 typedef struct {
-    volatile enum ModoOperacao modo_atual;
-    bool modo_foi_inicializado;
-
     TimerNaoBloqueante timer_geral;
     TimerNaoBloqueante timer_leitura_sensor;
-    TimerNaoBloqueante timer_irrigador_servo;
     TimerNaoBloqueante timer_display_update;
 
     bool alarme_luminosidade_ativo;
-    bool irrigador_servo_posicao_atual;
+    uint16_t duracao_irrigacao_s;          // Duração da rega em curso
+    uint16_t duracao_irrigacao_auto_s;     // Duração recomendada pelo controlador automático
 
     absolute_time_t ultimo_tempo_botao_b;
     TimerNaoBloqueante timer_heartbeat;
@@ -49,28 +63,76 @@ typedef struct {
 
 /* Variáveis Globais */
 static EstadoSistema sistema;
+static maquina_estados_t maquina;
 static aht10_data_t dados_sensor;
-static float dados_luminosidade;
-
-/* Protótipos de Funções Estaduais */
-void handle_modo_estufa_ok();
-void handle_modo_alerta_luz();
-void handle_modo_protegendo();
-void handle_modo_protegido();
-void handle_modo_irrigacao();
-void handle_modo_msg_irrigacao_fim();
+static uint32_t dados_luz_mlux;
+static uint32_t dados_luz_tempo_us; // Aquisição da última leitura de luz, para a latência do alarme
+
+/* Protótipos das Ações da Máquina de Estados */
+static void entrar_estufa_ok(void);
+static evento_id_t atualizar_estufa_ok(void);
+static void entrar_alerta_luz(void);
+static evento_id_t atualizar_alerta_luz(void);
+static void entrar_protegendo(void);
+static evento_id_t atualizar_protegendo(void);
+static void entrar_protegido(void);
+static evento_id_t atualizar_protegido(void);
+static void entrar_irrigacao(void);
+static evento_id_t atualizar_irrigacao(void);
+static void sair_irrigacao(void);
+static void entrar_msg_irrigacao_fim(void);
+static evento_id_t atualizar_msg_irrigacao_fim(void);
+static void acao_alarme_luz_ligado(void);
+static void acao_alarme_luz_desligado(void);
+static void acao_irrigacao_manual(void);
+static void acao_irrigacao_automatica(void);
 
 /* Protótipos de Funções Auxiliares */
 void timer_iniciar(TimerNaoBloqueante *timer, uint64_t duracao_us);
 bool timer_expirou(TimerNaoBloqueante *timer);
 void rgb_led_desligar();
 void solicitar_publicacao_mqtt(enum MQTT_MSG_TYPE tipo_msg);
+void solicitar_publicacao_mqtt_valor(enum MQTT_MSG_TYPE tipo_msg, uint8_t valor);
 void verificar_fifo();
 void inicia_hardware();
 void inicia_core1();
 void funcao_wifi_nucleo1();
 
 
+/* --- Tabelas da Máquina de Estados --- */
+
+/**
+ * @brief Descritores dos modos de operação, indexados por enum ModoOperacao.
+ * Para adicionar um modo basta acrescentar o descritor e suas linhas de transição.
+ */
+static const descritor_estado_t estados_estufa[NUM_MODOS] = {
+    [MODO_ESTUFA_OK]          = { "ESTUFA_OK",       entrar_estufa_ok,         atualizar_estufa_ok,         NULL },
+    [MODO_ESTUFA_ALERTA_LUZ]  = { "ALERTA_LUZ",      entrar_alerta_luz,        atualizar_alerta_luz,        NULL },
+    [MODO_ESTUFA_PROTEGENDO]  = { "PROTEGENDO",      entrar_protegendo,        atualizar_protegendo,        NULL },
+    [MODO_ESTUFA_PROTEGIDO]   = { "PROTEGIDO",       entrar_protegido,         atualizar_protegido,         NULL },
+    [MODO_ESTUFA_IRRIGACAO]   = { "IRRIGACAO",       entrar_irrigacao,         atualizar_irrigacao,         sair_irrigacao },
+    [MODO_MSG_IRRIGACAO_FIM]  = { "IRRIGACAO_FIM",   entrar_msg_irrigacao_fim, atualizar_msg_irrigacao_fim, NULL },
+};
+
+/**
+ * @brief Tabela de transições (estado x evento -> ação, próximo estado).
+ * A primeira linha compatível vence: as linhas com ESTADO_QUALQUER ficam no fim.
+ */
+static const transicao_t transicoes_estufa[] = {
+    { MODO_ESTUFA_OK,         EVT_LUZ_ALTA,           acao_alarme_luz_ligado,    MODO_ESTUFA_ALERTA_LUZ },
+    { MODO_ESTUFA_ALERTA_LUZ, EVT_TEMPO_ESGOTADO,     NULL,                      MODO_ESTUFA_PROTEGENDO },
+    { MODO_ESTUFA_PROTEGENDO, EVT_ANIMACAO_CONCLUIDA, NULL,                      MODO_ESTUFA_PROTEGIDO },
+    { MODO_ESTUFA_PROTEGIDO,  EVT_LUZ_NORMAL,         acao_alarme_luz_desligado, MODO_ESTUFA_OK },
+    { MODO_ESTUFA_IRRIGACAO,  EVT_TEMPO_ESGOTADO,     NULL,                      MODO_MSG_IRRIGACAO_FIM },
+    { MODO_ESTUFA_IRRIGACAO,  EVT_BOTAO_B,            NULL,                      MODO_ESTUFA_OK },  // Cancela a irrigação
+    { MODO_ESTUFA_IRRIGACAO,  EVT_CMD_CANCELAR,       NULL,                      MODO_ESTUFA_OK },
+    { MODO_MSG_IRRIGACAO_FIM, EVT_TEMPO_ESGOTADO,     NULL,                      MODO_ESTUFA_OK },
+    { MODO_ESTUFA_OK,         EVT_IRRIGACAO_AUTO,     acao_irrigacao_automatica, MODO_ESTUFA_IRRIGACAO },
+    { ESTADO_QUALQUER,        EVT_BOTAO_B,            acao_irrigacao_manual,     MODO_ESTUFA_IRRIGACAO },
+    { ESTADO_QUALQUER,        EVT_CMD_IRRIGAR,        acao_irrigacao_manual,     MODO_ESTUFA_IRRIGACAO },
+};
+
+
 /* --- Implementação das Funções --- */
 
 /**
@@ -78,9 +140,9 @@ void funcao_wifi_nucleo1();
  * @param timer Ponteiro para a estrutura do timer.
  * @param duracao_us Duração do timer em microssegundos.
  */
-void timer_iniciar(TimerNaoBloqueante *timer, uint64_t duracao_us) {
+void NA_RAM(timer_iniciar)(TimerNaoBloqueante *timer, uint64_t duracao_us) {
     timer->ativo = true;
-    timer->inicio = get_absolute_time();
+    timer->inicio = estufa_agora();
     timer->duracao_us = duracao_us;
 }
 
@@ -89,9 +151,9 @@ void timer_iniciar(TimerNaoBloqueante *timer, uint64_t duracao_us) {
  * @param timer Ponteiro para a estrutura do timer.
  * @return true se o timer expirou, false caso contrário.
  */
-bool timer_expirou(TimerNaoBloqueante *timer) {
+bool NA_RAM(timer_expirou)(TimerNaoBloqueante *timer) {
     if (!timer->ativo) return false;
-    if (absolute_time_diff_us(timer->inicio, get_absolute_time()) >= timer->duracao_us) {
+    if (absolute_time_diff_us(timer->inicio, estufa_agora()) >= timer->duracao_us) {
         timer->ativo = false;
         return true;
     }
@@ -99,10 +161,17 @@ bool timer_expirou(TimerNaoBloqueante *timer) {
 }
 
 /**
- * @brief Desliga o LED RGB.
+ * @brief Instante em que um timer ativo expira (usado para agendar o sono).
+ */
+static inline absolute_time_t timer_prazo(const TimerNaoBloqueante *timer) {
+    return delayed_by_us(timer->inicio, timer->duracao_us);
+}
+
+/**
+ * @brief Desliga o LED RGB com um fade curto.
  */
 void rgb_led_desligar() {
-    rgb_led_set_color(0, 0, 0);
+    rgb_led_fade(0, 0, 0, 300);
 }
 
 /**
@@ -110,168 +179,360 @@ void rgb_led_desligar() {
  * @param tipo_msg O tipo de mensagem MQTT a ser publicada.
  */
 void solicitar_publicacao_mqtt(enum MQTT_MSG_TYPE tipo_msg) {
+#if ESTUFA_REPRODUCAO
+    reproducao_publicar(tipo_msg & 0xFF, 0); // Sem Core 1 na reprodução: a publicação vai para a saída
+    return;
+#endif
     uint32_t pacote = (FIFO_CMD_PUBLICAR_MQTT << 16) | (tipo_msg & 0xFF);
     multicore_fifo_push_blocking(pacote);
+    energia_acordar_nucleo1();
+}
+
+/**
+ * @brief Solicita uma publicação MQTT acompanhada de um valor de 8 bits (ex: duração da rega).
+ * @param tipo_msg O tipo de mensagem MQTT a ser publicada.
+ * @param valor Valor transportado nos bits 8-15 do pacote.
+ */
+void solicitar_publicacao_mqtt_valor(enum MQTT_MSG_TYPE tipo_msg, uint8_t valor) {
+#if ESTUFA_REPRODUCAO
+    reproducao_publicar(tipo_msg & 0xFF, valor);
+    return;
+#endif
+    uint32_t pacote = (FIFO_CMD_PUBLICAR_MQTT << 16) | ((uint32_t)valor << 8) | (tipo_msg & 0xFF);
+    multicore_fifo_push_blocking(pacote);
+    energia_acordar_nucleo1();
 }
 
 /**
  * @brief Verifica o FIFO do multicore para comandos do Core1.
+ * Comandos remotos chegam como eventos (entregues à máquina de estados),
+ * ajustes de parâmetros ou pedidos de retrato de estado. Cada ajuste gera um
+ * novo registro de configuração na flash e só vale se a gravação der certo.
  */
-void verificar_fifo() {
+void NA_RAM(verificar_fifo)() {
     if (multicore_fifo_rvalid()) {
         uint32_t pacote = multicore_fifo_pop_blocking();
         uint16_t comando = pacote >> 16;
         uint16_t valor = pacote & 0xFFFF;
-        if (comando == FIFO_CMD_MUDAR_ESTADO) {
-            sistema.modo_atual = (enum ModoOperacao)valor;
-            sistema.modo_foi_inicializado = false;
+        config_estufa_t nova = *configuracao();
+        switch (comando) {
+            case FIFO_CMD_EVENTO:
+                maquina_disparar(&maquina, (evento_id_t)valor);
+                break;
+            case FIFO_CMD_SOLICITAR_STATUS:
+                solicitar_publicacao_mqtt_valor(MSG_STATUS, (uint8_t)(maquina_estado_atual(&maquina) |
+                                                (sistema.alarme_luminosidade_ativo ? 0x80 : 0)));
+                break;
+            case FIFO_CMD_AJUSTAR_LUZ_MAX:
+                nova.luz_maxima_mlux = (uint32_t)valor * 1000u; // O comando chega em lux inteiros
+                configuracao_salvar(&nova);
+                break;
+            case FIFO_CMD_AJUSTAR_INTERVALO:
+                nova.intervalo_leitura_s = valor;
+                if (configuracao_salvar(&nova)) {
+                    sistema.timer_leitura_sensor.ativo = false; // Aplica já na próxima iteração
+                }
+                break;
+            case FIFO_CMD_AJUSTAR_DURACAO:
+                nova.duracao_irrigacao_s = valor;
+                configuracao_salvar(&nova);
+                break;
+            case FIFO_CMD_AJUSTAR_UMIDADE_ALVO:
+                nova.umidade_alvo_c100 = (uint32_t)valor * 100u; // O comando chega em % inteiros
+                if (configuracao_salvar(&nova)) {
+                    irrigacao_auto_definir_alvo((int32_t)nova.umidade_alvo_c100);
+                }
+                break;
+            case FIFO_CMD_ESTADO_REDE:
+                display_definir_estado_rede((uint8_t)valor);
+                break;
+            case FIFO_CMD_SALVAR_REDE:
+                if (configuracao_aplicar_proposta_rede()) {
+                    printf("[config] parametros de rede gravados; valem a partir do proximo boot\n");
+                }
+                break;
         }
     }
 }
 
+/* --- Ações da Máquina de Estados --- */
+
 /**
- * @brief Manipula a lógica quando o sistema está no modo de Estufa OK.
- * Monitora luminosidade e transiciona para alerta se necessário.
+ * @brief Entrada no modo Estufa OK: mostra as leituras e acende o LED verde.
  */
-void handle_modo_estufa_ok() {
-    if (!sistema.modo_foi_inicializado) {
-        char linha2[25], linha3[25];
-        sprintf(linha2, "Temp: %.1f C", dados_sensor.temperature);
-        sprintf(linha3, "Luz: %.0f lux", dados_luminosidade);
-        display_show_message("Estufa OK", linha2, linha3);
-        rgb_led_set_color(0, PWM_MAX_DUTY, 0); // Verde
-        sistema.modo_foi_inicializado = true;
-    }
+static void entrar_estufa_ok(void) {
+    char destaque[12], rodape[25];
+    formato_t f;
+    formato_iniciar(&f, destaque, sizeof(destaque));
+    formato_decimal(&f, dados_sensor.temperature_c100 / 10, 1);
+    formato_texto(&f, " C");
+    formato_iniciar(&f, rodape, sizeof(rodape));
+    formato_texto(&f, "Luz: ");
+    formato_uint(&f, dados_luz_mlux / 1000u);
+    formato_texto(&f, " lux");
+    display_show_destaque("Estufa OK", destaque, rodape);
+    rgb_led_fade(0, PWM_MAX_DUTY, 0, 600); // Verde
+}
+
+/**
+ * @brief Modo Estufa OK: monitora a luminosidade e sinaliza excesso.
+ */
+static evento_id_t atualizar_estufa_ok(void) {
     matriz_desenhar_flor(100);
-    if (dados_luminosidade > LUZ_MAXIMA_ESTUFA && !sistema.alarme_luminosidade_ativo) {
-        sistema.alarme_luminosidade_ativo = true;
-        solicitar_publicacao_mqtt(MSG_ALARM_LUZ_ON);
-        sistema.modo_atual = MODO_ESTUFA_ALERTA_LUZ;
-        sistema.modo_foi_inicializado = false;
+    if (dados_luz_mlux > configuracao()->luz_maxima_mlux && !sistema.alarme_luminosidade_ativo) {
+        return EVT_LUZ_ALTA;
     }
+    return EVENTO_NENHUM;
 }
 
 /**
- * @brief Manipula a lógica quando o sistema está em alerta de luminosidade alta.
+ * @brief Ação da transição OK -> Alerta: marca o alarme e publica o evento.
  */
-void handle_modo_alerta_luz() {
-    if (!sistema.modo_foi_inicializado) {
-        display_show_message("ALERTA!", "Luminosidade ALTA", "");
-        matriz_desenhar_sol();
-        buzzer_play_tone(1500, 200);
-        timer_iniciar(&sistema.timer_geral, TEMPO_MSG_BEM_VINDO_US);
-        sistema.modo_foi_inicializado = true;
-    }
-    if (timer_expirou(&sistema.timer_geral)) {
-        sistema.modo_atual = MODO_ESTUFA_PROTEGENDO;
-        sistema.modo_foi_inicializado = false;
-    }
+static void acao_alarme_luz_ligado(void) {
+    sistema.alarme_luminosidade_ativo = true;
+    latencia_marcar(LAT_ALARME, dados_luz_tempo_us); // Concluída pelo Core 1 ao publicar o alarme
+    solicitar_publicacao_mqtt(MSG_ALARM_LUZ_ON);
 }
 
 /**
- * @brief Manipula a lógica quando o sistema está ativando a proteção solar.
- * Exibe uma animação do sol sumindo.
+ * @brief Entrada no alerta de luminosidade alta.
  */
-void handle_modo_protegendo() {
-    if (!sistema.modo_foi_inicializado) {
-        display_show_message("Acao Corretiva", "Ativando protecao", "solar...");
-        sistema.modo_foi_inicializado = true;
-    }
-    if (matriz_animacao_sol_sumindo()) {
-        sistema.modo_atual = MODO_ESTUFA_PROTEGIDO;
-        sistema.modo_foi_inicializado = false;
-    }
+static void entrar_alerta_luz(void) {
+    display_show_message("ALERTA!", "Luminosidade ALTA", "");
+    matriz_desenhar_sol();
+    rgb_led_piscar(PWM_MAX_DUTY, PWM_MAX_DUTY, 0, 500, 250); // Amarelo piscando
+    buzzer_play_tone(1500, 200);
+    timer_iniciar(&sistema.timer_geral, TEMPO_MSG_BEM_VINDO_US);
 }
 
 /**
- * @brief Manipula a lógica quando o sistema está no modo protegido.
- * Aguarda a luminosidade retornar ao normal.
+ * @brief Alerta de luminosidade: aguarda a mensagem ser exibida.
  */
-void handle_modo_protegido() {
-    if (!sistema.modo_foi_inicializado) {
-        display_show_message("Sistema em Alerta", "Protecao Ativada", "");
-        matriz_limpar();
-        rgb_led_set_color(PWM_MAX_DUTY, PWM_MAX_DUTY, 0); // Amarelo
-        sistema.modo_foi_inicializado = true;
-    }
-    if (dados_luminosidade <= LUZ_MAXIMA_ESTUFA && sistema.alarme_luminosidade_ativo) {
-        sistema.alarme_luminosidade_ativo = false;
-        solicitar_publicacao_mqtt(MSG_ALARM_LUZ_OFF);
-        sistema.modo_atual = MODO_ESTUFA_OK;
-        sistema.modo_foi_inicializado = false;
-    }
+static evento_id_t atualizar_alerta_luz(void) {
+    return timer_expirou(&sistema.timer_geral) ? EVT_TEMPO_ESGOTADO : EVENTO_NENHUM;
 }
 
 /**
- * @brief Manipula a lógica quando o sistema está no modo de irrigação.
+ * @brief Entrada na ativação da proteção solar.
  */
-void handle_modo_irrigacao() {
-    if (!sistema.modo_foi_inicializado) {
-        display_show_message("Irrigacao Ativada", "Iniciando...", NULL);
-        rgb_led_set_color(0, 0, PWM_MAX_DUTY); // Azul
-        matriz_iniciar_animacao_agua();
-        timer_iniciar(&sistema.timer_geral, 10 * 1000000); // 10s
-        sistema.modo_foi_inicializado = true;
-        servo_start_move(30);
-        timer_iniciar(&sistema.timer_irrigador_servo, 1500000);
-        sistema.irrigador_servo_posicao_atual = true;
-        timer_iniciar(&sistema.timer_display_update, 1000000);
+static void entrar_protegendo(void) {
+    display_show_message("Acao Corretiva", "Ativando protecao", "solar...");
+}
+
+/**
+ * @brief Ativação da proteção solar: exibe a animação do sol sumindo.
+ */
+static evento_id_t atualizar_protegendo(void) {
+    return matriz_animacao_sol_sumindo() ? EVT_ANIMACAO_CONCLUIDA : EVENTO_NENHUM;
+}
+
+/**
+ * @brief Entrada no modo protegido.
+ */
+static void entrar_protegido(void) {
+    display_show_message("Sistema em Alerta", "Protecao Ativada", "");
+    matriz_limpar();
+    rgb_led_respirar(PWM_MAX_DUTY, PWM_MAX_DUTY, 0, 3000); // Amarelo
+}
+
+/**
+ * @brief Modo protegido: aguarda a luminosidade retornar ao normal.
+ */
+static evento_id_t atualizar_protegido(void) {
+    if (dados_luz_mlux <= configuracao()->luz_maxima_mlux && sistema.alarme_luminosidade_ativo) {
+        return EVT_LUZ_NORMAL;
     }
+    return EVENTO_NENHUM;
+}
+
+/**
+ * @brief Ação da transição Protegido -> OK: encerra o alarme e publica o evento.
+ */
+static void acao_alarme_luz_desligado(void) {
+    sistema.alarme_luminosidade_ativo = false;
+    solicitar_publicacao_mqtt(MSG_ALARM_LUZ_OFF);
+}
+
+/**
+ * @brief Ação das transições manuais (Botão B, comando IRRIGAR): rega pela duração padrão.
+ */
+static void acao_irrigacao_manual(void) {
+    sistema.duracao_irrigacao_s = configuracao()->duracao_irrigacao_s;
+}
+
+/**
+ * @brief Ação da transição automática: rega pela duração calculada pelo controlador e publica a decisão.
+ */
+static void acao_irrigacao_automatica(void) {
+    sistema.duracao_irrigacao_s = sistema.duracao_irrigacao_auto_s;
+    solicitar_publicacao_mqtt_valor(MSG_IRRIGACAO_AUTO, (uint8_t)sistema.duracao_irrigacao_s);
+}
+
+/**
+ * @brief Entrada no modo de irrigação: inicia servo, animação e timers.
+ */
+static void entrar_irrigacao(void) {
+    display_show_message("Irrigacao Ativada", "Iniciando...", NULL);
+    rgb_led_respirar(0, 0, PWM_MAX_DUTY, 2000); // Azul
+    matriz_iniciar_animacao_agua();
+    timer_iniciar(&sistema.timer_geral, (uint64_t)sistema.duracao_irrigacao_s * 1000000);
+    irrigacao_auto_registrar_irrigacao(); // Inicia o bloqueio do controlador automático
+    servo_iniciar_varredura(SERVO_VARREDURA_ANGULO_MIN, SERVO_VARREDURA_ANGULO_MAX,
+                            SERVO_VELOCIDADE_VARREDURA_GRAUS_S);
+    latencia_concluir(LAT_COMANDO_IRRIGAR); // Só conta se a irrigação veio de um comando MQTT
+    timer_iniciar(&sistema.timer_display_update, 1000000);
+}
+
+/**
+ * @brief Modo de irrigação: atualiza a animação e a contagem regressiva.
+ * A varredura do servo roda sozinha na interrupção do PWM.
+ */
+static evento_id_t atualizar_irrigacao(void) {
     matriz_atualizar_animacao_agua();
-    if (timer_expirou(&sistema.timer_irrigador_servo)) {
-        servo_start_move(sistema.irrigador_servo_posicao_atual ? 150 : 30);
-        sistema.irrigador_servo_posicao_atual = !sistema.irrigador_servo_posicao_atual;
-        timer_iniciar(&sistema.timer_irrigador_servo, 1500000);
-    }
     if (timer_expirou(&sistema.timer_display_update) || !sistema.timer_display_update.ativo) {
-        int64_t diff_us = absolute_time_diff_us(sistema.timer_geral.inicio, get_absolute_time());
-        int tempo_restante_s = 10 - (diff_us / 1000000);
+        int64_t diff_us = absolute_time_diff_us(sistema.timer_geral.inicio, estufa_agora());
+        int tempo_restante_s = sistema.duracao_irrigacao_s - (diff_us / 1000000);
         if (tempo_restante_s < 0) tempo_restante_s = 0;
         char linha2_display[25];
-        sprintf(linha2_display, "Restam: %ds", tempo_restante_s);
+        formato_t f;
+        formato_iniciar(&f, linha2_display, sizeof(linha2_display));
+        formato_texto(&f, "Restam: ");
+        formato_int(&f, tempo_restante_s);
+        formato_caractere(&f, 's');
         display_show_message("Irrigacao Ativada", linha2_display, NULL);
         timer_iniciar(&sistema.timer_display_update, 1000000);
     }
-    if (timer_expirou(&sistema.timer_geral)) {
-        rgb_led_desligar();
-        matriz_limpar();
-        servo_stop_move();
-        sistema.timer_irrigador_servo.ativo = false;
-        sistema.modo_atual = MODO_MSG_IRRIGACAO_FIM;
-        sistema.modo_foi_inicializado = false;
+    return timer_expirou(&sistema.timer_geral) ? EVT_TEMPO_ESGOTADO : EVENTO_NENHUM;
+}
+
+/**
+ * @brief Saída do modo de irrigação (fim do tempo ou cancelamento): desliga os atuadores.
+ */
+static void sair_irrigacao(void) {
+    rgb_led_desligar();
+    matriz_limpar();
+    servo_stop_move();
+    sistema.timer_display_update.ativo = false;
+}
+
+/**
+ * @brief Entrada na mensagem de "Irrigação Finalizada".
+ */
+static void entrar_msg_irrigacao_fim(void) {
+    display_show_message("Irrigacao Finalizada", NULL, NULL);
+    timer_iniciar(&sistema.timer_geral, TEMPO_MSG_IRRIGACAO_FIM_US);
+}
+
+/**
+ * @brief Mensagem de fim de irrigação: aguarda o tempo de exibição.
+ */
+static evento_id_t atualizar_msg_irrigacao_fim(void) {
+    return timer_expirou(&sistema.timer_geral) ? EVT_TEMPO_ESGOTADO : EVENTO_NENHUM;
+}
+
+#if ESTUFA_BAIXO_CONSUMO
+static void despertar_botao(uint gpio, uint32_t eventos) {
+    (void)gpio;
+    (void)eventos;
+    energia_sinalizar_despertar(); // O botão é tratado no laço: o Core 0 precisa sair do sono
+}
+#endif
+
+/**
+ * @brief Próximo instante em que o Core 0 precisa acordar.
+ * Em repouso (OK/Protegido) só os timers de leitura e heartbeat importam; nos demais
+ * modos há animações e mensagens temporizadas, atendidas em passos curtos.
+ */
+static absolute_time_t proximo_evento_nucleo0(void) {
+    uint8_t modo = maquina_estado_atual(&maquina);
+    bool repouso = modo == MODO_ESTUFA_OK || modo == MODO_ESTUFA_PROTEGIDO;
+    absolute_time_t prazo = delayed_by_ms(estufa_agora(), repouso ? ENERGIA_SONO_MAX_MS : ENERGIA_TICK_ATIVO_MS);
+    const TimerNaoBloqueante *timers[] = { &sistema.timer_leitura_sensor, &sistema.timer_heartbeat };
+    for (size_t i = 0; i < count_of(timers); i++) {
+        if (timers[i]->ativo && absolute_time_diff_us(timer_prazo(timers[i]), prazo) > 0) {
+            prazo = timer_prazo(timers[i]);
+        }
+    }
+    if (absolute_time_diff_us(sensores_proximo_prazo(), prazo) > 0) {
+        prazo = sensores_proximo_prazo(); // Fim de uma conversão em andamento
     }
+    return prazo;
 }
 
 /**
- * @brief Manipula a lógica para exibir a mensagem de "Irrigação Finalizada".
+ * @brief Aplica ao controle a amostra da zona principal: valores exibidos, controlador de
+ * irrigação e limiar de luz (avaliado pela máquina de estados).
  */
-void handle_modo_msg_irrigacao_fim() {
-    if (!sistema.modo_foi_inicializado) {
-        display_show_message("Irrigacao Finalizada", NULL, NULL);
-        timer_iniciar(&sistema.timer_geral, TEMPO_MSG_IRRIGACAO_FIM_US);
-        sistema.modo_foi_inicializado = true;
+static void tratar_amostra_principal(const amostra_t *principal) {
+    if (principal->validos & AMOSTRA_TEMP) {
+        dados_sensor.temperature_c100 = principal->temp_c100;
+        dados_sensor.humidity_c100 = principal->umid_c100;
+    }
+#if IRRIGACAO_AUTO_HABILITADA
+    // O controlador só age com a estufa em repouso; nos demais modos a leitura é descartada.
+    // Com a sonda de solo presente, a decisão usa a umidade do solo.
+    if ((principal->validos & (AMOSTRA_UMID | AMOSTRA_SOLO)) && maquina_estado_atual(&maquina) == MODO_ESTUFA_OK) {
+        int32_t solo_c100 = (principal->validos & AMOSTRA_SOLO) ? principal->solo_c100 : -1;
+        sistema.duracao_irrigacao_auto_s = irrigacao_auto_avaliar(dados_sensor.humidity_c100, solo_c100);
+        if (sistema.duracao_irrigacao_auto_s > 0) {
+            maquina_disparar(&maquina, EVT_IRRIGACAO_AUTO);
+        }
     }
-    if (timer_expirou(&sistema.timer_geral)) {
-        sistema.modo_atual = MODO_ESTUFA_OK;
-        sistema.modo_foi_inicializado = false;
+#endif
+    if (principal->validos & AMOSTRA_LUZ) {
+        dados_luz_mlux = principal->luz_mlux;
+        dados_luz_tempo_us = (uint32_t)principal->tempo_us;
     }
 }
 
+/**
+ * @brief Apaga o display após um período sem atividade (baixo consumo) e o reacende
+ * a qualquer mudança de modo ou toque no botão.
+ */
+static void gerenciar_display(bool atividade) {
+#if ESTUFA_BAIXO_CONSUMO
+    static absolute_time_t ultima_atividade;
+    static bool apagado;
+    static uint8_t ultimo_modo = 0xFF;
+    uint8_t modo = maquina_estado_atual(&maquina);
+    if (atividade || modo != ultimo_modo) {
+        ultimo_modo = modo;
+        ultima_atividade = estufa_agora();
+        if (apagado) {
+            display_definir_ligado(true);
+            apagado = false;
+        }
+    } else if (!apagado && modo == MODO_ESTUFA_OK &&
+               absolute_time_diff_us(ultima_atividade, estufa_agora()) > ENERGIA_DISPLAY_APAGAR_S * 1000000ll) {
+        display_definir_ligado(false);
+        apagado = true;
+    }
+#else
+    (void)atividade;
+#endif
+}
+
 /**
  * @brief Inicializa todo o hardware necessário para o sistema.
  */
 void inicia_hardware() {
     stdio_init_all();
     display_init();
+    tempos_boot_marcar("display");
     rgb_led_init();
     buzzer_init();
     servo_init();
     matriz_init();
     matriz_limpar();
+    tempos_boot_marcar("atuadores");
 
     gpio_init(BOTAO_B_PIN);
     gpio_set_dir(BOTAO_B_PIN, GPIO_IN);
     gpio_pull_up(BOTAO_B_PIN);
+#if ESTUFA_BAIXO_CONSUMO
+    // A interrupção só serve para acordar o Core 0 do WFE; o botão continua tratado no laço.
+    gpio_set_irq_enabled_with_callback(BOTAO_B_PIN, GPIO_IRQ_EDGE_FALL, true, despertar_botao);
+#endif
 
     i2c_init(i2c0, 100 * 1000);
     gpio_set_function(I2C0_SDA_PIN, GPIO_FUNC_I2C);
@@ -279,177 +540,264 @@ void inicia_hardware() {
     gpio_pull_up(I2C0_SDA_PIN);
     gpio_pull_up(I2C0_SCL_PIN);
     
-    if (!aht10_init(i2c0)) {
+#if !ESTUFA_REPRODUCAO // Na reprodução as amostras vêm do traço
+    if (!sensores_iniciar(i2c0)) {
         display_show_message("ERRO FATAL", "AHT10 falhou!", NULL);
         while (true) tight_loop_contents();
     }
-    bh1750_init(i2c0); // BH1750 não tem checagem de retorno na init
+#endif
+    irrigacao_auto_init();
+    irrigacao_auto_definir_alvo((int32_t)configuracao()->umidade_alvo_c100);
+    tempos_boot_marcar("sensores");
 
     memset(&sistema, 0, sizeof(EstadoSistema));
-    sistema.modo_atual = MODO_ESTUFA_OK;
+    maquina_iniciar(&maquina, estados_estufa, NUM_MODOS,
+                    transicoes_estufa, count_of(transicoes_estufa), MODO_ESTUFA_OK);
 }
 
 /**
  * @brief Lança o Core1 para executar a função Wi-Fi.
  */
 void inicia_core1() {
+    memoria_pintar_pilha_nucleo1();
     multicore_launch_core1(funcao_wifi_nucleo1);
 }
 
 /**
  * @brief Função principal do sistema (Core0). Gerencia a máquina de estados,
  * leitura de sensores e interação com o usuário.
+ * O controle começa logo após a inicialização do hardware; a rede sobe em paralelo
+ * no Core 1 e, enquanto estiver fora, a estufa opera normalmente sem publicar.
  */
-int main() {
+int NA_RAM(main)() {
+    memoria_pintar_pilha_nucleo0(); // Antes de qualquer outra chamada, para medir a pilha inteira
+    supervisor_iniciar(); // Lê a causa do último reset antes de qualquer outra coisa
+    energia_configurar_clock();
+    cache_xip_iniciar();
+    configuracao_carregar(); // Antes de tudo: os demais módulos leem a configuração em vigor
+    amostras_iniciar();
+    tempos_boot_marcar("config");
     inicia_hardware();
-    display_show_message("Rede", "Conectando Wi-Fi...", NULL);
+    bench_executar(); // Sem efeito a menos que o firmware seja compilado com ESTUFA_BENCH=1
+#if ESTUFA_REPRODUCAO
+    // Sem rede nem watchdog: o laço para esperando o traço no USB.
+    reproducao_iniciar();
+#else
     inicia_core1();
-
-    uint32_t fifo_response;
-    while (!multicore_fifo_rvalid()) { tight_loop_contents(); }
-    fifo_response = multicore_fifo_pop_blocking();
-    if ((fifo_response >> 16) != FIFO_CMD_WIFI_CONECTADO || (fifo_response & 0xFFFF) != WIFI_STATUS_SUCCESS) {
-        display_show_message("ERRO FATAL", "Falha no Wi-Fi", NULL);
-        while(true) tight_loop_contents();
-    }
-    
-    display_show_message("Rede", "Conectando MQTT...", NULL);
-    while(true) {
-        if (multicore_fifo_rvalid()) {
-            fifo_response = multicore_fifo_pop_blocking();
-            if ((fifo_response >> 16) == FIFO_CMD_MQTT_CONECTADO) break;
-        }
-        tight_loop_contents();
-    }
-
-    display_show_message("BitDogEstufa", "Sistema Pronto", NULL);
+#endif
     buzzer_tocar_melodia_sucesso();
-    sleep_ms(2500);
+    tempos_boot_marcar("laco");
+#if !ESTUFA_REPRODUCAO
+    supervisor_armar();
+#endif
 
     while (true) {
+        PERFIL_INICIO(t_laco);
+
+        supervisor_fase(PERFIL_FASE_FIFO);
+        PERFIL_INICIO(t_fifo);
         verificar_fifo();
+        PERFIL_FIM(PERFIL_FASE_FIFO, t_fifo);
 
         // Botão B: Alterna irrigação
+        supervisor_fase(PERFIL_FASE_BOTAO);
+        PERFIL_INICIO(t_botao);
         static bool btn_b_pressed = false;
+        bool atividade = false;
         if (!gpio_get(BOTAO_B_PIN) && !btn_b_pressed) {
             btn_b_pressed = true;
-            if (sistema.modo_atual != MODO_ESTUFA_IRRIGACAO) {
-                sistema.modo_atual = MODO_ESTUFA_IRRIGACAO;
-            } else { // Se já está irrigando, cancela e volta para OK
-                sistema.modo_atual = MODO_ESTUFA_OK;
-            }
-            sistema.modo_foi_inicializado = false;
+            atividade = true;
+            maquina_disparar(&maquina, EVT_BOTAO_B); // Inicia ou cancela a irrigação
         } else if (gpio_get(BOTAO_B_PIN)) {
             btn_b_pressed = false;
         }
+        PERFIL_FIM(PERFIL_FASE_BOTAO, t_botao);
         
         // Leitura de Sensores
+        supervisor_fase(PERFIL_FASE_SENSORES);
+        PERFIL_INICIO(t_sensores);
+#if ESTUFA_REPRODUCAO
+        amostra_t reproduzida;
+        if (reproducao_proxima_amostra(&reproduzida)) {
+            tratar_amostra_principal(&reproduzida);
+        }
+#else
         if (timer_expirou(&sistema.timer_leitura_sensor) || !sistema.timer_leitura_sensor.ativo) {
-            if (aht10_read_data(i2c0, &dados_sensor)) {
-                uint16_t temp_int = (uint16_t)(dados_sensor.temperature * 100.0f);
-                multicore_fifo_push_blocking((FIFO_CMD_PUB_SENSOR_TEMP << 16) | temp_int);
-                uint16_t umid_int = (uint16_t)(dados_sensor.humidity * 100.0f);
-                multicore_fifo_push_blocking((FIFO_CMD_PUB_SENSOR_UMID << 16) | umid_int);
-            }
-            float lux = bh1750_read_lux(i2c0);
-            if (lux >= 0) {
-                dados_luminosidade = lux;
-                multicore_fifo_push_blocking((FIFO_CMD_PUB_SENSOR_LUZ << 16) | (uint16_t)lux);
+            sensores_iniciar_ciclo(); // Carimba a aquisição e dispara as medições
+            timer_iniciar(&sistema.timer_leitura_sensor, (uint64_t)configuracao()->intervalo_leitura_s * 1000000);
+        }
+        if (sensores_tarefa()) {
+            for (uint8_t z = 0; z < sensores_num_zonas(); z++) {
+                const amostra_t *a = sensores_amostra(z);
+                if (a->validos) amostras_enviar(a); // Não bloqueia, mesmo com o Core 1 ocupado
             }
-            timer_iniciar(&sistema.timer_leitura_sensor, 10000000); // Leitura a cada 10s
+            // O controle usa a zona principal.
+            tratar_amostra_principal(sensores_amostra(ZONA_PRINCIPAL));
         }
+#endif
+        PERFIL_FIM(PERFIL_FASE_SENSORES, t_sensores);
 
         // Máquina de Estados
-        switch (sistema.modo_atual) {
-            case MODO_ESTUFA_OK: handle_modo_estufa_ok(); break;
-            case MODO_ESTUFA_ALERTA_LUZ: handle_modo_alerta_luz(); break;
-            case MODO_ESTUFA_PROTEGENDO: handle_modo_protegendo(); break;
-            case MODO_ESTUFA_PROTEGIDO: handle_modo_protegido(); break;
-            case MODO_ESTUFA_IRRIGACAO: handle_modo_irrigacao(); break;
-            case MODO_MSG_IRRIGACAO_FIM: handle_modo_msg_irrigacao_fim(); break;
-            default:
-                sistema.modo_atual = MODO_ESTUFA_OK;
-                sistema.modo_foi_inicializado = false;
-                break;
-        }
+        supervisor_fase(PERFIL_FASE_ESTADOS);
+        PERFIL_INICIO(t_estados);
+        maquina_executar(&maquina);
+        gerenciar_display(atividade);
+        PERFIL_FIM(PERFIL_FASE_ESTADOS, t_estados);
 
         // Heartbeat
-        if (timer_expirou(&sistema.timer_heartbeat) || !sistema.timer_heartbeat.ativo) {
+        supervisor_fase(PERFIL_FASE_HEARTBEAT);
+        PERFIL_INICIO(t_heartbeat);
+        // Na reprodução, os relatórios periódicos (tempos reais do hardware) ficam de fora da saída.
+        if (!ESTUFA_REPRODUCAO && (timer_expirou(&sistema.timer_heartbeat) || !sistema.timer_heartbeat.ativo)) {
             solicitar_publicacao_mqtt(MSG_LOG_HEARTBEAT);
+            solicitar_publicacao_mqtt(MSG_ENERGIA);
+            cache_xip_atualizar(); // Fecha a janela antes de o Core 1 formatar a mensagem
+            solicitar_publicacao_mqtt(MSG_MEMORIA);
+            solicitar_publicacao_mqtt(MSG_XIP);
+            maquina_imprimir_rastreamento(&maquina);
+            configuracao_imprimir();
+            perfil_imprimir();
+            memoria_imprimir();
             timer_iniciar(&sistema.timer_heartbeat, 30000000);
         }
-        tight_loop_contents();
+        PERFIL_FIM(PERFIL_FASE_HEARTBEAT, t_heartbeat);
+
+        PERFIL_FIM(PERFIL_FASE_LACO, t_laco);
+        supervisor_batimento(); // Só alimenta o watchdog se os dois núcleos estiverem saudáveis
+#if ESTUFA_REPRODUCAO
+        reproducao_avancar_ate(proximo_evento_nucleo0()); // Salta o relógio virtual em vez de dormir
+#else
+        energia_dormir_ate(proximo_evento_nucleo0()); // Sem ESTUFA_BAIXO_CONSUMO, retorna na hora
+#endif
     }
     return 0;
 }
 
+#define PUBLICACOES_POR_AMOSTRA 5 // Quatro tópicos individuais + JSON
+
+/**
+ * @brief Enfileira as publicações de uma amostra: os tópicos individuais de sempre e o
+ * JSON com o horário de aquisição.
+ */
+static void enfileirar_amostra(fila_publicacao_t *fila, const amostra_t *amostra) {
+    if (amostra->validos & AMOSTRA_TEMP) {
+        publicacao_formatar_sensor(FIFO_CMD_PUB_SENSOR_TEMP, (uint16_t)amostra->temp_c100, amostra->zona, fila_publicacao_reservar(fila));
+        fila_publicacao_confirmar(fila);
+    }
+    if (amostra->validos & AMOSTRA_UMID) {
+        publicacao_formatar_sensor(FIFO_CMD_PUB_SENSOR_UMID, amostra->umid_c100, amostra->zona, fila_publicacao_reservar(fila));
+        fila_publicacao_confirmar(fila);
+    }
+    if (amostra->validos & AMOSTRA_LUZ) {
+        publicacao_formatar_sensor(FIFO_CMD_PUB_SENSOR_LUZ, (uint16_t)(amostra->luz_mlux / 1000u), amostra->zona, fila_publicacao_reservar(fila));
+        fila_publicacao_confirmar(fila);
+    }
+    if (amostra->validos & AMOSTRA_SOLO) {
+        publicacao_formatar_sensor(FIFO_CMD_PUB_SENSOR_SOLO, amostra->solo_c100, amostra->zona, fila_publicacao_reservar(fila));
+        fila_publicacao_confirmar(fila);
+    }
+    publicacao_formatar_amostra(amostra, fila_publicacao_reservar(fila));
+    fila_publicacao_confirmar(fila);
+}
+
+/**
+ * @brief Se a mensagem pode sair agora: sessão MQTT de pé e, para QoS 1, sem PUBACK pendente.
+ */
+static bool pode_publicar(const publicacao_t *pub) {
+    return pub && rede_estado() == REDE_ONLINE &&
+           (publicacao_politica(pub->classe)->qos == 0 || !mqtt_is_publishing());
+}
+
 /**
  * @brief Função executada no Core1, responsável pela comunicação Wi-Fi e MQTT.
  */
-void funcao_wifi_nucleo1() {
-    #define QUEUE_SIZE 10
-    typedef struct { char topico[100]; char mensagem[100]; } publication_t;
-    static publication_t publication_queue[QUEUE_SIZE];
-    static int queue_head = 0, queue_tail = 0;
+void NA_RAM(funcao_wifi_nucleo1)() {
+    static fila_publicacao_t fila;
     static TimerNaoBloqueante timer_entre_publicacoes;
+    static TimerNaoBloqueante timer_relatorio_fila;
 
-    cyw43_arch_init();
-    cyw43_arch_enable_sta_mode();
-    if (cyw43_arch_wifi_connect_timeout_ms(WIFI_SSID, WIFI_PASS, CYW43_AUTH_WPA2_AES_PSK, 30000)) {
-        multicore_fifo_push_blocking((FIFO_CMD_WIFI_CONECTADO << 16) | WIFI_STATUS_FAIL);
-    } else {
-        multicore_fifo_push_blocking((FIFO_CMD_WIFI_CONECTADO << 16) | WIFI_STATUS_SUCCESS);
-    }
-    iniciar_mqtt_cliente();
+    tempos_boot_inicio_nucleo();
+    fila_publicacao_iniciar(&fila);
+    timer_iniciar(&timer_relatorio_fila, 30000000);
+    rede_iniciar(); // Não-bloqueante: a conexão avança em rede_tarefa()
+    energia_iniciar_nucleo1(); // Depois do cyw43_arch_init(), que cria o contexto assíncrono
 
     while (true) {
+        static bool boot_publicado = false;
+        supervisor_fase(FASE_C1_REDE);
+        if (rede_tarefa() && rede_estado() == REDE_ONLINE && !boot_publicado) {
+            publicacao_formatar_reset(fila_publicacao_reservar(&fila));
+            fila_publicacao_confirmar(&fila);
+            publicacao_formatar_boot(fila_publicacao_reservar(&fila));
+            fila_publicacao_confirmar(&fila);
+            boot_publicado = true;
+        }
+        if (rede_estado() >= REDE_CONECTANDO_MQTT) {
+            relogio_iniciar_sntp(); // Com o Wi-Fi de pé; chamadas seguintes não fazem nada
+        }
+
+        supervisor_fase(FASE_C1_FIFO);
         if (multicore_fifo_rvalid()) {
             uint32_t pacote = multicore_fifo_pop_blocking();
             uint16_t comando = pacote >> 16;
-            char msg_buffer[100], base_topic[100];
-            
+
+            if (comando == FIFO_CMD_ESTACIONAR) {
+                configuracao_estacionar(); // Core 0 vai gravar a flash
+                continue;
+            }
+
+            // A mensagem é formatada direto no espaço da fila.
+            publicacao_t *pub = fila_publicacao_reservar(&fila);
+            bool formatada = false;
             if (comando == FIFO_CMD_PUBLICAR_MQTT) {
-                uint8_t tipo_msg = pacote & 0xFF;
-                switch ((enum MQTT_MSG_TYPE)tipo_msg) {
-                    case MSG_ALARM_LUZ_ON: strcpy(base_topic, "alarme"); strcpy(msg_buffer, "{\"alarme\":\"luminosidade\", \"status\":\"ativo\"}"); break;
-                    case MSG_ALARM_LUZ_OFF: strcpy(base_topic, "alarme"); strcpy(msg_buffer, "{\"alarme\":\"luminosidade\", \"status\":\"ok\"}"); break;
-                    case MSG_LOG_HEARTBEAT: strcpy(base_topic, TOPICO_HEARTBEAT); strcpy(msg_buffer, "ok"); break;
-                }
-                 int next_tail = (queue_tail + 1) % QUEUE_SIZE;
-                if (next_tail != queue_head) {
-                    snprintf(publication_queue[queue_tail].topico, sizeof(publication_queue[queue_tail].topico), "%s/%s", DEVICE_ID, base_topic);
-                    strncpy(publication_queue[queue_tail].mensagem, msg_buffer, sizeof(publication_queue[queue_tail].mensagem) - 1);
-                    publication_queue[queue_tail].mensagem[sizeof(publication_queue[queue_tail].mensagem) - 1] = '\0';
-                    queue_tail = next_tail;
-                }
-            } else if (comando >= FIFO_CMD_PUB_SENSOR_TEMP && comando <= FIFO_CMD_PUB_SENSOR_LUZ) {
-                uint16_t valor_int = pacote & 0xFFFF;
-                char topico_final[100], msg_final[20];
-                if (comando == FIFO_CMD_PUB_SENSOR_TEMP) {
-                    sprintf(msg_final, "%.2f", (float)valor_int / 100.0f);
-                    snprintf(topico_final, sizeof(topico_final), "%s/sensores/temperatura", DEVICE_ID);
-                } else if (comando == FIFO_CMD_PUB_SENSOR_UMID) {
-                    sprintf(msg_final, "%.2f", (float)valor_int / 100.0f);
-                    snprintf(topico_final, sizeof(topico_final), "%s/sensores/umidade", DEVICE_ID);
-                } else { // FIFO_CMD_PUB_SENSOR_LUZ
-                    sprintf(msg_final, "%d", valor_int);
-                    snprintf(topico_final, sizeof(topico_final), "%s/sensores/luminosidade", DEVICE_ID);
-                }
-                int next_tail = (queue_tail + 1) % QUEUE_SIZE;
-                if (next_tail != queue_head) {
-                    strncpy(publication_queue[queue_tail].topico, topico_final, sizeof(publication_queue[queue_tail].topico));
-                    strncpy(publication_queue[queue_tail].mensagem, msg_final, sizeof(publication_queue[queue_tail].mensagem));
-                    queue_tail = next_tail;
-                }
+                formatada = publicacao_formatar_evento(pacote & 0xFF, (pacote >> 8) & 0xFF, pub);
             }
+            if (formatada) fila_publicacao_confirmar(&fila);
         }
-        if (!mqtt_is_publishing() && queue_head != queue_tail && (timer_expirou(&timer_entre_publicacoes) || !timer_entre_publicacoes.ativo)) {
-            publication_t *pub = &publication_queue[queue_head];
-            publicar_mensagem_mqtt(pub->topico, pub->mensagem);
-            queue_head = (queue_head + 1) % QUEUE_SIZE;
+        // Só retira amostras que cabem inteiras na fila; as demais esperam na fila de amostras.
+        amostra_t amostra;
+        while (fila_publicacao_livre(&fila) >= PUBLICACOES_POR_AMOSTRA && amostras_receber(&amostra)) {
+            enfileirar_amostra(&fila, &amostra);
+        }
+
+        // Fora do ar, as mensagens ficam retidas na fila até a reconexão.
+        // Só mensagens QoS 1 esperam o PUBACK da anterior; QoS 0 segue direto.
+        const publicacao_t *proxima = fila_publicacao_proxima(&fila);
+        if (pode_publicar(proxima) &&
+            (timer_expirou(&timer_entre_publicacoes) || !timer_entre_publicacoes.ativo)) {
+            const politica_publicacao_t *politica = publicacao_politica(proxima->classe);
+            supervisor_fase(FASE_C1_PUBLICACAO);
+            if (publicar_mensagem_mqtt(proxima->topico, proxima->mensagem, politica->qos, politica->reter)) {
+                if (proxima->classe == PUB_TELEMETRIA) {
+                    latencia_registrar(LAT_SENSOR_ENVIO, proxima->origem_us);
+                } else if (proxima->classe == PUB_ALARME) {
+                    latencia_concluir(LAT_ALARME);
+                }
+                fila_publicacao_descartar(&fila);
+            }
             timer_iniciar(&timer_entre_publicacoes, 50000);
         }
-        cyw43_arch_poll();
-        sleep_ms(1);
+        if (timer_expirou(&timer_relatorio_fila)) {
+            // No ritmo do heartbeat: latência por prioridade no stdio, contadores da rede e
+            // latências de ponta a ponta no stdio e no MQTT.
+            fila_publicacao_imprimir(&fila);
+            publicacao_formatar_rede(&fila, fila_publicacao_reservar(&fila));
+            fila_publicacao_confirmar(&fila);
+            publicacao_t *latencias = fila_publicacao_reservar(&fila);
+            publicacao_formatar_latencia(latencias);
+            printf("[latencia] %s\n", latencias->mensagem);
+            fila_publicacao_confirmar(&fila);
+            timer_iniciar(&timer_relatorio_fila, 30000000);
+        }
+        supervisor_fase(FASE_C1_ESPERA);
+        supervisor_batimento();
+        // Acorda antes por evento do CYW43 ou por mensagem do Core 0 no FIFO.
+        // Mensagem que ainda não pode sair (fora do ar, PUBACK pendente) espera o CYW43, não o timer.
+        absolute_time_t prazo = make_timeout_time_ms(ENERGIA_SONO_MAX_MS);
+        if (pode_publicar(fila_publicacao_proxima(&fila)) && timer_entre_publicacoes.ativo &&
+            absolute_time_diff_us(timer_prazo(&timer_entre_publicacoes), prazo) > 0) {
+            prazo = timer_prazo(&timer_entre_publicacoes);
+        }
+        energia_dormir_ate(prazo);
     }
 }
\ No newline at end of file
@@ -0,0 +1,120 @@
+/**
+ * @file maquina_estados.c
+ * @brief Implementação do motor de máquina de estados orientada a tabela.
+ */
+
+#include "maquina_estados.h"
+#include "na_ram.h"
+#include "reproducao.h"
+#include <stdio.h>
+#include <string.h>
+
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Procura a primeira linha da tabela compatível com o estado atual e o evento.
+ * @return Ponteiro para a linha encontrada, ou NULL se o evento não tem efeito no estado atual.
+ */
+static const transicao_t *maquina_buscar_transicao(const maquina_estados_t *m, evento_id_t evento) {
+    for (uint8_t i = 0; i < m->num_transicoes; i++) {
+        const transicao_t *t = &m->transicoes[i];
+        if (t->evento == evento && (t->origem == m->atual || t->origem == ESTADO_QUALQUER)) {
+            return t;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Executa a ação de entrada do estado atual e inicia a contagem de permanência.
+ */
+static void maquina_entrar(maquina_estados_t *m) {
+    const descritor_estado_t *e = &m->estados[m->atual];
+    m->inicio_estado = estufa_agora();
+    m->entradas[m->atual]++;
+    m->entrada_pendente = false;
+    if (e->ao_entrar) e->ao_entrar();
+}
+
+
+// --- Implementação das Funções Públicas ---
+
+void maquina_iniciar(maquina_estados_t *m, const descritor_estado_t *estados, uint8_t num_estados,
+                     const transicao_t *transicoes, uint8_t num_transicoes, estado_id_t inicial) {
+    memset(m, 0, sizeof(*m));
+    m->estados = estados;
+    m->num_estados = num_estados < MAQUINA_MAX_ESTADOS ? num_estados : MAQUINA_MAX_ESTADOS;
+    m->transicoes = transicoes;
+    m->num_transicoes = num_transicoes;
+    m->atual = inicial;
+    m->entrada_pendente = true;
+}
+
+bool NA_RAM(maquina_disparar)(maquina_estados_t *m, evento_id_t evento) {
+    if (evento == EVENTO_NENHUM) return false;
+    const transicao_t *t = maquina_buscar_transicao(m, evento);
+    if (!t || t->destino >= m->num_estados) return false;
+
+    absolute_time_t agora = estufa_agora();
+
+    // Registra a transição no histórico circular antes de executar os ganchos,
+    // para que o carimbo de tempo reflita o instante do evento.
+    registro_transicao_t *r = &m->historico[m->historico_proximo];
+    r->tempo_us = to_us_since_boot(agora);
+    r->origem = m->atual;
+    r->destino = t->destino;
+    r->evento = evento;
+    m->historico_proximo = (m->historico_proximo + 1) % MAQUINA_HISTORICO_TAM;
+    m->total_transicoes++;
+#if ESTUFA_REPRODUCAO
+    reproducao_transicao(m->estados[m->atual].nome, m->estados[t->destino].nome, evento);
+#endif
+
+    // Saída do estado atual (somente se a entrada dele chegou a ser executada).
+    if (!m->entrada_pendente) {
+        m->permanencia_us[m->atual] += absolute_time_diff_us(m->inicio_estado, agora);
+        const descritor_estado_t *e = &m->estados[m->atual];
+        if (e->ao_sair) e->ao_sair();
+    }
+
+    if (t->acao) t->acao();
+
+    m->atual = t->destino;
+    maquina_entrar(m);
+    return true;
+}
+
+void NA_RAM(maquina_executar)(maquina_estados_t *m) {
+    if (m->entrada_pendente) {
+        maquina_entrar(m);
+    }
+    const descritor_estado_t *e = &m->estados[m->atual];
+    if (e->ao_atualizar) {
+        maquina_disparar(m, e->ao_atualizar());
+    }
+}
+
+void maquina_imprimir_rastreamento(const maquina_estados_t *m) {
+    printf("[maquina] %lu transicoes\n", (unsigned long)m->total_transicoes);
+
+    // Percorre o histórico da entrada mais antiga para a mais recente.
+    uint32_t qtd = m->total_transicoes < MAQUINA_HISTORICO_TAM ? m->total_transicoes : MAQUINA_HISTORICO_TAM;
+    uint8_t idx = (m->historico_proximo + MAQUINA_HISTORICO_TAM - qtd) % MAQUINA_HISTORICO_TAM;
+    for (uint32_t i = 0; i < qtd; i++) {
+        const registro_transicao_t *r = &m->historico[idx];
+        printf("  %10llu us  %s -> %s (evento %u)\n", (unsigned long long)r->tempo_us,
+               m->estados[r->origem].nome, m->estados[r->destino].nome, r->evento);
+        idx = (idx + 1) % MAQUINA_HISTORICO_TAM;
+    }
+
+    // O estado atual ainda não acumulou o trecho em curso; soma-o para o relatório.
+    for (uint8_t s = 0; s < m->num_estados; s++) {
+        uint64_t total = m->permanencia_us[s];
+        if (s == m->atual && !m->entrada_pendente) {
+            total += absolute_time_diff_us(m->inicio_estado, estufa_agora());
+        }
+        printf("  %-22s entradas=%lu tempo=%llu ms\n", m->estados[s].nome,
+               (unsigned long)m->entradas[s], (unsigned long long)(total / 1000));
+    }
+}
@@ -0,0 +1,126 @@
+/**
+ * @file maquina_estados.h
+ * @brief Motor genérico de máquina de estados orientada a tabela.
+ * Cada estado é descrito por ações de entrada, atualização e saída; as transições
+ * são declaradas em uma tabela constante (estado x evento -> ação, próximo estado).
+ * Toda transição é registrada com carimbo de tempo para análise de permanência.
+ */
+
+#ifndef MAQUINA_ESTADOS_H
+#define MAQUINA_ESTADOS_H
+
+#include "pico/stdlib.h" // Para tipos básicos e absolute_time_t
+
+#define MAQUINA_MAX_ESTADOS 16     // Capacidade das estatísticas por estado
+#define MAQUINA_HISTORICO_TAM 16   // Quantidade de transições mantidas no histórico circular
+#define ESTADO_QUALQUER 0xFF       // Curinga de origem na tabela de transições
+#define EVENTO_NENHUM 0            // Valor reservado: nenhum evento ocorreu
+
+typedef uint8_t estado_id_t;
+typedef uint8_t evento_id_t;
+
+/** @brief Ação executada na entrada, na saída de um estado ou durante uma transição. */
+typedef void (*acao_maquina_t)(void);
+
+/**
+ * @brief Atualização periódica de um estado.
+ * @return O evento gerado nesta iteração, ou EVENTO_NENHUM.
+ */
+typedef evento_id_t (*atualizacao_maquina_t)(void);
+
+/**
+ * @struct descritor_estado_t
+ * @brief Ganchos de um estado. Qualquer ponteiro pode ser NULL.
+ */
+typedef struct {
+    const char *nome;                  ///< Nome legível, usado no rastreamento.
+    acao_maquina_t ao_entrar;          ///< Executada uma vez ao entrar no estado.
+    atualizacao_maquina_t ao_atualizar;///< Executada a cada iteração do laço principal.
+    acao_maquina_t ao_sair;            ///< Executada uma vez ao deixar o estado.
+} descritor_estado_t;
+
+/**
+ * @struct transicao_t
+ * @brief Linha da tabela de transições. A primeira linha compatível vence,
+ * portanto linhas específicas devem preceder as que usam ESTADO_QUALQUER.
+ */
+typedef struct {
+    estado_id_t origem;   ///< Estado de origem ou ESTADO_QUALQUER.
+    evento_id_t evento;   ///< Evento que dispara a transição.
+    acao_maquina_t acao;  ///< Ação da transição (pode ser NULL).
+    estado_id_t destino;  ///< Próximo estado.
+} transicao_t;
+
+/**
+ * @struct registro_transicao_t
+ * @brief Entrada do histórico de transições.
+ */
+typedef struct {
+    uint64_t tempo_us;    ///< Instante da transição (µs desde o boot).
+    estado_id_t origem;
+    estado_id_t destino;
+    evento_id_t evento;
+} registro_transicao_t;
+
+/**
+ * @struct maquina_estados_t
+ * @brief Instância da máquina: tabelas constantes mais o estado de execução.
+ */
+typedef struct {
+    const descritor_estado_t *estados;
+    uint8_t num_estados;
+    const transicao_t *transicoes;
+    uint8_t num_transicoes;
+
+    estado_id_t atual;
+    bool entrada_pendente;
+    absolute_time_t inicio_estado;
+
+    registro_transicao_t historico[MAQUINA_HISTORICO_TAM];
+    uint8_t historico_proximo;
+    uint32_t total_transicoes;
+
+    uint64_t permanencia_us[MAQUINA_MAX_ESTADOS]; ///< Tempo acumulado em cada estado.
+    uint32_t entradas[MAQUINA_MAX_ESTADOS];       ///< Número de entradas em cada estado.
+} maquina_estados_t;
+
+/**
+ * @brief Inicializa a máquina. A ação de entrada do estado inicial roda na primeira chamada a maquina_executar().
+ * @param m Instância a inicializar.
+ * @param estados Vetor de descritores, indexado pelo identificador do estado.
+ * @param num_estados Quantidade de estados (no máximo MAQUINA_MAX_ESTADOS).
+ * @param transicoes Tabela de transições.
+ * @param num_transicoes Quantidade de linhas da tabela.
+ * @param inicial Estado inicial.
+ */
+void maquina_iniciar(maquina_estados_t *m, const descritor_estado_t *estados, uint8_t num_estados,
+                     const transicao_t *transicoes, uint8_t num_transicoes, estado_id_t inicial);
+
+/**
+ * @brief Executa uma iteração: entrada pendente, atualização do estado atual e despacho do evento gerado.
+ * @param m Instância da máquina.
+ */
+void maquina_executar(maquina_estados_t *m);
+
+/**
+ * @brief Entrega um evento externo (botão, comando remoto) à máquina.
+ * @param m Instância da máquina.
+ * @param evento Evento a processar.
+ * @return true se alguma transição foi executada, false se o evento foi ignorado.
+ */
+bool maquina_disparar(maquina_estados_t *m, evento_id_t evento);
+
+/**
+ * @brief Retorna o estado atual.
+ */
+static inline estado_id_t maquina_estado_atual(const maquina_estados_t *m) {
+    return m->atual;
+}
+
+/**
+ * @brief Imprime via stdio o histórico de transições e o tempo acumulado por estado.
+ * @param m Instância da máquina.
+ */
+void maquina_imprimir_rastreamento(const maquina_estados_t *m);
+
+#endif // MAQUINA_ESTADOS_H
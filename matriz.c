@@ -4,12 +4,15 @@
  */
 
 #include "matriz.h"
+#include "na_ram.h"
 #include "configura_geral.h"
 #include "hardware/pio.h"
 #include "ws2812.pio.h"
 #include <string.h>
 #include <stdlib.h>
 #include "pico/time.h"
+#include "perfil.h"
+#include "reproducao.h"
 
 // --- Definições ---
 #define LED_COUNT 25
@@ -38,10 +41,12 @@ static inline void put_pixel(uint32_t pixel_grb) {
     pio_sm_put_blocking(pio0, 0, pixel_grb << 8u);
 }
 
-static void matriz_renderizar() {
+static void NA_RAM(matriz_renderizar)() {
+    PERFIL_INICIO(t_matriz);
     for (int i = 0; i < LED_COUNT; ++i) {
         put_pixel(matriz_buffer[i]);
     }
+    PERFIL_FIM(PERFIL_FASE_MATRIZ, t_matriz);
 }
 
 static uint xy_to_index(uint x, uint y) {
@@ -71,6 +76,11 @@ void matriz_desenhar_ponto_central(uint8_t r, uint8_t g, uint8_t b) {
 }
 
 void matriz_desenhar_sol() {
+    matriz_compor_sol();
+    matriz_renderizar();
+}
+
+void matriz_compor_sol() {
     memset(matriz_buffer, 0, sizeof(matriz_buffer));
     uint32_t cor_sol = urgb_u32(255, 200, 0);
     matriz_buffer[xy_to_index(2, 1)] = cor_sol;
@@ -82,10 +92,14 @@ void matriz_desenhar_sol() {
     matriz_buffer[xy_to_index(4, 0)] = cor_sol;
     matriz_buffer[xy_to_index(0, 4)] = cor_sol;
     matriz_buffer[xy_to_index(4, 4)] = cor_sol;
-    matriz_renderizar();
 }
 
 void matriz_desenhar_flor(uint8_t brilho) {
+    matriz_compor_flor(brilho);
+    matriz_renderizar();
+}
+
+void matriz_compor_flor(uint8_t brilho) {
     memset(matriz_buffer, 0, sizeof(matriz_buffer));
     uint32_t cor_vermelha_petala = urgb_u32(50 * brilho / 50, 0, 0);
     uint32_t cor_verde_caule = urgb_u32(0, 50 * brilho / 50, 0);
@@ -100,20 +114,19 @@ void matriz_desenhar_flor(uint8_t brilho) {
     matriz_buffer[xy_to_index(0, 4)] = cor_vermelha_petala;
     matriz_buffer[xy_to_index(1, 4)] = cor_vermelha_petala;
     matriz_buffer[xy_to_index(2, 4)] = cor_vermelha_petala;
-    matriz_renderizar();
 }
 
 
 bool matriz_animacao_sol_sumindo() {
     if (sol_sumindo_frame_atual == 0) {
         memset(matriz_buffer, 0, sizeof(matriz_buffer));
-        sol_sumindo_ultimo_frame_tempo = get_absolute_time();
+        sol_sumindo_ultimo_frame_tempo = estufa_agora();
         matriz_desenhar_sol();
         sol_sumindo_frame_atual++;
         return false;
     }
-    if (absolute_time_diff_us(sol_sumindo_ultimo_frame_tempo, get_absolute_time()) < SOL_SUMINDO_FRAME_DELAY_US) return false;
-    sol_sumindo_ultimo_frame_tempo = get_absolute_time();
+    if (absolute_time_diff_us(sol_sumindo_ultimo_frame_tempo, estufa_agora()) < SOL_SUMINDO_FRAME_DELAY_US) return false;
+    sol_sumindo_ultimo_frame_tempo = estufa_agora();
     switch (sol_sumindo_frame_atual) {
         case 1:
             matriz_buffer[xy_to_index(0, 0)] = 0;
@@ -146,12 +159,12 @@ bool matriz_animacao_sol_sumindo() {
 void matriz_iniciar_animacao_agua(void) {
     agua_frame_atual = 0;
     matriz_limpar();
-    agua_ultimo_frame_tempo = get_absolute_time();
+    agua_ultimo_frame_tempo = estufa_agora();
 }
 
 bool matriz_atualizar_animacao_agua(void) {
-    if (absolute_time_diff_us(agua_ultimo_frame_tempo, get_absolute_time()) < AGUA_FRAME_DELAY_US) return false;
-    agua_ultimo_frame_tempo = get_absolute_time();
+    if (absolute_time_diff_us(agua_ultimo_frame_tempo, estufa_agora()) < AGUA_FRAME_DELAY_US) return false;
+    agua_ultimo_frame_tempo = estufa_agora();
     uint32_t cor_agua = urgb_u32(0, 0, AGUA_BRILHO_BASE);
     memset(matriz_buffer, 0, sizeof(matriz_buffer));
     if (agua_frame_atual < 5) {
@@ -18,6 +18,11 @@ void matriz_desenhar_flor(uint8_t brilho);
 void matriz_desenhar_ponto_central(uint8_t r, uint8_t g, uint8_t b);
 
 
+// --- Composição no Buffer, sem Envio à Matriz ---
+void matriz_compor_sol();
+void matriz_compor_flor(uint8_t brilho);
+
+
 // --- Funções de Animação Não-Bloqueantes ---
 void matriz_iniciar_animacao_fogo(void);
 void matriz_atualizar_animacao_fogo(void);
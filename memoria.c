@@ -0,0 +1,91 @@
+/**
+ * @file memoria.c
+ * @brief Implementação da pintura de pilhas e do relatório de memória.
+ */
+
+#include "memoria.h"
+#include "lwip/opt.h"
+#include "lwip/stats.h"
+#include <malloc.h>
+#include <stdio.h>
+
+// Símbolos do script de ligação do SDK (memmap_default.ld).
+extern uint32_t __StackTop, __StackBottom, __StackOneTop, __StackOneBottom;
+extern uint32_t __scratch_x_end__, __scratch_y_end__;
+extern char __end__, __HeapLimit;
+
+typedef struct {
+    uint32_t *base;    ///< Início da região pintada (fim dos dados do banco de scratch).
+    uint32_t *fundo;   ///< Limite nominal da pilha.
+    uint32_t *topo;
+} regiao_pilha_t;
+
+static regiao_pilha_t regiao(uint nucleo) {
+    // Core 0: SCRATCH_Y; Core 1 (pilha padrão de multicore_launch_core1): SCRATCH_X.
+    if (nucleo == 0) return (regiao_pilha_t){ &__scratch_y_end__, &__StackBottom, &__StackTop };
+    return (regiao_pilha_t){ &__scratch_x_end__, &__StackOneBottom, &__StackOneTop };
+}
+
+static void pintar(uint32_t *de, uint32_t *ate) {
+    for (volatile uint32_t *p = de; p < ate; p++) {
+        *p = MEMORIA_PADRAO_PILHA;
+    }
+}
+
+void __attribute__((noinline)) memoria_pintar_pilha_nucleo0(void) {
+    // Pinta até um pouco abaixo do quadro atual; interrupções que chegarem durante a
+    // pintura só elevam a marca em alguns bytes.
+    uint32_t marca;
+    pintar(regiao(0).base, &marca - 16);
+}
+
+void memoria_pintar_pilha_nucleo1(void) {
+    regiao_pilha_t r = regiao(1);
+    pintar(r.base, r.topo);
+}
+
+uint32_t memoria_pilha_usada(uint nucleo) {
+    regiao_pilha_t r = regiao(nucleo);
+    const uint32_t *p = r.base;
+    while (p < r.topo && *p == MEMORIA_PADRAO_PILHA) p++;
+    return (uint32_t)((uintptr_t)r.topo - (uintptr_t)p);
+}
+
+uint32_t memoria_pilha_tamanho(uint nucleo) {
+    regiao_pilha_t r = regiao(nucleo);
+    return (uint32_t)((uintptr_t)r.topo - (uintptr_t)r.fundo);
+}
+
+int memoria_formatar(char *destino, size_t tamanho) {
+    struct mallinfo m = mallinfo();
+    uint32_t heap_total = (uint32_t)(&__HeapLimit - &__end__);
+    return snprintf(destino, tamanho,
+                    "{\"pilha_c0\":%lu,\"pilha_c0_max\":%lu,\"pilha_c1\":%lu,\"pilha_c1_max\":%lu,"
+                    "\"heap_usado\":%lu,\"heap_livre\":%lu}",
+                    (unsigned long)memoria_pilha_usada(0), (unsigned long)memoria_pilha_tamanho(0),
+                    (unsigned long)memoria_pilha_usada(1), (unsigned long)memoria_pilha_tamanho(1),
+                    (unsigned long)m.uordblks, (unsigned long)(heap_total - m.uordblks));
+}
+
+void memoria_imprimir(void) {
+    for (uint n = 0; n < 2; n++) {
+        uint32_t usada = memoria_pilha_usada(n), tamanho = memoria_pilha_tamanho(n);
+        printf("[memoria] pilha c%u: %lu/%lu bytes (%lu%%)%s\n", n, (unsigned long)usada, (unsigned long)tamanho,
+               (unsigned long)(usada * 100 / tamanho), usada > tamanho ? " ESTOURO" : "");
+    }
+    struct mallinfo m = mallinfo();
+    printf("[memoria] heap: %lu bytes em uso, arena %lu\n", (unsigned long)m.uordblks, (unsigned long)m.arena);
+#if MEM_STATS
+    printf("[memoria] lwip heap: max %lu de %lu, erros %lu\n", (unsigned long)lwip_stats.mem.max,
+           (unsigned long)lwip_stats.mem.avail, (unsigned long)lwip_stats.mem.err);
+#endif
+#if MEMP_STATS
+    for (int i = 0; i < MEMP_MAX; i++) {
+        const struct stats_mem *s = lwip_stats.memp[i];
+        if (s) {
+            printf("[memoria] pool %-16s max %3lu de %3lu, erros %lu\n", s->name, (unsigned long)s->max,
+                   (unsigned long)s->avail, (unsigned long)s->err);
+        }
+    }
+#endif
+}
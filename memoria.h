@@ -0,0 +1,55 @@
+/**
+ * @file memoria.h
+ * @brief Marcas de maré alta das pilhas dos dois núcleos e ocupação de memória em tempo de execução.
+ *
+ * As pilhas são pintadas com um padrão conhecido no boot; a maré alta é a distância entre
+ * o topo e a primeira palavra ainda intacta. A região pintada vai até o fim dos dados do
+ * banco de scratch, abaixo do tamanho nominal da pilha, para que um estouro também apareça
+ * (uso acima de 100%). O uso estático por arquivo vem do mapa do linker, pelo alvo
+ * `relatorio_memoria` do CMake (tools/relatorio_memoria.py).
+ */
+
+#ifndef MEMORIA_H
+#define MEMORIA_H
+
+#include "pico/stdlib.h" // Para tipos básicos
+#include <stddef.h>
+
+#define MEMORIA_PADRAO_PILHA 0xA5A5A5A5u
+
+/**
+ * @brief Pinta a pilha livre do Core 0. Chamar no início de main().
+ */
+void memoria_pintar_pilha_nucleo0(void);
+
+/**
+ * @brief Pinta a pilha do Core 1. Chamar no Core 0, antes de multicore_launch_core1().
+ */
+void memoria_pintar_pilha_nucleo1(void);
+
+/**
+ * @brief Maior uso de pilha observado desde o boot.
+ * @param nucleo 0 ou 1.
+ * @return Bytes usados a partir do topo da pilha.
+ */
+uint32_t memoria_pilha_usada(uint nucleo);
+
+/**
+ * @brief Tamanho nominal da pilha reservado pelo linker.
+ * @param nucleo 0 ou 1.
+ */
+uint32_t memoria_pilha_tamanho(uint nucleo);
+
+/**
+ * @brief Formata em JSON o uso das pilhas e do heap.
+ * @return Número de caracteres escritos (como snprintf).
+ */
+int memoria_formatar(char *destino, size_t tamanho);
+
+/**
+ * @brief Imprime via stdio as pilhas, o heap e, com as estatísticas do LWIP habilitadas
+ * (ESTUFA_PERFIL), o pico de uso de cada pool.
+ */
+void memoria_imprimir(void);
+
+#endif // MEMORIA_H
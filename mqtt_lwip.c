@@ -5,13 +5,18 @@
 #include "mqtt_lwip.h"
 #include "configura_geral.h"
 #include "lwip/apps/mqtt.h"
-#include "pico/multicore.h"
+#include "pico/cyw43_arch.h" // Para cyw43_arch_lwip_begin/end
+#include "comandos_mqtt.h"
+#include "configuracao.h"
 #include <string.h>
 #include <stdio.h>
 
 mqtt_client_t *mqtt_client_data;
-static char mqtt_incoming_topic[128];
 static bool publicacao_em_andamento = false;
+static bool conexao_pendente = false;
+static uint32_t inicio_publicacao_us;
+static mqtt_contadores_t contadores;
+static uint32_t latencia_faixas[MQTT_LATENCIA_FAIXAS];
 
 static void mqtt_incoming_publish_cb(void *arg, const char *topic, u32_t tot_len);
 static void mqtt_incoming_data_cb(void *arg, const u8_t *data, u16_t len, u8_t flags);
@@ -20,11 +25,12 @@ static void mqtt_sub_cb(void *arg, err_t result);
 static void mqtt_pub_request_cb(void *arg, err_t err);
 
 static void mqtt_connection_cb(mqtt_client_t *client_inst, void *arg, mqtt_connection_status_t status) {
+    conexao_pendente = false; // Chamado tanto no aceite quanto na recusa ou queda da sessão
     if (status == MQTT_CONNECT_ACCEPTED) {
-        multicore_fifo_push_blocking(FIFO_CMD_MQTT_CONECTADO << 16);
         mqtt_set_inpub_callback(client_inst, mqtt_incoming_publish_cb, mqtt_incoming_data_cb, NULL);
         static char topico_comando[100];
-        snprintf(topico_comando, sizeof(topico_comando), "%s/%s", DEVICE_ID, TOPICO_BASE_COMANDO_ESTADO);
+        snprintf(topico_comando, sizeof(topico_comando), "%s/%s", configuracao_rede()->device_id, TOPICO_BASE_COMANDO_ESTADO);
+        comandos_mqtt_registrar_topico(topico_comando);
         mqtt_subscribe(client_inst, topico_comando, 1, mqtt_sub_cb, NULL);
     }
 }
@@ -32,43 +38,99 @@ static void mqtt_connection_cb(mqtt_client_t *client_inst, void *arg, mqtt_conne
 static void mqtt_sub_cb(void *arg, err_t result) { (void)arg; }
 
 static void mqtt_incoming_publish_cb(void *arg, const char *topic, u32_t tot_len) {
-    strncpy(mqtt_incoming_topic, topic, sizeof(mqtt_incoming_topic) - 1);
-    mqtt_incoming_topic[sizeof(mqtt_incoming_topic) - 1] = '\0';
+    comandos_mqtt_iniciar_mensagem(topic, tot_len);
 }
 
 static void mqtt_incoming_data_cb(void *arg, const u8_t *data, u16_t len, u8_t flags) {
-    char payload[128];
-    memcpy(payload, data, len);
-    payload[len] = '\0';
-    char topic_esperado[100];
-    snprintf(topic_esperado, sizeof(topic_esperado), "%s/%s", DEVICE_ID, TOPICO_BASE_COMANDO_ESTADO);
-
-    if (strcmp(mqtt_incoming_topic, topic_esperado) == 0) {
-        if (strcmp(payload, "IRRIGAR") == 0) {
-            uint32_t pacote = (FIFO_CMD_MUDAR_ESTADO << 16) | MODO_ESTUFA_IRRIGACAO;
-            multicore_fifo_push_blocking(pacote);
-        }
-    }
+    // O payload é interpretado no próprio buffer do LWIP, fragmento a fragmento.
+    comandos_mqtt_consumir(data, len, (flags & MQTT_DATA_FLAG_LAST) != 0);
 }
 
 static void mqtt_pub_request_cb(void *arg, err_t err) {
     publicacao_em_andamento = false;
+    if (err != ERR_OK) {
+        contadores.falhas_confirmacao++;
+        return;
+    }
+    contadores.confirmadas++;
+    uint32_t ms = (time_us_32() - inicio_publicacao_us) / 1000;
+    uint8_t faixa = 0;
+    while (ms && faixa < MQTT_LATENCIA_FAIXAS - 1) { // Faixa n: ms < 2^n
+        ms >>= 1;
+        faixa++;
+    }
+    latencia_faixas[faixa]++;
 }
 
 void iniciar_mqtt_cliente() {
-    mqtt_client_data = mqtt_client_new();
+    if (conexao_pendente) return;
+    if (!mqtt_client_data) mqtt_client_data = mqtt_client_new();
+    if (!mqtt_client_data || mqtt_client_is_connected(mqtt_client_data)) return;
+    if (publicacao_em_andamento) contadores.perdidas_sessao++;
+    publicacao_em_andamento = false; // Uma publicação pendente não sobrevive à sessão anterior
     char client_id[32];
-    snprintf(client_id, sizeof(client_id), "%s_client", DEVICE_ID);
+    const config_rede_t *rede = configuracao_rede();
+    snprintf(client_id, sizeof(client_id), "%s_client", rede->device_id);
     struct mqtt_connect_client_info_t ci = { .client_id = client_id };
     ip_addr_t broker_ip;
-    ip4addr_aton(MQTT_BROKER_IP, &broker_ip);
-    mqtt_client_connect(mqtt_client_data, &broker_ip, MQTT_BROKER_PORT, mqtt_connection_cb, 0, &ci);
+    IP_ADDR4(&broker_ip, rede->broker_ip[0], rede->broker_ip[1], rede->broker_ip[2], rede->broker_ip[3]);
+    cyw43_arch_lwip_begin();
+    err_t err = mqtt_client_connect(mqtt_client_data, &broker_ip, rede->broker_porta, mqtt_connection_cb, 0, &ci);
+    cyw43_arch_lwip_end();
+    conexao_pendente = (err == ERR_OK);
+}
+
+bool mqtt_esta_conectado(void) {
+    return mqtt_client_data && mqtt_client_is_connected(mqtt_client_data);
+}
+
+bool mqtt_conexao_pendente(void) {
+    return conexao_pendente;
+}
+
+bool publicar_mensagem_mqtt(const char *topico, const char *mensagem, uint8_t qos, bool reter) {
+    if (qos > 0 && publicacao_em_andamento) return false;
+    if (!mqtt_client_data || !mqtt_client_is_connected(mqtt_client_data)) {
+        contadores.recusadas++;
+        return false;
+    }
+    // Em QoS 0 não há o que esperar: sem callback, a mensagem só ocupa o buffer de saída.
+    err_t err = mqtt_publish(mqtt_client_data, topico, mensagem, strlen(mensagem), qos, reter,
+                             qos > 0 ? mqtt_pub_request_cb : NULL, NULL);
+    if (err != ERR_OK) { // ERR_MEM: buffer de saída cheio; a mensagem continua na fila
+        contadores.recusadas++;
+        return false;
+    }
+    contadores.publicadas++;
+    if (qos > 0) {
+        inicio_publicacao_us = time_us_32();
+        publicacao_em_andamento = true;
+    }
+    return true;
+}
+
+const mqtt_contadores_t *mqtt_contadores(void) {
+    return &contadores;
+}
+
+uint32_t mqtt_latencia_percentil_ms(uint8_t percentil) {
+    uint32_t total = 0;
+    for (int i = 0; i < MQTT_LATENCIA_FAIXAS; i++) total += latencia_faixas[i];
+    if (total == 0) return 0;
+    uint32_t alvo = (uint32_t)(((uint64_t)total * percentil + 99) / 100);
+    uint32_t acumulado = 0;
+    int faixa = 0;
+    for (; faixa < MQTT_LATENCIA_FAIXAS - 1; faixa++) {
+        acumulado += latencia_faixas[faixa];
+        if (acumulado >= alvo) break;
+    }
+    return 1u << faixa;
 }
 
-void publicar_mensagem_mqtt(const char *topico, const char *mensagem) {
-    if (!mqtt_client_data || !mqtt_client_is_connected(mqtt_client_data) || publicacao_em_andamento) return;
-    err_t err = mqtt_publish(mqtt_client_data, topico, mensagem, strlen(mensagem), 1, 0, mqtt_pub_request_cb, NULL);
-    if (err == ERR_OK) publicacao_em_andamento = true;
+void mqtt_latencia_reiniciar(void) {
+    cyw43_arch_lwip_begin(); // O callback de PUBACK roda no contexto da pilha de rede
+    memset(latencia_faixas, 0, sizeof(latencia_faixas));
+    cyw43_arch_lwip_end();
 }
 
 bool mqtt_is_publishing(void) {
@@ -13,23 +13,68 @@
 #include "lwip/apps/mqtt.h" // Para tipos e funções do cliente MQTT LWIP
 
 /**
- * @brief Inicia o cliente MQTT e tenta conectar ao broker.
- * Configura os callbacks para conexão e recebimento de mensagens.
- * Deve ser chamada no Core 1.
+ * @brief Inicia o cliente MQTT (na primeira chamada) e tenta conectar ao broker.
+ * Configura os callbacks para conexão e recebimento de mensagens. Pode ser chamada
+ * novamente após uma queda para refazer a sessão. Deve ser chamada no Core 1.
  */
 void iniciar_mqtt_cliente(void);
 
+/**
+ * @brief Indica se a sessão com o broker está estabelecida.
+ */
+bool mqtt_esta_conectado(void);
+
+/**
+ * @brief Indica se uma tentativa de conexão ainda aguarda resposta do broker.
+ */
+bool mqtt_conexao_pendente(void);
+
 /**
  * @brief Publica uma mensagem MQTT em um tópico específico.
- * A publicação será enfileirada se uma publicação anterior ainda estiver em andamento.
+ * Mensagens QoS 0 são entregues ao buffer de saída do cliente sem esperar confirmação.
+ * Só uma mensagem QoS 1 fica em voo por vez: enquanto o PUBACK não chega, novas
+ * publicações QoS 1 são recusadas.
  * @param topico O tópico MQTT para publicar.
  * @param mensagem A mensagem a ser publicada.
+ * @param qos Nível de QoS (0 ou 1).
+ * @param reter Flag retain da publicação.
+ * @return true se a mensagem foi aceita pelo cliente; false se deve ser tentada de novo.
+ */
+bool publicar_mensagem_mqtt(const char *topico, const char *mensagem, uint8_t qos, bool reter);
+
+#define MQTT_LATENCIA_FAIXAS 17 // Faixas de 2^n ms: <1, <2, <4, ... <32768 ms e acima
+
+/**
+ * @struct mqtt_contadores_t
+ * @brief Contadores do caminho de publicação desde o boot (incrementos simples, sempre ativos).
+ */
+typedef struct {
+    uint32_t publicadas;        ///< Mensagens aceitas pelo cliente MQTT.
+    uint32_t confirmadas;       ///< PUBACKs recebidos (QoS 1).
+    uint32_t recusadas;         ///< Tentativas recusadas (desconectado ou buffer cheio); a mensagem é tentada de novo.
+    uint32_t falhas_confirmacao; ///< QoS 1 sem PUBACK (timeout do cliente): mensagem perdida.
+    uint32_t perdidas_sessao;   ///< QoS 1 em voo quando a sessão caiu: mensagem perdida.
+} mqtt_contadores_t;
+
+/**
+ * @brief Contadores do caminho de publicação.
+ */
+const mqtt_contadores_t *mqtt_contadores(void);
+
+/**
+ * @brief Estima um percentil da latência de PUBACK na janela atual, pelo histograma em faixas de 2^n ms.
+ * @param percentil 1 a 100.
+ * @return Limite superior da faixa que contém o percentil (ms), ou 0 sem confirmações na janela.
+ */
+uint32_t mqtt_latencia_percentil_ms(uint8_t percentil);
+
+/**
+ * @brief Zera o histograma de latência de PUBACK, iniciando uma nova janela.
  */
-void publicar_mensagem_mqtt(const char *topico, const char *mensagem);
+void mqtt_latencia_reiniciar(void);
 
 /**
- * @brief Verifica se há uma publicação MQTT em andamento.
- * Usado para evitar sobrecarga de publicações.
+ * @brief Verifica se há uma publicação QoS 1 aguardando confirmação do broker.
  * @return true se uma publicação estiver em andamento, false caso contrário.
  */
 bool mqtt_is_publishing(void);
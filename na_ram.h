@@ -0,0 +1,28 @@
+/**
+ * @file na_ram.h
+ * @brief Marcação dos caminhos quentes executados da SRAM em vez da flash (XIP).
+ *
+ * Os dois núcleos disputam a cache de 16 KB do XIP, e o Core 1 ainda percorre o LWIP e o
+ * driver do CYW43. Um erro de cache custa uma leitura QSPI inteira, o que aparece como
+ * jitter no laço e nas interrupções. As funções marcadas com NA_RAM() são copiadas para a
+ * SRAM no boot (seção .time_critical do SDK). Com ESTUFA_NA_RAM=0 elas voltam para a flash,
+ * o que permite comparar as duas situações pelos contadores de cache_xip.h.
+ */
+
+#ifndef NA_RAM_H
+#define NA_RAM_H
+
+#include "pico/platform.h" // Para __not_in_flash_func
+
+#ifndef ESTUFA_NA_RAM
+#define ESTUFA_NA_RAM 1
+#endif
+
+#if ESTUFA_NA_RAM
+/** @brief Coloca a função na SRAM. Uso: void NA_RAM(nome)(args) { ... } */
+#define NA_RAM(nome) __not_in_flash_func(nome)
+#else
+#define NA_RAM(nome) nome
+#endif
+
+#endif // NA_RAM_H
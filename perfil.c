@@ -0,0 +1,96 @@
+/**
+ * @file perfil.c
+ * @brief Implementação dos histogramas de latência por fase do laço principal.
+ */
+
+#include "perfil.h"
+
+#if ESTUFA_PERFIL
+
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @struct estatistica_fase_t
+ * @brief Estatísticas acumuladas de uma fase.
+ */
+typedef struct {
+    uint32_t contagem;
+    uint64_t soma_us;
+    uint32_t max_us;
+    uint32_t faixas[PERFIL_NUM_FAIXAS]; ///< faixas[k] conta medições em [2^(k-1), 2^k) µs
+} estatistica_fase_t;
+
+static estatistica_fase_t estatisticas[PERFIL_NUM_FASES];
+
+static const char *const nomes_fase[PERFIL_NUM_FASES] = {
+    [PERFIL_FASE_LACO] = "laco",
+    [PERFIL_FASE_FIFO] = "fifo",
+    [PERFIL_FASE_BOTAO] = "botao",
+    [PERFIL_FASE_SENSORES] = "sensores",
+    [PERFIL_FASE_ESTADOS] = "estados",
+    [PERFIL_FASE_DISPLAY] = "display",
+    [PERFIL_FASE_MATRIZ] = "matriz",
+    [PERFIL_FASE_HEARTBEAT] = "heartbeat",
+};
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Índice da faixa logarítmica: número de bits significativos da duração.
+ */
+static inline uint8_t faixa_de(uint32_t duracao_us) {
+    uint8_t k = duracao_us ? (uint8_t)(32 - __builtin_clz(duracao_us)) : 0;
+    return k < PERFIL_NUM_FAIXAS ? k : PERFIL_NUM_FAIXAS - 1;
+}
+
+/**
+ * @brief Estima um percentil pelo limite superior da faixa que o contém.
+ * @param e Estatísticas da fase.
+ * @param permil Percentil em milésimos (ex: 990 para p99).
+ */
+static uint32_t percentil(const estatistica_fase_t *e, uint32_t permil) {
+    uint32_t alvo = (uint32_t)(((uint64_t)e->contagem * permil + 999) / 1000);
+    uint32_t acumulado = 0;
+    for (uint8_t k = 0; k < PERFIL_NUM_FAIXAS; k++) {
+        acumulado += e->faixas[k];
+        if (acumulado >= alvo) {
+            uint32_t limite = k ? (1u << k) - 1 : 0;
+            return limite < e->max_us ? limite : e->max_us;
+        }
+    }
+    return e->max_us;
+}
+
+// --- Implementação das Funções Públicas ---
+
+void perfil_registrar(uint8_t fase, uint32_t duracao_us) {
+    estatistica_fase_t *e = &estatisticas[fase];
+    e->contagem++;
+    e->soma_us += duracao_us;
+    if (duracao_us > e->max_us) e->max_us = duracao_us;
+    e->faixas[faixa_de(duracao_us)]++;
+}
+
+void perfil_imprimir(void) {
+    printf("[perfil] fase        n       media     p50     p90     p99     max (us)\n");
+    for (uint8_t f = 0; f < PERFIL_NUM_FASES; f++) {
+        const estatistica_fase_t *e = &estatisticas[f];
+        if (e->contagem == 0) continue;
+        printf("  %-10s %8lu %9lu %7lu %7lu %7lu %7lu\n", nomes_fase[f],
+               (unsigned long)e->contagem, (unsigned long)(e->soma_us / e->contagem),
+               (unsigned long)percentil(e, 500), (unsigned long)percentil(e, 900),
+               (unsigned long)percentil(e, 990), (unsigned long)e->max_us);
+        printf("    hist:");
+        for (uint8_t k = 0; k < PERFIL_NUM_FAIXAS; k++) {
+            if (e->faixas[k]) printf(" <%lu:%lu", (unsigned long)(1u << k), (unsigned long)e->faixas[k]);
+        }
+        printf("\n");
+    }
+}
+
+void perfil_zerar(void) {
+    memset(estatisticas, 0, sizeof(estatisticas));
+}
+
+#endif // ESTUFA_PERFIL
@@ -0,0 +1,68 @@
+/**
+ * @file perfil.h
+ * @brief Instrumentação das fases do laço principal do Core 0.
+ * Cada fase é cronometrada com o timer de microssegundos e acumulada em um
+ * histograma de escala logarítmica (potências de 2), com máximo e percentis.
+ * Removível em tempo de compilação: com ESTUFA_PERFIL=0 as macros não geram código.
+ */
+
+#ifndef PERFIL_H
+#define PERFIL_H
+
+#include "pico/stdlib.h" // Para time_us_32
+
+#ifndef ESTUFA_PERFIL
+#define ESTUFA_PERFIL 0
+#endif
+
+#define PERFIL_NUM_FAIXAS 22 // Faixas do histograma: [0], [1], [2-3], [4-7], ... até >= 2^20 µs
+
+/**
+ * @brief Fases instrumentadas do laço principal.
+ */
+enum FasePerfil {
+    PERFIL_FASE_LACO,      ///< Iteração completa do laço.
+    PERFIL_FASE_FIFO,      ///< verificar_fifo().
+    PERFIL_FASE_BOTAO,     ///< Leitura e tratamento do Botão B.
+    PERFIL_FASE_SENSORES,  ///< Leitura dos sensores e envio ao Core 1.
+    PERFIL_FASE_ESTADOS,   ///< Máquina de estados (inclui display e matriz).
+    PERFIL_FASE_DISPLAY,   ///< display_show_message().
+    PERFIL_FASE_MATRIZ,    ///< Envio do quadro para a matriz de LEDs.
+    PERFIL_FASE_HEARTBEAT, ///< Heartbeat e relatórios periódicos.
+    PERFIL_NUM_FASES
+};
+
+#if ESTUFA_PERFIL
+
+/** @brief Marca o início de uma fase, guardando o instante na variável indicada. */
+#define PERFIL_INICIO(var) uint32_t var = time_us_32()
+/** @brief Marca o fim de uma fase iniciada com PERFIL_INICIO(var). */
+#define PERFIL_FIM(fase, var) perfil_registrar((fase), time_us_32() - (var))
+
+/**
+ * @brief Acumula uma medição na fase indicada. Use pelas macros acima.
+ * @param fase Valor de enum FasePerfil.
+ * @param duracao_us Duração medida em microssegundos.
+ */
+void perfil_registrar(uint8_t fase, uint32_t duracao_us);
+
+/**
+ * @brief Imprime via stdio contagem, média, máximo, p50/p90/p99 e o histograma de cada fase.
+ */
+void perfil_imprimir(void);
+
+/**
+ * @brief Zera todas as estatísticas.
+ */
+void perfil_zerar(void);
+
+#else
+
+#define PERFIL_INICIO(var) do { } while (0)
+#define PERFIL_FIM(fase, var) do { } while (0)
+static inline void perfil_imprimir(void) { }
+static inline void perfil_zerar(void) { }
+
+#endif // ESTUFA_PERFIL
+
+#endif // PERFIL_H
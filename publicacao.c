@@ -0,0 +1,384 @@
+/**
+ * @file publicacao.c
+ * @brief Implementação da fila de publicações e da formatação das mensagens MQTT.
+ */
+
+#include "publicacao.h"
+#include "na_ram.h"
+#include "configuracao.h"
+#include "tempos_boot.h"
+#include "supervisor.h"
+#include "energia.h"
+#include "memoria.h"
+#include "cache_xip.h"
+#include "relogio.h"
+#include "mqtt_lwip.h"
+#include "formato.h"
+#include "latencia.h"
+#include "configura_geral.h"
+#include <stdio.h>
+#include <string.h>
+
+// Últimas leituras vistas pelo Core 1, para o retrato de estado (temperatura, umidade, luz, solo)
+static uint16_t ultima_leitura[4];
+static uint32_t mensagens_truncadas; // Mensagens ou tópicos que não couberam nos buffers
+
+static const char *const nomes_modo[NUM_MODOS] = {
+    [MODO_ESTUFA_OK] = "ESTUFA_OK",
+    [MODO_ESTUFA_ALERTA_LUZ] = "ALERTA_LUZ",
+    [MODO_ESTUFA_PROTEGENDO] = "PROTEGENDO",
+    [MODO_ESTUFA_PROTEGIDO] = "PROTEGIDO",
+    [MODO_ESTUFA_IRRIGACAO] = "IRRIGACAO",
+    [MODO_MSG_IRRIGACAO_FIM] = "IRRIGACAO_FIM",
+};
+
+static const char *const nomes_prioridade[NUM_PRIORIDADES] = { "alarme", "evento", "telemetria" };
+
+// Política de entrega por classe: telemetria frequente não ocupa a única publicação
+// QoS 1 em voo, e os tópicos de estado ficam retidos para painéis que conectam depois.
+static const politica_publicacao_t politicas[NUM_CLASSES_PUBLICACAO] = {
+    [PUB_TELEMETRIA]  = { .qos = 0, .reter = false, .prioridade = PRIORIDADE_TELEMETRIA },
+    [PUB_LEITURA]     = { .qos = 0, .reter = true,  .prioridade = PRIORIDADE_TELEMETRIA },
+    [PUB_ALARME]      = { .qos = 1, .reter = true,  .prioridade = PRIORIDADE_ALARME },
+    [PUB_EVENTO]      = { .qos = 1, .reter = false, .prioridade = PRIORIDADE_EVENTO },
+    [PUB_ESTADO]      = { .qos = 1, .reter = true,  .prioridade = PRIORIDADE_EVENTO },
+    [PUB_DIAGNOSTICO] = { .qos = 0, .reter = false, .prioridade = PRIORIDADE_TELEMETRIA },
+};
+
+// --- Fila com Prioridades ---
+
+static inline void anel_inserir(anel_prioridade_t *anel, uint8_t posicao) {
+    anel->posicoes[(anel->inicio + anel->quantidade) % FILA_PUBLICACAO_TAM] = posicao;
+    anel->quantidade++;
+}
+
+static inline uint8_t anel_retirar(anel_prioridade_t *anel) {
+    uint8_t posicao = anel->posicoes[anel->inicio];
+    anel->inicio = (anel->inicio + 1) % FILA_PUBLICACAO_TAM;
+    anel->quantidade--;
+    return posicao;
+}
+
+/**
+ * @brief Maior prioridade com mensagens, ou NUM_PRIORIDADES se a fila está vazia.
+ */
+static inline uint8_t primeira_prioridade(const fila_publicacao_t *fila) {
+    uint8_t p = 0;
+    while (p < NUM_PRIORIDADES && fila->aneis[p].quantidade == 0) p++;
+    return p;
+}
+
+void fila_publicacao_iniciar(fila_publicacao_t *fila) {
+    for (uint8_t i = 0; i < FILA_PUBLICACAO_TAM; i++) {
+        fila->livres[i] = FILA_PUBLICACAO_TAM - 1 - i;
+    }
+    fila->num_livres = FILA_PUBLICACAO_TAM;
+    fila->pico = 0;
+    memset(fila->aneis, 0, sizeof(fila->aneis));
+    memset(fila->estatisticas, 0, sizeof(fila->estatisticas));
+}
+
+publicacao_t *NA_RAM(fila_publicacao_reservar)(fila_publicacao_t *fila) {
+    // A confirmação sempre deixa ao menos uma posição livre para a próxima reserva.
+    return &fila->itens[fila->livres[fila->num_livres - 1]];
+}
+
+void NA_RAM(fila_publicacao_confirmar)(fila_publicacao_t *fila) {
+    uint8_t posicao = fila->livres[--fila->num_livres];
+    publicacao_t *pub = &fila->itens[posicao];
+    pub->enfileirada_us = time_us_32();
+    uint8_t prioridade = publicacao_politica(pub->classe)->prioridade;
+    anel_inserir(&fila->aneis[prioridade], posicao);
+    fila->estatisticas[prioridade].enfileiradas++;
+    if (FILA_PUBLICACAO_TAM - fila->num_livres > fila->pico) fila->pico = FILA_PUBLICACAO_TAM - fila->num_livres;
+
+    if (fila->num_livres == 0) {
+        // A própria mensagem nova está no anel da sua prioridade: sempre há uma vítima.
+        for (int p = NUM_PRIORIDADES - 1; p >= prioridade; p--) {
+            if (fila->aneis[p].quantidade) {
+                fila->livres[fila->num_livres++] = anel_retirar(&fila->aneis[p]);
+                fila->estatisticas[p].expulsas++;
+                break;
+            }
+        }
+    }
+}
+
+uint8_t fila_publicacao_livre(const fila_publicacao_t *fila) {
+    return (uint8_t)(fila->num_livres - 1);
+}
+
+const publicacao_t *NA_RAM(fila_publicacao_proxima)(const fila_publicacao_t *fila) {
+    uint8_t p = primeira_prioridade(fila);
+    if (p == NUM_PRIORIDADES) return NULL;
+    const anel_prioridade_t *anel = &fila->aneis[p];
+    return &fila->itens[anel->posicoes[anel->inicio]];
+}
+
+void NA_RAM(fila_publicacao_descartar)(fila_publicacao_t *fila) {
+    uint8_t p = primeira_prioridade(fila);
+    if (p == NUM_PRIORIDADES) return;
+    uint8_t posicao = anel_retirar(&fila->aneis[p]);
+    fila->livres[fila->num_livres++] = posicao;
+
+    estatisticas_prioridade_t *e = &fila->estatisticas[p];
+    uint32_t latencia = time_us_32() - fila->itens[posicao].enfileirada_us;
+    e->publicadas++;
+    e->latencia_soma_us += latencia;
+    if (latencia > e->latencia_max_us) e->latencia_max_us = latencia;
+}
+
+void fila_publicacao_imprimir(const fila_publicacao_t *fila) {
+    for (uint8_t p = 0; p < NUM_PRIORIDADES; p++) {
+        const estatisticas_prioridade_t *e = &fila->estatisticas[p];
+        uint32_t media = e->publicadas ? (uint32_t)(e->latencia_soma_us / e->publicadas) : 0;
+        printf("[fila] %-10s na_fila=%u publicadas=%lu expulsas=%lu latencia media=%lu us max=%lu us\n",
+               nomes_prioridade[p], fila->aneis[p].quantidade, (unsigned long)e->publicadas,
+               (unsigned long)e->expulsas, (unsigned long)media, (unsigned long)e->latencia_max_us);
+    }
+}
+
+const politica_publicacao_t *NA_RAM(publicacao_politica)(uint8_t classe) {
+    return &politicas[classe < NUM_CLASSES_PUBLICACAO ? classe : PUB_DIAGNOSTICO];
+}
+
+// --- Formatação ---
+
+/**
+ * @brief Termina uma formatação, contando as que não couberam no destino.
+ */
+static void concluir(const formato_t *f) {
+    if (!formato_completo(f)) mensagens_truncadas++;
+}
+
+/**
+ * @brief Monta o tópico de uma zona: a zona principal mantém os tópicos de sempre
+ * (<id>/<sufixo>); as demais ganham o prefixo zona<n> (<id>/zona<n>/<sufixo>).
+ */
+static void formatar_topico_zona(publicacao_t *pub, uint8_t zona, const char *sufixo) {
+    formato_t f;
+    formato_iniciar(&f, pub->topico, sizeof(pub->topico));
+    formato_texto(&f, configuracao_rede()->device_id);
+    if (zona != 0) {
+        formato_texto(&f, "/zona");
+        formato_uint(&f, zona);
+    }
+    formato_caractere(&f, '/');
+    formato_texto(&f, sufixo);
+    concluir(&f);
+}
+
+/**
+ * @brief Acrescenta um campo JSON em centésimos ("-12.05"), ou null se ausente.
+ */
+static void campo_c100(formato_t *f, const char *chave, int32_t valor, bool presente) {
+    formato_texto(f, chave);
+    if (presente) {
+        formato_decimal(f, valor, 2);
+    } else {
+        formato_texto(f, "null");
+    }
+}
+
+bool publicacao_formatar_evento(uint8_t tipo_msg, uint8_t valor, publicacao_t *pub) {
+    const char *base_topic;
+    pub->classe = PUB_DIAGNOSTICO;
+    switch ((enum MQTT_MSG_TYPE)tipo_msg) {
+        case MSG_ALARM_LUZ_ON:
+            base_topic = "alarme";
+            pub->classe = PUB_ALARME;
+            strcpy(pub->mensagem, "{\"alarme\":\"luminosidade\", \"status\":\"ativo\"}");
+            break;
+        case MSG_ALARM_LUZ_OFF:
+            base_topic = "alarme";
+            pub->classe = PUB_ALARME;
+            strcpy(pub->mensagem, "{\"alarme\":\"luminosidade\", \"status\":\"ok\"}");
+            break;
+        case MSG_LOG_HEARTBEAT:
+            base_topic = TOPICO_HEARTBEAT;
+            strcpy(pub->mensagem, "ok");
+            break;
+        case MSG_ENERGIA:
+            base_topic = TOPICO_ENERGIA;
+            energia_formatar(pub->mensagem, sizeof(pub->mensagem));
+            break;
+        case MSG_MEMORIA:
+            base_topic = TOPICO_MEMORIA;
+            memoria_formatar(pub->mensagem, sizeof(pub->mensagem));
+            break;
+        case MSG_XIP:
+            base_topic = TOPICO_XIP;
+            cache_xip_formatar(pub->mensagem, sizeof(pub->mensagem));
+            break;
+        case MSG_STATUS:
+            publicacao_formatar_status(valor, pub);
+            return true;
+        case MSG_IRRIGACAO_AUTO: {
+            base_topic = TOPICO_IRRIGACAO;
+            pub->classe = PUB_EVENTO;
+            formato_t f;
+            formato_iniciar(&f, pub->mensagem, sizeof(pub->mensagem));
+            formato_texto(&f, "{\"origem\":\"auto\", \"duracao_s\":");
+            formato_uint(&f, valor);
+            formato_caractere(&f, '}');
+            concluir(&f);
+            break;
+        }
+        default:
+            return false;
+    }
+    formatar_topico_zona(pub, 0, base_topic);
+    return true;
+}
+
+bool publicacao_formatar_sensor(uint16_t comando, uint16_t valor, uint8_t zona, publicacao_t *pub) {
+    if (zona == 0 && comando >= FIFO_CMD_PUB_SENSOR_TEMP && comando <= FIFO_CMD_PUB_SENSOR_SOLO) {
+        ultima_leitura[comando - FIFO_CMD_PUB_SENSOR_TEMP] = valor;
+    }
+    pub->classe = PUB_LEITURA;
+    formato_t f;
+    formato_iniciar(&f, pub->mensagem, sizeof(pub->mensagem));
+    if (comando == FIFO_CMD_PUB_SENSOR_TEMP) {
+        formato_decimal(&f, (int16_t)valor, 2);
+        formatar_topico_zona(pub, zona, "sensores/temperatura");
+    } else if (comando == FIFO_CMD_PUB_SENSOR_UMID) {
+        formato_decimal(&f, valor, 2);
+        formatar_topico_zona(pub, zona, "sensores/umidade");
+    } else if (comando == FIFO_CMD_PUB_SENSOR_LUZ) {
+        formato_uint(&f, valor);
+        formatar_topico_zona(pub, zona, "sensores/luminosidade");
+    } else if (comando == FIFO_CMD_PUB_SENSOR_SOLO) {
+        formato_decimal(&f, valor, 2);
+        formatar_topico_zona(pub, zona, "sensores/solo");
+    } else {
+        return false;
+    }
+    concluir(&f);
+    return true;
+}
+
+void publicacao_formatar_amostra(const amostra_t *amostra, publicacao_t *pub) {
+    // Campos ausentes saem como null; o horário é calculado agora, a partir do instante da aquisição.
+    pub->classe = PUB_TELEMETRIA;
+    pub->origem_us = (uint32_t)amostra->tempo_us; // Os 32 bits baixos de time_us_64() são time_us_32()
+    formato_t f;
+    formato_iniciar(&f, pub->mensagem, sizeof(pub->mensagem));
+    formato_texto(&f, "{\"ts\":");
+    formato_uint64(&f, relogio_epoch_ms(amostra->tempo_us));
+    formato_texto(&f, ",\"mono_ms\":");
+    formato_uint64(&f, amostra->tempo_us / 1000);
+    formato_texto(&f, ",\"sinc\":");
+    formato_uint(&f, relogio_sincronizado());
+    campo_c100(&f, ",\"temp\":", amostra->temp_c100, amostra->validos & AMOSTRA_TEMP);
+    campo_c100(&f, ",\"umid\":", amostra->umid_c100, amostra->validos & AMOSTRA_UMID);
+    formato_texto(&f, ",\"lux\":");
+    if (amostra->validos & AMOSTRA_LUZ) {
+        formato_uint(&f, amostra->luz_mlux / 1000u);
+    } else {
+        formato_texto(&f, "null");
+    }
+    campo_c100(&f, ",\"solo\":", amostra->solo_c100, amostra->validos & AMOSTRA_SOLO);
+    formato_caractere(&f, '}');
+    concluir(&f);
+    formatar_topico_zona(pub, amostra->zona, TOPICO_AMOSTRA);
+}
+
+void publicacao_formatar_status(uint8_t valor, publicacao_t *pub) {
+    uint8_t modo = valor & 0x7F;
+    pub->classe = PUB_ESTADO;
+    formato_t f;
+    formato_iniciar(&f, pub->mensagem, sizeof(pub->mensagem));
+    formato_texto(&f, "{\"modo\":\"");
+    formato_texto(&f, modo < NUM_MODOS ? nomes_modo[modo] : "?");
+    formato_texto(&f, "\",\"alarme_luz\":");
+    formato_uint(&f, valor >> 7);
+    campo_c100(&f, ",\"temp\":", (int16_t)ultima_leitura[0], true);
+    campo_c100(&f, ",\"umid\":", ultima_leitura[1], true);
+    formato_texto(&f, ",\"lux\":");
+    formato_uint(&f, ultima_leitura[2]);
+    campo_c100(&f, ",\"solo\":", ultima_leitura[3], true);
+    formato_caractere(&f, '}');
+    concluir(&f);
+    formatar_topico_zona(pub, 0, TOPICO_STATUS);
+}
+
+/**
+ * @brief Acrescenta um campo JSON inteiro sem sinal.
+ */
+static void campo_uint(formato_t *f, const char *chave, uint32_t valor) {
+    formato_texto(f, chave);
+    formato_uint(f, valor);
+}
+
+void publicacao_formatar_rede(const fila_publicacao_t *fila, publicacao_t *pub) {
+    uint32_t enfileiradas = 0, expulsas = 0;
+    for (uint8_t p = 0; p < NUM_PRIORIDADES; p++) {
+        enfileiradas += fila->estatisticas[p].enfileiradas;
+        expulsas += fila->estatisticas[p].expulsas;
+    }
+    const mqtt_contadores_t *c = mqtt_contadores();
+    pub->classe = PUB_DIAGNOSTICO;
+    formato_t f;
+    formato_iniciar(&f, pub->mensagem, sizeof(pub->mensagem));
+    campo_uint(&f, "{\"enf\":", enfileiradas);
+    campo_uint(&f, ",\"pub\":", c->publicadas);
+    campo_uint(&f, ",\"ack\":", c->confirmadas);
+    campo_uint(&f, ",\"retent\":", c->recusadas);
+    // Perdas por motivo: expulsa da fila cheia, amostra sem espaço na fila entre os núcleos,
+    // texto truncado, QoS 1 sem PUBACK e QoS 1 em voo na queda da sessão.
+    campo_uint(&f, ",\"exp\":", expulsas);
+    campo_uint(&f, ",\"amostras\":", amostras_descartadas());
+    campo_uint(&f, ",\"trunc\":", mensagens_truncadas);
+    campo_uint(&f, ",\"ack_falha\":", c->falhas_confirmacao);
+    campo_uint(&f, ",\"sessao\":", c->perdidas_sessao);
+    campo_uint(&f, ",\"fila_max\":", fila->pico);
+    campo_uint(&f, ",\"ack_p50\":", mqtt_latencia_percentil_ms(50));
+    campo_uint(&f, ",\"ack_p90\":", mqtt_latencia_percentil_ms(90));
+    campo_uint(&f, ",\"ack_p99\":", mqtt_latencia_percentil_ms(99));
+    formato_caractere(&f, '}');
+    concluir(&f);
+    mqtt_latencia_reiniciar();
+    formatar_topico_zona(pub, 0, TOPICO_DIAGNOSTICO_REDE);
+}
+
+void publicacao_formatar_latencia(publicacao_t *pub) {
+    pub->classe = PUB_DIAGNOSTICO;
+    latencia_formatar(pub->mensagem, sizeof(pub->mensagem));
+    formatar_topico_zona(pub, 0, TOPICO_DIAGNOSTICO_LATENCIA);
+}
+
+void publicacao_formatar_boot(publicacao_t *pub) {
+    pub->classe = PUB_ESTADO;
+    tempos_boot_formatar(pub->mensagem, sizeof(pub->mensagem));
+    formatar_topico_zona(pub, 0, TOPICO_BOOT);
+}
+
+void publicacao_formatar_reset(publicacao_t *pub) {
+    static const char *const motivos[] = { "energia", "watchdog", "software" };
+    static const char *const causas[] = { "nenhuma", "c0_lento", "c1_parado" };
+    const relatorio_reset_t *r = supervisor_ultimo_reset();
+    pub->classe = PUB_ESTADO;
+    formato_t f;
+    formato_iniciar(&f, pub->mensagem, sizeof(pub->mensagem));
+    formato_texto(&f, "{\"motivo\":\"");
+    formato_texto(&f, motivos[r->motivo]);
+    if (r->registro_valido) {
+        formato_texto(&f, "\",\"causa\":\"");
+        formato_texto(&f, r->causa < count_of(causas) ? causas[r->causa] : "?");
+        formato_texto(&f, "\",\"fase_c0\":\"");
+        formato_texto(&f, supervisor_nome_fase(0, r->fase_c0));
+        formato_texto(&f, "\",\"fase_c1\":\"");
+        formato_texto(&f, supervisor_nome_fase(1, r->fase_c1));
+        formato_texto(&f, "\",\"ligado_s\":");
+        formato_uint(&f, r->tempo_ligado_s);
+        formato_caractere(&f, '}');
+    } else {
+        formato_texto(&f, "\"}");
+    }
+    concluir(&f);
+    formatar_topico_zona(pub, 0, TOPICO_RESET);
+}
+
+uint32_t publicacao_truncadas(void) {
+    return mensagens_truncadas;
+}
@@ -0,0 +1,220 @@
+/**
+ * @file publicacao.h
+ * @brief Fila de publicações MQTT do Core 1 e formatação de tópicos e mensagens.
+ * As mensagens são formatadas diretamente no espaço reservado da fila, sem cópias
+ * intermediárias. A fila tem três prioridades (alarme, evento, telemetria): a próxima
+ * mensagem é sempre a mais antiga da maior prioridade com mensagens, e, sem espaço,
+ * uma mensagem nova expulsa a mais antiga de prioridade igual ou menor.
+ */
+
+#ifndef PUBLICACAO_H
+#define PUBLICACAO_H
+
+#include "pico/stdlib.h" // Para tipos básicos
+#include "amostras.h"
+
+#define FILA_PUBLICACAO_TAM 10 // Capacidade útil: FILA_PUBLICACAO_TAM - 1 mensagens (uma posição fica para a reserva)
+#define PUBLICACAO_TOPICO_TAM 100
+#define PUBLICACAO_MENSAGEM_TAM 240 // Cabe o diagnóstico de rede com todos os contadores no máximo
+
+/**
+ * @brief Classe de uma publicação, que define o QoS e a retenção (tabela em publicacao.c).
+ */
+enum ClassePublicacao {
+    PUB_TELEMETRIA,  ///< Amostras completas, em alta taxa: QoS 0, sem retenção.
+    PUB_LEITURA,     ///< Última leitura de cada sensor: QoS 0, retida.
+    PUB_ALARME,      ///< Alarmes: QoS 1, retidos (quem entra depois vê o estado atual).
+    PUB_EVENTO,      ///< Eventos pontuais (ex: rega automática): QoS 1, sem retenção.
+    PUB_ESTADO,      ///< Estado do dispositivo (status, boot, reset): QoS 1, retido.
+    PUB_DIAGNOSTICO, ///< Heartbeat e relatórios periódicos: QoS 0, sem retenção.
+    NUM_CLASSES_PUBLICACAO
+};
+
+/**
+ * @brief Prioridade na fila de publicação (0 é a mais alta).
+ */
+enum PrioridadePublicacao {
+    PRIORIDADE_ALARME,     ///< Sempre sai primeiro.
+    PRIORIDADE_EVENTO,     ///< Eventos e estado do dispositivo.
+    PRIORIDADE_TELEMETRIA, ///< Leituras e diagnóstico; as primeiras a serem expulsas.
+    NUM_PRIORIDADES
+};
+
+/**
+ * @struct politica_publicacao_t
+ * @brief Como uma classe de publicação é entregue ao broker.
+ */
+typedef struct {
+    uint8_t qos;        ///< 0 ou 1.
+    bool reter;         ///< Flag retain: o broker guarda a última mensagem do tópico.
+    uint8_t prioridade; ///< Valor de enum PrioridadePublicacao.
+} politica_publicacao_t;
+
+/**
+ * @struct publicacao_t
+ * @brief Mensagem pronta para ser publicada.
+ */
+typedef struct {
+    char topico[PUBLICACAO_TOPICO_TAM];
+    char mensagem[PUBLICACAO_MENSAGEM_TAM];
+    uint8_t classe;          ///< Valor de enum ClassePublicacao, definido pela formatação.
+    uint32_t enfileirada_us; ///< time_us_32() na confirmação, para medir a latência até a publicação.
+    uint32_t origem_us;      ///< time_us_32() da aquisição (só amostras, classe PUB_TELEMETRIA).
+} publicacao_t;
+
+/**
+ * @struct anel_prioridade_t
+ * @brief Posições de itens[] de uma prioridade, em ordem de chegada.
+ */
+typedef struct {
+    uint8_t posicoes[FILA_PUBLICACAO_TAM];
+    uint8_t inicio;
+    uint8_t quantidade;
+} anel_prioridade_t;
+
+/**
+ * @struct estatisticas_prioridade_t
+ * @brief Contadores de uma prioridade desde fila_publicacao_iniciar().
+ */
+typedef struct {
+    uint32_t enfileiradas;     ///< Mensagens confirmadas na fila.
+    uint32_t publicadas;       ///< Mensagens retiradas após a publicação.
+    uint32_t expulsas;         ///< Mensagens descartadas por falta de espaço.
+    uint32_t latencia_max_us;  ///< Maior tempo entre a confirmação e a publicação.
+    uint64_t latencia_soma_us; ///< Soma das latências (média = soma / publicadas).
+} estatisticas_prioridade_t;
+
+/**
+ * @struct fila_publicacao_t
+ * @brief Fila de publicações com prioridades (um produtor e um consumidor, ambos no Core 1).
+ */
+typedef struct {
+    publicacao_t itens[FILA_PUBLICACAO_TAM];
+    uint8_t livres[FILA_PUBLICACAO_TAM]; ///< Pilha de posições livres de itens[].
+    uint8_t num_livres;
+    anel_prioridade_t aneis[NUM_PRIORIDADES];
+    estatisticas_prioridade_t estatisticas[NUM_PRIORIDADES];
+    uint8_t pico; ///< Maior número de mensagens na fila ao mesmo tempo.
+} fila_publicacao_t;
+
+/**
+ * @brief Esvazia a fila.
+ */
+void fila_publicacao_iniciar(fila_publicacao_t *fila);
+
+/**
+ * @brief Reserva uma posição livre para ser preenchida no lugar.
+ * A mensagem só entra na fila após fila_publicacao_confirmar(); a prioridade vem da
+ * classe definida pela formatação. Sempre há uma posição disponível.
+ * @return Ponteiro para a posição reservada.
+ */
+publicacao_t *fila_publicacao_reservar(fila_publicacao_t *fila);
+
+/**
+ * @brief Confirma a posição obtida com fila_publicacao_reservar().
+ * Se a fila ficou cheia, expulsa a mensagem mais antiga da menor prioridade que não
+ * supere a da nova (uma telemetria nova nunca expulsa um alarme; ela mesma é descartada).
+ */
+void fila_publicacao_confirmar(fila_publicacao_t *fila);
+
+/**
+ * @brief Número de mensagens que ainda cabem na fila sem expulsar outras.
+ */
+uint8_t fila_publicacao_livre(const fila_publicacao_t *fila);
+
+/**
+ * @brief Retorna a próxima mensagem a publicar (a mais antiga da maior prioridade)
+ * sem retirá-la, ou NULL se a fila está vazia.
+ */
+const publicacao_t *fila_publicacao_proxima(const fila_publicacao_t *fila);
+
+/**
+ * @brief Retira a mensagem devolvida por fila_publicacao_proxima(), já publicada,
+ * e contabiliza a latência da sua prioridade.
+ */
+void fila_publicacao_descartar(fila_publicacao_t *fila);
+
+/**
+ * @brief Imprime, por prioridade, as mensagens publicadas e expulsas e a latência
+ * entre a confirmação e a publicação (média e máxima).
+ */
+void fila_publicacao_imprimir(const fila_publicacao_t *fila);
+
+/**
+ * @brief Política de entrega de uma classe de publicação.
+ * @param classe Valor de enum ClassePublicacao; valores inválidos recebem a política de diagnóstico.
+ */
+const politica_publicacao_t *publicacao_politica(uint8_t classe);
+
+/**
+ * @brief Formata uma mensagem de evento (alarme, heartbeat, irrigação) solicitada pelo Core 0.
+ * @param tipo_msg Valor de enum MQTT_MSG_TYPE.
+ * @param valor Valor de 8 bits que acompanha o pedido (ex: duração da rega).
+ * @param pub Destino da formatação.
+ * @return false se o tipo de mensagem é desconhecido.
+ */
+bool publicacao_formatar_evento(uint8_t tipo_msg, uint8_t valor, publicacao_t *pub);
+
+/**
+ * @brief Formata uma leitura de sensor enviada pelo Core 0.
+ * A zona principal publica em <id>/sensores/...; as demais em <id>/zona<n>/sensores/...
+ * @param comando FIFO_CMD_PUB_SENSOR_TEMP, _UMID, _LUZ ou _SOLO.
+ * @param valor Valor codificado (centésimos para temperatura e umidades, lux inteiro para luminosidade).
+ * @param zona Zona de origem da leitura (sensores.h).
+ * @param pub Destino da formatação.
+ * @return false se o comando não é de sensor.
+ */
+bool publicacao_formatar_sensor(uint16_t comando, uint16_t valor, uint8_t zona, publicacao_t *pub);
+
+/**
+ * @brief Formata uma amostra completa, com o horário de aquisição, em JSON.
+ * O campo "ts" (ms Unix) é 0 enquanto o relógio não foi sincronizado; "mono_ms"
+ * (ms desde o boot) permite ao consumidor reconstruir o horário depois.
+ * @param amostra Amostra recebida do Core 0.
+ * @param pub Destino da formatação.
+ */
+void publicacao_formatar_amostra(const amostra_t *amostra, publicacao_t *pub);
+
+/**
+ * @brief Formata o retrato de estado pedido pelo comando STATUS.
+ * Inclui o modo atual e as últimas leituras da zona principal.
+ * @param valor Bits 0-6: enum ModoOperacao; bit 7: alarme de luminosidade ativo.
+ * @param pub Destino da formatação.
+ */
+void publicacao_formatar_status(uint8_t valor, publicacao_t *pub);
+
+/**
+ * @brief Formata o diagnóstico do caminho de publicação: mensagens enfileiradas, publicadas,
+ * confirmadas e recusadas (tentadas de novo), perdas por motivo, pico de ocupação da fila e
+ * percentis da latência de PUBACK na janela desde o diagnóstico anterior (que é reiniciada).
+ * Chamada periodicamente pelo Core 1, dono da fila.
+ * @param fila Fila de publicações do Core 1.
+ * @param pub Destino da formatação.
+ */
+void publicacao_formatar_rede(const fila_publicacao_t *fila, publicacao_t *pub);
+
+/**
+ * @brief Formata as latências de ponta a ponta e a vazão de publicações (latencia.h).
+ * Chamada periodicamente pelo Core 1, junto com o diagnóstico da rede.
+ * @param pub Destino da formatação.
+ */
+void publicacao_formatar_latencia(publicacao_t *pub);
+
+/**
+ * @brief Formata o resumo dos tempos de inicialização (tempos_boot.h), publicado uma vez por boot.
+ * @param pub Destino da formatação.
+ */
+void publicacao_formatar_boot(publicacao_t *pub);
+
+/**
+ * @brief Formata o relatório do último reset (supervisor.h), publicado uma vez por boot.
+ * @param pub Destino da formatação.
+ */
+void publicacao_formatar_reset(publicacao_t *pub);
+
+/**
+ * @brief Número de mensagens ou tópicos truncados por não caberem em publicacao_t desde o boot.
+ */
+uint32_t publicacao_truncadas(void);
+
+#endif // PUBLICACAO_H
@@ -0,0 +1,119 @@
+/**
+ * @file rede.c
+ * @brief Implementação da gerência de conectividade.
+ *
+ * CONECTANDO_WIFI -> CONECTANDO_MQTT -> ONLINE. Qualquer falha (associação recusada,
+ * timeout, queda do enlace ou do broker) leva a OFFLINE, de onde uma nova tentativa
+ * parte após um recuo que dobra a cada falha consecutiva.
+ */
+
+#include "rede.h"
+#include "configura_geral.h"
+#include "mqtt_lwip.h"
+#include "tempos_boot.h"
+#include "energia.h"
+#include "pico/cyw43_arch.h"
+#include "pico/multicore.h"
+#include <stdio.h>
+
+static uint8_t estado = REDE_OFFLINE;
+static bool chip_ok;
+static absolute_time_t prazo;           // Timeout da tentativa ou fim do recuo
+static uint32_t recuo_ms = REDE_RECUO_INICIAL_MS;
+static bool boot_registrado;            // Tempos de boot marcados só na primeira conexão
+
+// --- Funções Auxiliares ---
+
+static void mudar_estado(uint8_t novo) {
+    estado = novo;
+    multicore_fifo_push_blocking(((uint32_t)FIFO_CMD_ESTADO_REDE << 16) | novo);
+}
+
+static void tentar_wifi(void) {
+    cyw43_arch_wifi_connect_async(WIFI_SSID, WIFI_PASS, CYW43_AUTH_WPA2_AES_PSK);
+    prazo = make_timeout_time_ms(REDE_TIMEOUT_WIFI_MS);
+    mudar_estado(REDE_CONECTANDO_WIFI);
+}
+
+static void falhar(const char *motivo) {
+    printf("[rede] %s; nova tentativa em %lu ms\n", motivo, (unsigned long)recuo_ms);
+    prazo = make_timeout_time_ms(recuo_ms);
+    recuo_ms = recuo_ms * 2 > REDE_RECUO_MAXIMO_MS ? REDE_RECUO_MAXIMO_MS : recuo_ms * 2;
+    mudar_estado(REDE_OFFLINE);
+}
+
+// --- Implementação das Funções Públicas ---
+
+bool rede_iniciar(void) {
+    chip_ok = cyw43_arch_init() == 0;
+    if (!chip_ok) {
+        printf("[rede] falha ao inicializar o CYW43\n");
+        mudar_estado(REDE_OFFLINE);
+        return false;
+    }
+    cyw43_arch_enable_sta_mode();
+    tempos_boot_marcar("cyw43");
+    tentar_wifi();
+    return true;
+}
+
+bool rede_tarefa(void) {
+    if (!chip_ok) return false;
+    uint8_t anterior = estado;
+    int enlace = cyw43_tcpip_link_status(&cyw43_state, CYW43_ITF_STA);
+
+    switch (estado) {
+        case REDE_CONECTANDO_WIFI:
+            if (enlace == CYW43_LINK_UP) {
+                if (!boot_registrado) tempos_boot_marcar("wifi");
+                iniciar_mqtt_cliente();
+                mudar_estado(REDE_CONECTANDO_MQTT);
+            } else if (enlace == CYW43_LINK_BADAUTH) {
+                falhar("senha do Wi-Fi recusada");
+            } else if (enlace == CYW43_LINK_FAIL || enlace == CYW43_LINK_NONET || time_reached(prazo)) {
+                falhar("Wi-Fi indisponivel");
+            }
+            break;
+        case REDE_CONECTANDO_MQTT:
+            if (enlace != CYW43_LINK_UP) {
+                falhar("enlace Wi-Fi caiu");
+            } else if (mqtt_esta_conectado()) {
+                if (!boot_registrado) {
+                    tempos_boot_marcar("mqtt");
+                    boot_registrado = true;
+                }
+                recuo_ms = REDE_RECUO_INICIAL_MS;
+#if ESTUFA_BAIXO_CONSUMO
+                // Rádio dorme entre os beacons do AP; o tráfego da estufa é esparso.
+                cyw43_wifi_pm(&cyw43_state, CYW43_AGGRESSIVE_PM);
+#endif
+                mudar_estado(REDE_ONLINE);
+            } else if (!mqtt_conexao_pendente()) {
+                falhar("broker MQTT recusou a conexao");
+            }
+            break;
+        case REDE_ONLINE:
+            if (enlace != CYW43_LINK_UP) {
+                falhar("enlace Wi-Fi caiu");
+            } else if (!mqtt_esta_conectado()) {
+                falhar("conexao MQTT perdida");
+            }
+            break;
+        case REDE_OFFLINE:
+            if (time_reached(prazo)) {
+                // Com o enlace ainda de pé, basta refazer a sessão MQTT.
+                if (enlace == CYW43_LINK_UP) {
+                    iniciar_mqtt_cliente();
+                    mudar_estado(REDE_CONECTANDO_MQTT);
+                } else {
+                    tentar_wifi();
+                }
+            }
+            break;
+    }
+    return estado != anterior;
+}
+
+uint8_t rede_estado(void) {
+    return estado;
+}
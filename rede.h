@@ -0,0 +1,34 @@
+/**
+ * @file rede.h
+ * @brief Gerência da conectividade (Core 1): Wi-Fi e MQTT sobem em segundo plano,
+ * com novas tentativas e recuo exponencial, sem bloquear o controle da estufa.
+ * Cada mudança de estado é informada ao Core 0 via FIFO_CMD_ESTADO_REDE.
+ */
+
+#ifndef REDE_H
+#define REDE_H
+
+#include "pico/stdlib.h" // Para tipos básicos
+
+#define REDE_TIMEOUT_WIFI_MS 30000       // Tempo máximo de uma tentativa de associação
+#define REDE_RECUO_INICIAL_MS 2000       // Espera antes da primeira nova tentativa
+#define REDE_RECUO_MAXIMO_MS 60000       // Teto do recuo exponencial
+
+/**
+ * @brief Inicializa o chip Wi-Fi e dispara a primeira tentativa de conexão (não-bloqueante).
+ * @return false se o chip CYW43 não pôde ser inicializado (a estufa segue offline).
+ */
+bool rede_iniciar(void);
+
+/**
+ * @brief Avança a máquina de conexão. Deve ser chamada a cada iteração do laço do Core 1.
+ * @return true se o estado mudou nesta chamada.
+ */
+bool rede_tarefa(void);
+
+/**
+ * @brief Estado atual da conexão (valor de enum EstadoRede).
+ */
+uint8_t rede_estado(void);
+
+#endif // REDE_H
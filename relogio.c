@@ -0,0 +1,70 @@
+/**
+ * @file relogio.c
+ * @brief Implementação do relógio sincronizado por SNTP, com correção de deriva.
+ */
+
+#include "relogio.h"
+#include "configura_geral.h"
+#include "lwip/apps/sntp.h"
+#include "pico/cyw43_arch.h"
+#include "pico/sync.h"
+#include <stdio.h>
+
+// Modelo de conversão. Escrito no contexto do LWIP (interrupção do Core 1) e lido no
+// laço do Core 1: protegido por seção crítica para não ler um modelo pela metade.
+static critical_section_t secao;
+static bool sincronizado;
+static uint64_t base_epoch_us;  // Horário do servidor na última sincronização
+static uint64_t base_mono_us;   // time_us_64() no mesmo instante
+static float deriva_ppm;        // Quanto o cristal local atrasa (+) ou adianta (-)
+
+void relogio_iniciar_sntp(void) {
+    static bool iniciado;
+    if (iniciado) return;
+    iniciado = true;
+    critical_section_init(&secao); // Antes de sntp_init: a resposta pode chegar logo em seguida
+    cyw43_arch_lwip_begin();
+    sntp_setoperatingmode(SNTP_OPMODE_POLL);
+    sntp_setservername(0, SNTP_SERVIDOR);
+    sntp_init();
+    cyw43_arch_lwip_end();
+}
+
+void relogio_sntp_recebido(uint32_t segundos, uint32_t microssegundos) {
+    uint64_t mono = time_us_64();
+    uint64_t epoch = (uint64_t)segundos * 1000000ull + microssegundos;
+
+    critical_section_enter_blocking(&secao);
+    if (sincronizado) {
+        int64_t intervalo_mono = (int64_t)(mono - base_mono_us);
+        if (intervalo_mono >= (int64_t)RELOGIO_INTERVALO_MIN_DERIVA_S * 1000000) {
+            // Deriva medida no intervalo, suavizada para não seguir o jitter da rede.
+            int64_t intervalo_epoch = (int64_t)(epoch - base_epoch_us);
+            float medida = (float)(intervalo_epoch - intervalo_mono) * 1e6f / (float)intervalo_mono;
+            deriva_ppm += 0.25f * (medida - deriva_ppm);
+            if (deriva_ppm > RELOGIO_DERIVA_MAX_PPM) deriva_ppm = RELOGIO_DERIVA_MAX_PPM;
+            if (deriva_ppm < -RELOGIO_DERIVA_MAX_PPM) deriva_ppm = -RELOGIO_DERIVA_MAX_PPM;
+        }
+    }
+    base_epoch_us = epoch;
+    base_mono_us = mono;
+    sincronizado = true;
+    critical_section_exit(&secao);
+}
+
+bool relogio_sincronizado(void) {
+    return sincronizado;
+}
+
+uint64_t relogio_epoch_ms(uint64_t tempo_us) {
+    if (!sincronizado) return 0;
+    critical_section_enter_blocking(&secao);
+    int64_t delta = (int64_t)(tempo_us - base_mono_us); // Negativo para amostras anteriores à sincronização
+    uint64_t epoch = base_epoch_us + delta + (int64_t)((float)delta * deriva_ppm * 1e-6f);
+    critical_section_exit(&secao);
+    return epoch / 1000;
+}
+
+float relogio_deriva_ppm(void) {
+    return deriva_ppm;
+}
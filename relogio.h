@@ -0,0 +1,50 @@
+/**
+ * @file relogio.h
+ * @brief Relógio de parede sincronizado por SNTP.
+ *
+ * As amostras são carimbadas no Core 0 com o tempo monotônico (µs desde o boot), no
+ * instante da aquisição. A conversão para o tempo Unix é feita depois, no Core 1, por um
+ * modelo  epoch = base + (t - t_base) * (1 + deriva),  reajustado a cada resposta SNTP.
+ * Assim a fila, o intervalo entre publicações e a espera pelo PUBACK não distorcem o
+ * horário da amostra, e amostras colhidas antes da primeira sincronização ganham
+ * horário assim que ela acontece.
+ */
+
+#ifndef RELOGIO_H
+#define RELOGIO_H
+
+#include "pico/stdlib.h" // Para tipos básicos
+
+#define RELOGIO_DERIVA_MAX_PPM 500.0f     // Limite da correção de deriva (cristal + erro de medida)
+#define RELOGIO_INTERVALO_MIN_DERIVA_S 60 // Sincronizações mais próximas não atualizam a deriva
+
+/**
+ * @brief Configura e inicia o cliente SNTP do LWIP (Core 1, com o enlace Wi-Fi ativo).
+ * Chamadas seguintes não têm efeito.
+ */
+void relogio_iniciar_sntp(void);
+
+/**
+ * @brief Recebe o horário do servidor. Chamada pelo LWIP via SNTP_SET_SYSTEM_TIME_US.
+ * @param segundos Segundos desde 1970-01-01 UTC.
+ * @param microssegundos Fração do segundo.
+ */
+void relogio_sntp_recebido(uint32_t segundos, uint32_t microssegundos);
+
+/**
+ * @brief Indica se já houve ao menos uma sincronização.
+ */
+bool relogio_sincronizado(void);
+
+/**
+ * @brief Converte um instante monotônico (time_us_64) em milissegundos Unix.
+ * @return Milissegundos desde 1970, ou 0 se o relógio ainda não foi sincronizado.
+ */
+uint64_t relogio_epoch_ms(uint64_t tempo_us);
+
+/**
+ * @brief Deriva estimada do cristal em relação ao servidor (ppm).
+ */
+float relogio_deriva_ppm(void);
+
+#endif // RELOGIO_H
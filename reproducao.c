@@ -0,0 +1,173 @@
+/**
+ * @file reproducao.c
+ * @brief Implementação da reprodução de traços sobre o relógio virtual.
+ */
+
+#include "reproducao.h"
+
+#if ESTUFA_REPRODUCAO
+
+#include <stdio.h>
+#include <string.h>
+#include "hardware/watchdog.h"
+#include "publicacao.h"
+
+#define REPRODUCAO_INICIO_US 1000000 // O relógio virtual começa em 1 s, longe do instante nulo
+
+static uint64_t agora_us = REPRODUCAO_INICIO_US;
+static amostra_t pendente;
+static bool tem_pendente;
+
+// Correspondência entre o tempo do traço e o relógio virtual, fixada pela primeira amostra.
+static bool traco_iniciado;
+static uint64_t inicio_traco_ms;
+static uint64_t inicio_virtual_us;
+
+static uint32_t total_amostras, total_transicoes, total_publicacoes;
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Tempo do traço correspondente ao relógio virtual, usado nos carimbos da saída.
+ */
+static unsigned long long tempo_traco_ms(void) {
+    if (!traco_iniciado) return agora_us / 1000;
+    return inicio_traco_ms + (agora_us - inicio_virtual_us) / 1000;
+}
+
+/**
+ * @brief Lê uma linha do USB, bloqueando. O que passar de REPRODUCAO_LINHA_MAX é descartado.
+ */
+static void ler_linha(char *linha) {
+    size_t n = 0;
+    int c;
+    while ((c = getchar()) != '\n') {
+        if (c == '\r' || c == EOF) continue;
+        if (n < REPRODUCAO_LINHA_MAX - 1) linha[n++] = (char)c;
+    }
+    linha[n] = '\0';
+}
+
+/**
+ * @brief Lê um campo inteiro até a próxima vírgula.
+ * @param p Posição de leitura, avançada para depois da vírgula.
+ * @param presente Recebe false se o campo está vazio.
+ * @return false se o campo tem caracteres inválidos.
+ */
+static bool ler_campo(const char **p, int64_t *valor, bool *presente) {
+    const char *s = *p;
+    bool negativo = false;
+    *valor = 0;
+    *presente = false;
+    if (*s == '-') {
+        negativo = true;
+        s++;
+    }
+    while (*s >= '0' && *s <= '9') {
+        *valor = *valor * 10 + (*s++ - '0');
+        *presente = true;
+    }
+    if (negativo) *valor = -*valor;
+    if (*s != ',' && *s != '\0') return false;
+    if (*s == ',') s++;
+    *p = s;
+    return true;
+}
+
+/**
+ * @brief Converte uma linha do traço em amostra da zona principal.
+ * @return false se a linha é inválida.
+ */
+static bool interpretar_linha(const char *linha, amostra_t *a) {
+    int64_t t_ms, v;
+    bool presente;
+    if (!ler_campo(&linha, &t_ms, &presente) || !presente || t_ms < 0) return false;
+
+    memset(a, 0, sizeof(*a));
+    if (!traco_iniciado) {
+        traco_iniciado = true;
+        inicio_traco_ms = (uint64_t)t_ms;
+        inicio_virtual_us = agora_us;
+    }
+    // Um traço fora de ordem não faz o relógio voltar.
+    uint64_t t_us = (uint64_t)t_ms >= inicio_traco_ms ? inicio_virtual_us + ((uint64_t)t_ms - inicio_traco_ms) * 1000 : 0;
+    a->tempo_us = t_us > agora_us ? t_us : agora_us;
+
+    if (!ler_campo(&linha, &v, &presente)) return false;
+    if (presente) { a->temp_c100 = (int16_t)v; a->validos |= AMOSTRA_TEMP; }
+    if (!ler_campo(&linha, &v, &presente)) return false;
+    if (presente) { a->umid_c100 = (uint16_t)v; a->validos |= AMOSTRA_UMID; }
+    if (!ler_campo(&linha, &v, &presente)) return false;
+    if (presente) { a->luz_mlux = (uint32_t)v; a->validos |= AMOSTRA_LUZ; }
+    if (!ler_campo(&linha, &v, &presente)) return false;
+    if (presente) { a->solo_c100 = (uint16_t)v; a->validos |= AMOSTRA_SOLO; }
+    return true;
+}
+
+/**
+ * @brief Lê linhas até obter a próxima amostra. "fim" fecha o traço, imprime o resumo e
+ * reinicia a placa: modos, filtros e integrador voltam ao estado do boot para o próximo traço.
+ */
+static void ler_amostra(void) {
+    char linha[REPRODUCAO_LINHA_MAX];
+    while (true) {
+        ler_linha(linha);
+        if (linha[0] == '\0' || linha[0] == '#') continue;
+        if (strcmp(linha, "fim") == 0) {
+            printf("[reproducao] %llu fim amostras=%lu transicoes=%lu publicacoes=%lu\n", tempo_traco_ms(),
+                   (unsigned long)total_amostras, (unsigned long)total_transicoes, (unsigned long)total_publicacoes);
+            stdio_flush();
+            sleep_ms(100); // Dá tempo ao USB de entregar o resumo
+            watchdog_reboot(0, 0, 0);
+            while (true) tight_loop_contents();
+        }
+        if (interpretar_linha(linha, &pendente)) {
+            tem_pendente = true;
+            return;
+        }
+        printf("[reproducao] linha invalida: %s\n", linha);
+    }
+}
+
+// --- Implementação das Funções Públicas ---
+
+void reproducao_iniciar(void) {
+    printf("[reproducao] pronto\n");
+}
+
+absolute_time_t reproducao_agora(void) {
+    return from_us_since_boot(agora_us);
+}
+
+void reproducao_dormir_ms(uint32_t ms) {
+    agora_us += (uint64_t)ms * 1000;
+}
+
+void reproducao_avancar_ate(absolute_time_t prazo) {
+    if (!tem_pendente) ler_amostra();
+    uint64_t alvo = to_us_since_boot(prazo);
+    if (pendente.tempo_us < alvo) alvo = pendente.tempo_us;
+    if (alvo > agora_us) agora_us = alvo;
+}
+
+bool reproducao_proxima_amostra(amostra_t *amostra) {
+    if (!tem_pendente || pendente.tempo_us > agora_us) return false;
+    *amostra = pendente;
+    tem_pendente = false;
+    total_amostras++;
+    return true;
+}
+
+void reproducao_transicao(const char *origem, const char *destino, uint8_t evento) {
+    total_transicoes++;
+    printf("[reproducao] %llu modo %s -> %s evento=%u\n", tempo_traco_ms(), origem, destino, evento);
+}
+
+void reproducao_publicar(uint8_t tipo_msg, uint8_t valor) {
+    static publicacao_t pub;
+    if (!publicacao_formatar_evento(tipo_msg, valor, &pub)) return;
+    total_publicacoes++;
+    printf("[reproducao] %llu pub %s %s\n", tempo_traco_ms(), pub.topico, pub.mensagem);
+}
+
+#endif // ESTUFA_REPRODUCAO
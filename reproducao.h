@@ -0,0 +1,84 @@
+/**
+ * @file reproducao.h
+ * @brief Reprodução de traços gravados da estufa sobre um relógio virtual.
+ *
+ * Com ESTUFA_REPRODUCAO=1, o Core 0 deixa de ler os sensores e recebe as amostras de um
+ * traço enviado pelo USB (tools/reproduzir_traco.py), uma por linha:
+ *
+ *     t_ms,temp_c100,umid_c100,luz_mlux[,solo_c100]
+ *
+ * Campos vazios são leituras ausentes; linhas iniciadas por '#' são ignoradas e "fim"
+ * encerra o traço e reinicia a placa, então cada traço parte do estado do boot. O tempo
+ * do firmware (timers do laço, máquina de estados, controlador de irrigação, animações e
+ * pausas do buzzer) passa a ser o relógio virtual, que salta direto para o próximo prazo
+ * do laço ou para a próxima amostra do traço: dias de dados rodam no ritmo em que o USB
+ * os entrega, sempre com o mesmo resultado. O Core 1 e a rede não são iniciados; as
+ * transições de modo e as publicações pedidas pelo Core 0 saem no stdio, carimbadas com
+ * o tempo do traço.
+ */
+
+#ifndef REPRODUCAO_H
+#define REPRODUCAO_H
+
+#include "pico/stdlib.h" // Para tipos básicos e absolute_time_t
+#include "amostras.h"    // Para amostra_t
+
+#ifndef ESTUFA_REPRODUCAO
+#define ESTUFA_REPRODUCAO 0
+#endif
+
+#define REPRODUCAO_LINHA_MAX 64 // Maior linha aceita do traço
+
+#if ESTUFA_REPRODUCAO
+
+/**
+ * @brief Anuncia no stdio que o firmware está pronto para receber o traço.
+ */
+void reproducao_iniciar(void);
+
+/**
+ * @brief Instante atual no relógio virtual.
+ */
+absolute_time_t reproducao_agora(void);
+
+/**
+ * @brief Avança o relógio virtual sem esperar (substitui sleep_ms).
+ */
+void reproducao_dormir_ms(uint32_t ms);
+
+/**
+ * @brief Avança o relógio virtual até o prazo ou até a próxima amostra do traço, o que vier
+ * antes. Bloqueia lendo o USB quando não há amostra pendente. Substitui o sono do Core 0.
+ * @param prazo Próximo instante em que o laço tem trabalho.
+ */
+void reproducao_avancar_ate(absolute_time_t prazo);
+
+/**
+ * @brief Entrega a amostra pendente do traço se o relógio virtual já chegou ao seu instante.
+ * @return true se a amostra foi copiada para o destino.
+ */
+bool reproducao_proxima_amostra(amostra_t *amostra);
+
+/**
+ * @brief Registra uma transição de modo na saída da reprodução.
+ */
+void reproducao_transicao(const char *origem, const char *destino, uint8_t evento);
+
+/**
+ * @brief Formata e registra na saída uma publicação pedida pelo Core 0 (em vez de enviá-la ao Core 1).
+ * @param tipo_msg Valor de enum MQTT_MSG_TYPE.
+ * @param valor Valor de 8 bits que acompanha o pedido.
+ */
+void reproducao_publicar(uint8_t tipo_msg, uint8_t valor);
+
+#define estufa_agora() reproducao_agora()
+#define estufa_dormir_ms(ms) reproducao_dormir_ms(ms)
+
+#else
+
+#define estufa_agora() get_absolute_time()
+#define estufa_dormir_ms(ms) sleep_ms(ms)
+
+#endif // ESTUFA_REPRODUCAO
+
+#endif // REPRODUCAO_H
@@ -1,17 +1,176 @@
 /**
  * @file rgb_led.c
  * @brief Implementação do driver para o LED RGB (cátodo comum).
- * Controla o brilho de cada cor utilizando PWM.
+ * Controla o brilho de cada cor utilizando PWM. Os efeitos são calculados na
+ * interrupção de wrap do slice do LED vermelho (~1,9 kHz com clk_sys de 125 MHz),
+ * decimada para uma atualização a cada RGB_DECIMACAO wraps (~120 Hz).
  */
 
 #include "rgb_led.h" // Para o próprio cabeçalho do driver
+#include "na_ram.h"  // Para NA_RAM no tratador de interrupção
+#include "hardware/clocks.h" // Para clock_get_hz
+#include "hardware/irq.h"    // Para o tratador compartilhado de PWM_IRQ_WRAP
+
+// --- Definições Internas ---
+#define RGB_DECIMACAO 16 // Wraps do PWM por atualização de efeito
+
+enum EfeitoLed { EFEITO_NENHUM, EFEITO_FADE, EFEITO_RESPIRAR, EFEITO_PISCAR };
+
+/**
+ * @brief Tabela de correção gama (2,2): nível perceptual 0-255 -> duty 0-65535.
+ * Mantém a variação de brilho visualmente uniforme, sem degraus no início da rampa.
+ */
+static const uint16_t gama[256] = {
+        0,     0,     2,     4,     7,    11,    17,    24,
+       32,    42,    53,    65,    79,    94,   111,   129,
+      148,   169,   192,   216,   242,   270,   299,   330,
+      362,   396,   432,   469,   508,   549,   591,   635,
+      681,   729,   779,   830,   883,   938,   995,  1053,
+     1113,  1175,  1239,  1305,  1373,  1443,  1514,  1587,
+     1663,  1740,  1819,  1900,  1983,  2068,  2155,  2243,
+     2334,  2427,  2521,  2618,  2717,  2817,  2920,  3024,
+     3131,  3240,  3350,  3463,  3578,  3694,  3813,  3934,
+     4057,  4182,  4309,  4438,  4570,  4703,  4838,  4976,
+     5115,  5257,  5401,  5547,  5695,  5845,  5998,  6152,
+     6309,  6468,  6629,  6792,  6957,  7124,  7294,  7466,
+     7640,  7816,  7994,  8175,  8358,  8543,  8730,  8919,
+     9111,  9305,  9501,  9699,  9900, 10102, 10307, 10515,
+    10724, 10936, 11150, 11366, 11585, 11806, 12029, 12254,
+    12482, 12712, 12944, 13179, 13416, 13655, 13896, 14140,
+    14386, 14635, 14885, 15138, 15394, 15652, 15912, 16174,
+    16439, 16706, 16975, 17247, 17521, 17798, 18077, 18358,
+    18642, 18928, 19216, 19507, 19800, 20095, 20393, 20694,
+    20996, 21301, 21609, 21919, 22231, 22546, 22863, 23182,
+    23504, 23829, 24156, 24485, 24817, 25151, 25487, 25826,
+    26168, 26512, 26858, 27207, 27558, 27912, 28268, 28627,
+    28988, 29351, 29717, 30086, 30457, 30830, 31206, 31585,
+    31966, 32349, 32735, 33124, 33514, 33908, 34304, 34702,
+    35103, 35507, 35913, 36321, 36732, 37146, 37562, 37981,
+    38402, 38825, 39252, 39680, 40112, 40546, 40982, 41421,
+    41862, 42306, 42753, 43202, 43654, 44108, 44565, 45025,
+    45487, 45951, 46418, 46888, 47360, 47835, 48313, 48793,
+    49275, 49761, 50249, 50739, 51232, 51728, 52226, 52727,
+    53230, 53736, 54245, 54756, 55270, 55787, 56306, 56828,
+    57352, 57879, 58409, 58941, 59476, 60014, 60554, 61097,
+    61642, 62190, 62741, 63295, 63851, 64410, 64971, 65535
+};
+
+// --- Estado dos Efeitos (compartilhado com a interrupção) ---
+static uint slice_irq;                     // Slice cujo wrap cadencia os efeitos
+static volatile uint8_t efeito;
+static volatile uint16_t cor_atual[3];     // Último duty aplicado (r, g, b)
+static volatile uint16_t cor_origem[3];
+static volatile uint16_t cor_destino[3];
+static volatile uint32_t fase;             // Fase do efeito em Q32 (uma volta = 2^32)
+static volatile uint32_t passo_fase;       // Incremento de fase por atualização
+static volatile uint32_t limiar_aceso;     // Pisca: fase abaixo da qual o LED fica aceso
+static uint8_t contador_decimacao;
+
+
+// --- Funções Auxiliares ---
+
+static inline void aplicar_cor(uint16_t r, uint16_t g, uint16_t b) {
+    // Como o LED é cátodo comum, um valor maior de duty cycle significa mais brilho.
+    cor_atual[0] = r;
+    cor_atual[1] = g;
+    cor_atual[2] = b;
+    pwm_set_gpio_level(LED_R, r);
+    pwm_set_gpio_level(LED_G, g);
+    pwm_set_gpio_level(LED_B, b);
+}
+
+static inline uint16_t escalar(uint16_t valor, uint16_t fator) {
+    return (uint16_t)(((uint32_t)valor * fator) >> 16);
+}
+
+/**
+ * @brief Converte uma duração em milissegundos no incremento de fase por atualização.
+ */
+static uint32_t calcular_passo(uint32_t duracao_ms) {
+    if (duracao_ms == 0) return 0xFFFFFFFFu;
+    // Atualizações por segundo = clk_sys / ((PWM_MAX_DUTY + 1) * RGB_DECIMACAO)
+    uint64_t atualizacoes = (uint64_t)clock_get_hz(clk_sys) * duracao_ms / (1000ull * (PWM_MAX_DUTY + 1) * RGB_DECIMACAO);
+    if (atualizacoes == 0) atualizacoes = 1;
+    return (uint32_t)((1ull << 32) / atualizacoes);
+}
+
+/**
+ * @brief Tratador compartilhado da interrupção de wrap do PWM.
+ */
+static void NA_RAM(rgb_led_irq_handler)(void) {
+    if (!(pwm_get_irq_status_mask() & (1u << slice_irq))) return;
+    pwm_clear_irq(slice_irq);
+    if (++contador_decimacao < RGB_DECIMACAO) return;
+    contador_decimacao = 0;
+
+    uint32_t fase_anterior = fase;
+    fase += passo_fase;
+    bool volta_completa = fase < fase_anterior;
+
+    switch (efeito) {
+        case EFEITO_FADE: {
+            if (volta_completa) {
+                aplicar_cor(cor_destino[0], cor_destino[1], cor_destino[2]);
+                efeito = EFEITO_NENHUM;
+                pwm_set_irq_enabled(slice_irq, false);
+                break;
+            }
+            // Interpolação com a rampa corrigida por gama para uma transição perceptualmente linear.
+            uint16_t t = gama[fase >> 24];
+            uint16_t c[3];
+            for (int i = 0; i < 3; i++) {
+                int32_t delta = (int32_t)cor_destino[i] - (int32_t)cor_origem[i];
+                c[i] = (uint16_t)(cor_origem[i] + ((delta * (int32_t)(t >> 1)) >> 15));
+            }
+            aplicar_cor(c[0], c[1], c[2]);
+            break;
+        }
+        case EFEITO_RESPIRAR: {
+            // Onda triangular de nível perceptual 0-255, convertida pela tabela gama.
+            uint8_t p = fase >> 24;
+            uint8_t nivel = p < 128 ? (uint8_t)(p * 2) : (uint8_t)((255 - p) * 2);
+            uint16_t fator = gama[nivel];
+            aplicar_cor(escalar(cor_destino[0], fator), escalar(cor_destino[1], fator), escalar(cor_destino[2], fator));
+            break;
+        }
+        case EFEITO_PISCAR:
+            if (fase < limiar_aceso) {
+                aplicar_cor(cor_destino[0], cor_destino[1], cor_destino[2]);
+            } else {
+                aplicar_cor(0, 0, 0);
+            }
+            break;
+        default:
+            pwm_set_irq_enabled(slice_irq, false);
+            break;
+    }
+}
+
+/**
+ * @brief Prepara um novo efeito com a interrupção do slice desabilitada.
+ */
+static void iniciar_efeito(uint8_t novo, uint16_t r, uint16_t g, uint16_t b, uint32_t duracao_ms) {
+    pwm_set_irq_enabled(slice_irq, false);
+    cor_origem[0] = cor_atual[0];
+    cor_origem[1] = cor_atual[1];
+    cor_origem[2] = cor_atual[2];
+    cor_destino[0] = r;
+    cor_destino[1] = g;
+    cor_destino[2] = b;
+    fase = 0;
+    passo_fase = calcular_passo(duracao_ms);
+    contador_decimacao = 0;
+    efeito = novo;
+    pwm_clear_irq(slice_irq);
+    pwm_set_irq_enabled(slice_irq, true);
+}
 
 
 // --- Implementação das Funções Públicas ---
 
 /**
  * @brief Configura os pinos do LED RGB para operarem com PWM.
- * Obtém os slices de PWM e os habilita.
+ * Obtém os slices de PWM, define wrap e divisor e os habilita.
  */
 void rgb_led_init() {
     // Configura os três pinos (R, G, B) para a função de hardware PWM.
@@ -25,6 +184,15 @@ void rgb_led_init() {
     uint slice_g = pwm_gpio_to_slice_num(LED_G);
     uint slice_b = pwm_gpio_to_slice_num(LED_B);
 
+    // Wrap e divisor explícitos: a escala do duty é PWM_MAX_DUTY e a frequência
+    // (~1,9 kHz) fica bem acima do limiar de cintilação visível.
+    uint slices[3] = { slice_r, slice_g, slice_b };
+    for (int i = 0; i < 3; i++) {
+        pwm_set_clkdiv(slices[i], 1.0f);
+        pwm_set_wrap(slices[i], PWM_MAX_DUTY);
+    }
+    aplicar_cor(0, 0, 0);
+
     // Habilita o slice de cada pino.
     // A verificação para evitar habilitar o mesmo slice múltiplas vezes é uma otimização.
     pwm_set_enabled(slice_r, true);
@@ -34,6 +202,13 @@ void rgb_led_init() {
     if (slice_b != slice_r && slice_b != slice_g) { // Se o pino B usa um slice diferente dos anteriores
         pwm_set_enabled(slice_b, true);
     }
+
+    // O wrap do slice do vermelho cadencia os efeitos; a interrupção só fica
+    // habilitada enquanto houver efeito ativo.
+    slice_irq = slice_r;
+    pwm_set_irq_enabled(slice_irq, false);
+    irq_add_shared_handler(PWM_IRQ_WRAP, rgb_led_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(PWM_IRQ_WRAP, true);
 }
 
 /**
@@ -43,10 +218,25 @@ void rgb_led_init() {
  * @param b O valor do duty cycle para o canal azul (0 a PWM_MAX_DUTY).
  */
 void rgb_led_set_color(uint16_t r, uint16_t g, uint16_t b) {
-    // A função pwm_set_gpio_level ajusta o duty cycle do pino especificado.
-    // Ela lida internamente com qual slice e canal o pino está usando.
-    // Como o LED é cátodo comum, um valor maior de duty cycle significa mais brilho.
-    pwm_set_gpio_level(LED_R, r);
-    pwm_set_gpio_level(LED_G, g);
-    pwm_set_gpio_level(LED_B, b);
-}
\ No newline at end of file
+    pwm_set_irq_enabled(slice_irq, false);
+    efeito = EFEITO_NENHUM;
+    aplicar_cor(r, g, b);
+}
+
+void rgb_led_fade(uint16_t r, uint16_t g, uint16_t b, uint32_t duracao_ms) {
+    iniciar_efeito(EFEITO_FADE, r, g, b, duracao_ms);
+}
+
+void rgb_led_respirar(uint16_t r, uint16_t g, uint16_t b, uint32_t periodo_ms) {
+    iniciar_efeito(EFEITO_RESPIRAR, r, g, b, periodo_ms);
+}
+
+void rgb_led_piscar(uint16_t r, uint16_t g, uint16_t b, uint32_t periodo_ms, uint32_t aceso_ms) {
+    if (aceso_ms > periodo_ms) aceso_ms = periodo_ms;
+    limiar_aceso = periodo_ms ? (uint32_t)(((uint64_t)aceso_ms << 32) / periodo_ms) : 0;
+    iniciar_efeito(EFEITO_PISCAR, r, g, b, periodo_ms);
+}
+
+bool rgb_led_efeito_ativo(void) {
+    return efeito != EFEITO_NENHUM;
+}
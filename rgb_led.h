@@ -2,6 +2,8 @@
  * @file rgb_led.h
  * @brief Arquivo de cabeçalho para o driver do LED RGB (cátodo comum).
  * Declara as funções públicas para inicializar e controlar a cor do LED através de PWM.
+ * Além da cor estática, oferece efeitos (fade, respiração, pisca) calculados na
+ * interrupção de wrap do PWM: basta disparar o efeito, sem custo para o laço principal.
  */
 
 #ifndef RGB_LED_H
@@ -13,17 +15,46 @@
 
 
 /**
- * @brief Configura os pinos do LED RGB para operarem com PWM.
+ * @brief Configura os pinos do LED RGB para operarem com PWM (wrap PWM_MAX_DUTY, divisor 1)
+ * e registra o tratador de interrupção dos efeitos.
  * Deve ser chamada uma vez na inicialização do sistema.
  */
 void rgb_led_init(void);
 
 /**
- * @brief Define a cor do LED RGB.
+ * @brief Define a cor do LED RGB, cancelando qualquer efeito em andamento.
  * @param r O valor do duty cycle para o canal vermelho (0 a PWM_MAX_DUTY).
  * @param g O valor do duty cycle para o canal verde (0 a PWM_MAX_DUTY).
  * @param b O valor do duty cycle para o canal azul (0 a PWM_MAX_DUTY).
  */
 void rgb_led_set_color(uint16_t r, uint16_t g, uint16_t b);
 
-#endif // RGB_LED_H
\ No newline at end of file
+/**
+ * @brief Transição suave da cor atual até a cor indicada.
+ * Ao final o LED permanece estático na cor de destino.
+ * @param r, g, b Cor de destino (0 a PWM_MAX_DUTY).
+ * @param duracao_ms Duração da transição em milissegundos.
+ */
+void rgb_led_fade(uint16_t r, uint16_t g, uint16_t b, uint32_t duracao_ms);
+
+/**
+ * @brief Efeito de respiração: o brilho sobe e desce continuamente com correção gama.
+ * @param r, g, b Cor no brilho máximo (0 a PWM_MAX_DUTY).
+ * @param periodo_ms Duração de um ciclo completo em milissegundos.
+ */
+void rgb_led_respirar(uint16_t r, uint16_t g, uint16_t b, uint32_t periodo_ms);
+
+/**
+ * @brief Efeito de pisca: alterna entre a cor e apagado.
+ * @param r, g, b Cor do LED aceso (0 a PWM_MAX_DUTY).
+ * @param periodo_ms Duração de um ciclo completo em milissegundos.
+ * @param aceso_ms Tempo aceso dentro de cada ciclo.
+ */
+void rgb_led_piscar(uint16_t r, uint16_t g, uint16_t b, uint32_t periodo_ms, uint32_t aceso_ms);
+
+/**
+ * @brief Indica se há um efeito em execução.
+ */
+bool rgb_led_efeito_ativo(void);
+
+#endif // RGB_LED_H
@@ -0,0 +1,61 @@
+/**
+ * @file sensor_driver.h
+ * @brief Interface uniforme dos drivers de sensor usada pelo escalonador de sensores.h.
+ *
+ * Cada driver expõe uma tabela constante de operações: disparar a medição, consultar se
+ * o resultado está pronto e ler o resultado para os campos de amostra_t que ele fornece.
+ * O escalonador não conhece os sensores concretos; um novo tipo de sensor é só mais uma
+ * tabela e mais uma linha no registro de sensores.c.
+ */
+
+#ifndef SENSOR_DRIVER_H
+#define SENSOR_DRIVER_H
+
+#include "pico/stdlib.h"  // Para tipos básicos
+#include "hardware/i2c.h" // Para o tipo i2c_inst_t
+#include "amostras.h"     // Para amostra_t e os bits AMOSTRA_*
+
+/**
+ * @struct sensor_contexto_t
+ * @brief Dados de uma instância repassados às operações do driver.
+ */
+typedef struct {
+    i2c_inst_t *i2c;   ///< Barramento (drivers I2C), com o canal do multiplexador já selecionado.
+    uint8_t parametro; ///< Específico do driver (ex: entrada do ADC).
+} sensor_contexto_t;
+
+/**
+ * @struct sensor_driver_t
+ * @brief Tabela de operações de um tipo de sensor.
+ */
+typedef struct {
+    const char *nome;      ///< Nome curto, para diagnóstico.
+    uint8_t capacidades;   ///< Campos de amostra_t que o driver preenche (bits AMOSTRA_*).
+    const char *unidades;  ///< Unidades dos campos, na ordem dos bits (ex: "C,%UR").
+
+    /**
+     * @brief Prepara o sensor. Chamada no boot e, após uma falha, uma vez por ciclo.
+     * @return false se o sensor não respondeu.
+     */
+    bool (*iniciar)(const sensor_contexto_t *ctx);
+
+    /**
+     * @brief Dispara uma medição sem aguardar.
+     * @return Tempo mínimo (ms) até o resultado poder estar pronto, ou -1 em caso de falha.
+     */
+    int32_t (*disparar)(const sensor_contexto_t *ctx);
+
+    /**
+     * @brief Indica se o resultado já pode ser lido. NULL: pronto assim que o tempo
+     * devolvido por disparar() passar.
+     */
+    bool (*pronto)(const sensor_contexto_t *ctx);
+
+    /**
+     * @brief Lê o resultado para a amostra da zona, marcando em validos os campos obtidos.
+     * @return false se a leitura falhou.
+     */
+    bool (*ler)(const sensor_contexto_t *ctx, amostra_t *destino);
+} sensor_driver_t;
+
+#endif // SENSOR_DRIVER_H
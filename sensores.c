@@ -0,0 +1,249 @@
+/**
+ * @file sensores.c
+ * @brief Implementação do registro de sensores e do escalonador de amostragem.
+ */
+
+#include "sensores.h"
+#include "na_ram.h"
+#include "configura_geral.h"
+#include "aht10.h"
+#include "bh1750.h"
+#include "solo.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @struct sensor_registro_t
+ * @brief Uma instância de sensor: driver, canal do multiplexador e zona.
+ */
+typedef struct {
+    const sensor_driver_t *driver;
+    uint8_t canal;     ///< Canal do TCA9548A, ou SENSOR_SEM_MUX.
+    uint8_t zona;      ///< Zona cujas amostras este sensor alimenta.
+    uint8_t parametro; ///< Repassado ao driver em sensor_contexto_t.
+} sensor_registro_t;
+
+// Com o TCA9548A, os sensores I2C da zona principal também ficam atrás dele, no canal 0:
+// o multiplexador só chaveia os canais de baixo, e um AHT10 (0x38) ou BH1750 (0x23) ligado
+// direto ao barramento responderia junto com o do canal selecionado.
+#if TCA9548A_HABILITADO
+#define CANAL_PRINCIPAL 0
+#else
+#define CANAL_PRINCIPAL SENSOR_SEM_MUX
+#endif
+
+// Registro de sensores. Para mais zonas, ligue um TCA9548A (TCA9548A_HABILITADO = 1) com a
+// zona principal no canal 0 e acrescente um par AHT10/BH1750 por canal, ex:
+// { &aht10_driver, 1, 1 }, { &bh1750_driver, 1, 1 }. Duas instâncias do mesmo driver não
+// podem dividir um segmento do barramento (ver registro_conflitante()).
+static const sensor_registro_t registro[] = {
+    { &aht10_driver,  CANAL_PRINCIPAL, ZONA_PRINCIPAL },
+    { &bh1750_driver, CANAL_PRINCIPAL, ZONA_PRINCIPAL },
+#if SOLO_SONDA_HABILITADA
+    { &solo_driver,   SENSOR_SEM_MUX, ZONA_PRINCIPAL, SOLO_ADC_PIN - 26 },
+#endif
+};
+#define NUM_SENSORES count_of(registro)
+#define SENSOR_PRAZO_EXTRA_MS 100 // Tolerância de pronto() além do tempo informado por disparar()
+
+/**
+ * @brief Etapas de uma instância dentro do ciclo de amostragem.
+ */
+enum EtapaSensor {
+    ETAPA_OCIOSO,      ///< Nada a fazer até o próximo ciclo.
+    ETAPA_DISPARAR,    ///< Medição ainda não disparada neste ciclo.
+    ETAPA_CONVERTENDO  ///< Aguardando o fim da conversão para ler.
+};
+
+typedef struct {
+    uint8_t etapa;
+    bool presente;            ///< false: a inicialização falhou; nova tentativa no próximo ciclo.
+    absolute_time_t pronto_em;
+    absolute_time_t limite;   ///< Após este instante, a medição é dada como perdida.
+} sensor_estado_t;
+
+// --- Estado ---
+static i2c_inst_t *barramento;
+static sensor_estado_t estados[NUM_SENSORES];
+static amostra_t em_andamento[SENSORES_ZONAS_MAX];
+static amostra_t concluidas[SENSORES_ZONAS_MAX];
+static uint8_t num_zonas;
+static uint8_t cursor;      // Próxima instância a considerar no rodízio
+static uint8_t pendentes;   // Instâncias ainda não ociosas no ciclo atual
+static bool em_ciclo;
+
+_Static_assert(NUM_SENSORES < 256, "registro de sensores grande demais");
+
+// --- Funções Auxiliares ---
+
+static bool selecionar_canal(uint8_t canal) {
+#if TCA9548A_HABILITADO
+    return tca9548a_selecionar(barramento, canal);
+#else
+    return canal == SENSOR_SEM_MUX;
+#endif
+}
+
+static inline sensor_contexto_t contexto(const sensor_registro_t *r) {
+    return (sensor_contexto_t){ .i2c = barramento, .parametro = r->parametro };
+}
+
+static bool inicializar_instancia(const sensor_registro_t *r) {
+    if (!selecionar_canal(r->canal)) return false;
+    sensor_contexto_t ctx = contexto(r);
+    return r->driver->iniciar(&ctx);
+}
+
+static int32_t disparar(const sensor_registro_t *r) {
+    if (!selecionar_canal(r->canal)) return -1;
+    sensor_contexto_t ctx = contexto(r);
+    return r->driver->disparar(&ctx);
+}
+
+static bool pronto(const sensor_registro_t *r) {
+    if (!r->driver->pronto) return true;
+    sensor_contexto_t ctx = contexto(r);
+    return r->driver->pronto(&ctx);
+}
+
+static bool ler(const sensor_registro_t *r) {
+    if (!selecionar_canal(r->canal)) return false;
+    sensor_contexto_t ctx = contexto(r);
+    return r->driver->ler(&ctx, &em_andamento[r->zona]);
+}
+
+/**
+ * @brief Procura duas instâncias do mesmo driver e parâmetro que respondem no mesmo segmento:
+ * mesmo canal, ou uma delas fora do multiplexador (visível com qualquer canal selecionado).
+ * @return Índice da segunda instância do par, ou -1 se o registro é consistente.
+ */
+static int registro_conflitante(void) {
+    for (uint8_t i = 0; i < NUM_SENSORES; i++) {
+        for (uint8_t j = i + 1; j < NUM_SENSORES; j++) {
+            const sensor_registro_t *a = &registro[i], *b = &registro[j];
+            if (a->driver != b->driver || a->parametro != b->parametro) continue;
+            if (a->canal == b->canal || a->canal == SENSOR_SEM_MUX || b->canal == SENSOR_SEM_MUX) return j;
+        }
+    }
+    return -1;
+}
+
+static inline void concluir_etapa(uint8_t i) {
+    estados[i].etapa = ETAPA_OCIOSO;
+    pendentes--;
+}
+
+// --- Implementação das Funções Públicas ---
+
+bool sensores_iniciar(i2c_inst_t *i2c) {
+    barramento = i2c;
+    int conflito = registro_conflitante();
+    if (conflito >= 0) {
+        printf("[sensores] registro invalido: %s canal=%d divide o endereco com outra instancia\n",
+               registro[conflito].driver->nome, registro[conflito].canal == SENSOR_SEM_MUX ? -1 : registro[conflito].canal);
+    }
+    hard_assert(conflito < 0);
+#if TCA9548A_HABILITADO
+    tca9548a_init(i2c);
+#endif
+    bool principal_ok = true;
+    num_zonas = 0;
+    for (uint8_t i = 0; i < NUM_SENSORES; i++) {
+        const sensor_registro_t *r = &registro[i];
+        hard_assert(r->zona < SENSORES_ZONAS_MAX);
+        estados[i].etapa = ETAPA_OCIOSO;
+        estados[i].presente = inicializar_instancia(r);
+        if (!estados[i].presente && (r->driver->capacidades & AMOSTRA_TEMP) && r->zona == ZONA_PRINCIPAL) {
+            principal_ok = false;
+        }
+        printf("[sensores] %s zona=%u canal=%d unidades=%s %s\n", r->driver->nome, r->zona,
+               r->canal == SENSOR_SEM_MUX ? -1 : r->canal, r->driver->unidades, estados[i].presente ? "ok" : "FALHOU");
+        if (r->zona >= num_zonas) num_zonas = r->zona + 1;
+    }
+    for (uint8_t z = 0; z < SENSORES_ZONAS_MAX; z++) {
+        concluidas[z].zona = z;
+    }
+    return principal_ok;
+}
+
+void sensores_iniciar_ciclo(void) {
+    if (em_ciclo) return;
+    uint64_t agora = time_us_64();
+    for (uint8_t z = 0; z < num_zonas; z++) {
+        memset(&em_andamento[z], 0, sizeof(amostra_t));
+        em_andamento[z].tempo_us = agora;
+        em_andamento[z].zona = z;
+    }
+    for (uint8_t i = 0; i < NUM_SENSORES; i++) {
+        estados[i].etapa = ETAPA_DISPARAR;
+    }
+    pendentes = NUM_SENSORES;
+    em_ciclo = true;
+}
+
+bool NA_RAM(sensores_tarefa)(void) {
+    if (!em_ciclo) return false;
+
+    // Rodízio: a primeira instância, a partir do cursor, que tem algo a fazer agora.
+    for (uint8_t n = 0; n < NUM_SENSORES; n++) {
+        uint8_t i = (cursor + n) % NUM_SENSORES;
+        sensor_estado_t *e = &estados[i];
+        const sensor_registro_t *r = &registro[i];
+
+        if (e->etapa == ETAPA_DISPARAR) {
+            if (!e->presente) {
+                // Sensor ausente no boot ou após falha: uma tentativa de religar por ciclo.
+                e->presente = inicializar_instancia(r);
+                concluir_etapa(i);
+            } else {
+                int32_t conversao_ms = disparar(r);
+                if (conversao_ms < 0) {
+                    e->presente = false;
+                    concluir_etapa(i);
+                } else {
+                    e->pronto_em = make_timeout_time_ms(conversao_ms);
+                    e->limite = delayed_by_ms(e->pronto_em, SENSOR_PRAZO_EXTRA_MS);
+                    e->etapa = ETAPA_CONVERTENDO;
+                }
+            }
+        } else if (e->etapa == ETAPA_CONVERTENDO && time_reached(e->pronto_em)) {
+            if (pronto(r)) {
+                if (!ler(r)) e->presente = false;
+            } else if (!time_reached(e->limite)) {
+                continue; // Ainda convertendo; não conta como transação
+            } else {
+                e->presente = false; // Medição perdida: o driver é reiniciado no próximo ciclo
+            }
+            concluir_etapa(i);
+        } else {
+            continue;
+        }
+        cursor = (i + 1) % NUM_SENSORES;
+        break; // Uma transação por chamada
+    }
+
+    if (pendentes > 0) return false;
+    memcpy(concluidas, em_andamento, sizeof(amostra_t) * num_zonas);
+    em_ciclo = false;
+    return true;
+}
+
+absolute_time_t sensores_proximo_prazo(void) {
+    if (!em_ciclo) return at_the_end_of_time;
+    absolute_time_t prazo = at_the_end_of_time;
+    for (uint8_t i = 0; i < NUM_SENSORES; i++) {
+        if (estados[i].etapa == ETAPA_DISPARAR) return get_absolute_time();
+        if (estados[i].etapa == ETAPA_CONVERTENDO && absolute_time_diff_us(estados[i].pronto_em, prazo) > 0) {
+            prazo = estados[i].pronto_em;
+        }
+    }
+    return prazo;
+}
+
+uint8_t sensores_num_zonas(void) {
+    return num_zonas;
+}
+
+const amostra_t *sensores_amostra(uint8_t zona) {
+    return &concluidas[zona < SENSORES_ZONAS_MAX ? zona : ZONA_PRINCIPAL];
+}
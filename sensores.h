@@ -0,0 +1,62 @@
+/**
+ * @file sensores.h
+ * @brief Registro de sensores por zona e escalonador de amostragem não-bloqueante.
+ *
+ * Cada instância do registro (sensores.c) tem um driver (sensor_driver.h), um canal do
+ * TCA9548A e uma zona.
+ * Um ciclo de amostragem dispara a medição em todos os sensores e lê os resultados à
+ * medida que cada conversão termina, de modo que as conversões correm em paralelo: N
+ * sensores levam praticamente o mesmo tempo que um. Cada chamada a sensores_tarefa()
+ * faz no máximo uma transação I2C, percorrendo as instâncias em rodízio, para que o
+ * laço principal nunca fique parado esperando o barramento.
+ */
+
+#ifndef SENSORES_H
+#define SENSORES_H
+
+#include "pico/stdlib.h"  // Para tipos básicos
+#include "hardware/i2c.h" // Para o tipo i2c_inst_t
+#include "amostras.h"     // Para amostra_t
+#include "tca9548a.h"     // Para TCA9548A_NENHUM
+
+#define SENSORES_ZONAS_MAX 8
+#define ZONA_PRINCIPAL 0       // Zona usada pelo controle (alarme de luz, irrigação, display)
+#define SENSOR_SEM_MUX TCA9548A_NENHUM // Sensor ligado direto ao barramento
+
+/**
+ * @brief Inicializa o multiplexador (se habilitado) e todas as instâncias do registro.
+ * @param i2c Barramento dos sensores.
+ * @return false se o sensor de temperatura da zona principal não respondeu.
+ */
+bool sensores_iniciar(i2c_inst_t *i2c);
+
+/**
+ * @brief Inicia um ciclo de amostragem, carimbando o instante da aquisição.
+ * Sem efeito se o ciclo anterior ainda não terminou.
+ */
+void sensores_iniciar_ciclo(void);
+
+/**
+ * @brief Avança o ciclo em andamento: no máximo uma transação I2C por chamada.
+ * @return true na chamada em que o ciclo termina; as amostras ficam em sensores_amostra().
+ */
+bool sensores_tarefa(void);
+
+/**
+ * @brief Instante em que sensores_tarefa() terá trabalho (para o sono do Core 0).
+ * @return at_the_end_of_time se não há ciclo em andamento.
+ */
+absolute_time_t sensores_proximo_prazo(void);
+
+/**
+ * @brief Número de zonas com ao menos um sensor registrado.
+ */
+uint8_t sensores_num_zonas(void);
+
+/**
+ * @brief Amostra do último ciclo concluído para uma zona.
+ * Os campos ausentes (sensor com falha) ficam fora de amostra_t.validos.
+ */
+const amostra_t *sensores_amostra(uint8_t zona);
+
+#endif // SENSORES_H
@@ -1,47 +1,180 @@
 /**
  * @file servo.c
  * @brief Implementação do driver para controle de servo motor.
- * Ativa e desativa a função PWM do pino sob demanda para otimizar
- * o consumo de energia e evitar jitter no servo quando inativo.
+ * O slice PWM é configurado uma única vez (50 Hz, 1 µs por tick). A cada wrap
+ * (20 ms) a interrupção avança a largura de pulso ao longo de um perfil
+ * trapezoidal, evitando saltos bruscos e picos de corrente no 5 V compartilhado.
+ * Quando o servo fica parado, o PWM é desligado e o pino volta a GPIO para
+ * eliminar o jitter e economizar energia.
  */
 
 #include "servo.h"
+#include "na_ram.h"            // Para NA_RAM no tratador de interrupção
+#include "hardware/clocks.h" // Para clock_get_hz
+#include "hardware/irq.h"    // Para o tratador compartilhado de PWM_IRQ_WRAP
+
+// --- Definições Internas ---
+#define SERVO_WRAP_US 20000        // Período de 20 ms (50 Hz)
+#define SERVO_PULSO_MIN_US 1000    // 0 graus
+#define SERVO_PULSO_MAX_US 2000    // 180 graus
+#define SERVO_Q 8                  // Posição e velocidade em ponto fixo Q8 (1/256 µs)
+#define SERVO_PERIODOS_RETENCAO 15 // Períodos (~300 ms) segurando a posição antes de liberar
+
+// Conversões de graus para µs de pulso por período de 20 ms (em Q8):
+// 1 grau = 1000/180 µs; 1 grau/s = (1000/180) * 0.02 µs/período = 1/9 µs/período.
+#define GRAUS_S_PARA_VEL_Q8(v) (((int32_t)(v) << SERVO_Q) / 9)
+// 1 grau/s² = (1000/180) * 0.02² µs/período² = 1/450 µs/período².
+#define GRAUS_S2_PARA_ACEL_Q8(a) (((int32_t)(a) << SERVO_Q) / 450)
+
+// --- Estado da Trajetória (compartilhado com a interrupção) ---
+static uint servo_slice;
+static uint servo_canal;
+static volatile int32_t posicao_q8 = ((SERVO_PULSO_MIN_US + SERVO_PULSO_MAX_US) / 2) << SERVO_Q;
+static volatile int32_t velocidade_q8;
+static volatile int32_t alvo_q8;
+static volatile int32_t vel_max_q8;
+static volatile int32_t acel_q8;
+static volatile int32_t extremo_a_q8, extremo_b_q8;
+static volatile bool varrendo;
+static volatile bool ativo;
+static volatile uint8_t periodos_parado;
+
+// --- Funções Auxiliares ---
+
+static inline int32_t angulo_para_pulso_q8(int angle) {
+    if (angle < 0) angle = 0;
+    if (angle > 180) angle = 180;
+    return (SERVO_PULSO_MIN_US + angle * (SERVO_PULSO_MAX_US - SERVO_PULSO_MIN_US) / 180) << SERVO_Q;
+}
+
+/**
+ * @brief Desliga o PWM e devolve o pino ao GPIO. Chamado com a interrupção do slice desabilitada.
+ */
+static void servo_liberar(void) {
+    pwm_set_irq_enabled(servo_slice, false);
+    pwm_set_enabled(servo_slice, false);
+    gpio_set_function(SERVO_PIN, GPIO_FUNC_SIO);
+    velocidade_q8 = 0;
+    varrendo = false;
+    ativo = false;
+}
+
+/**
+ * @brief Avança um período do perfil trapezoidal.
+ * Acelera até a velocidade máxima e começa a frear quando a distância restante
+ * é igual à distância de frenagem (v² / 2a).
+ */
+static void NA_RAM(servo_passo_trajetoria)(void) {
+    int32_t distancia = alvo_q8 - posicao_q8;
+    int32_t sentido = distancia >= 0 ? 1 : -1;
+    int32_t dist_abs = distancia * sentido;
+    int32_t vel = velocidade_q8 * sentido; // Velocidade no sentido do alvo (negativa = afastando)
+
+    int32_t frenagem = (int32_t)(((int64_t)vel * vel) / (2 * acel_q8));
+    if (vel > 0 && frenagem >= dist_abs) {
+        vel -= acel_q8;
+        if (vel < acel_q8) vel = acel_q8; // Mantém um avanço mínimo para concluir o trajeto
+    } else {
+        vel += acel_q8;
+        if (vel > vel_max_q8) vel = vel_max_q8;
+    }
+
+    if (vel >= dist_abs) {
+        // Chegou: encaixa no alvo e zera a velocidade.
+        posicao_q8 = alvo_q8;
+        velocidade_q8 = 0;
+    } else {
+        posicao_q8 += vel * sentido;
+        velocidade_q8 = vel * sentido;
+    }
+}
+
+/**
+ * @brief Tratador compartilhado da interrupção de wrap do PWM.
+ * Executa um passo da trajetória por período de 20 ms.
+ */
+static void NA_RAM(servo_irq_handler)(void) {
+    if (!(pwm_get_irq_status_mask() & (1u << servo_slice))) return;
+    pwm_clear_irq(servo_slice);
+
+    if (posicao_q8 != alvo_q8) {
+        servo_passo_trajetoria();
+        periodos_parado = 0;
+    } else if (varrendo) {
+        alvo_q8 = (alvo_q8 == extremo_a_q8) ? extremo_b_q8 : extremo_a_q8;
+    } else if (++periodos_parado >= SERVO_PERIODOS_RETENCAO) {
+        servo_liberar();
+        return;
+    }
+    pwm_set_chan_level(servo_slice, servo_canal, (uint16_t)(posicao_q8 >> SERVO_Q));
+}
+
+/**
+ * @brief Energiza o servo (se necessário) e arma a interrupção do slice.
+ * Deve ser chamada com a interrupção do slice desabilitada.
+ */
+static void servo_armar(void) {
+    periodos_parado = 0;
+    if (!ativo) {
+        pwm_set_chan_level(servo_slice, servo_canal, (uint16_t)(posicao_q8 >> SERVO_Q));
+        gpio_set_function(SERVO_PIN, GPIO_FUNC_PWM);
+        pwm_set_enabled(servo_slice, true);
+        ativo = true;
+    }
+    pwm_clear_irq(servo_slice);
+    pwm_set_irq_enabled(servo_slice, true);
+}
 
 
 // --- Implementação das Funções Públicas ---
 
 /**
- * @brief Inicializa o pino do servo em modo GPIO padrão.
- * O pino será configurado para PWM apenas em `servo_start_move()`.
+ * @brief Configura o slice do servo uma única vez: 1 MHz de contagem e wrap de 20 ms.
  */
 void servo_init() {
     gpio_init(SERVO_PIN);
-    gpio_set_dir(SERVO_PIN, GPIO_OUT); // Define como saída digital
+    gpio_set_dir(SERVO_PIN, GPIO_OUT); // Define como saída digital até o primeiro movimento
+
+    servo_slice = pwm_gpio_to_slice_num(SERVO_PIN);
+    servo_canal = pwm_gpio_to_channel(SERVO_PIN);
+
+    // Divisor calculado a partir do clock real, para que 1 tick = 1 µs em qualquer clk_sys.
+    pwm_set_clkdiv(servo_slice, (float)clock_get_hz(clk_sys) / 1000000.0f);
+    pwm_set_wrap(servo_slice, SERVO_WRAP_US - 1);
+    pwm_set_irq_enabled(servo_slice, false);
+
+    irq_add_shared_handler(PWM_IRQ_WRAP, servo_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(PWM_IRQ_WRAP, true);
 }
 
-/**
- * @brief Inicia o movimento do servo para um ângulo específico.
- * Ativa o PWM no pino do servo e configura a largura de pulso para o ângulo.
- * @param angle O ângulo desejado em graus (0-180).
- */
 void servo_start_move(int angle) {
-    uint slice_num = pwm_gpio_to_slice_num(SERVO_PIN);
-    gpio_set_function(SERVO_PIN, GPIO_FUNC_PWM); // Ativa a função PWM no pino
+    servo_mover_para(angle, SERVO_VELOCIDADE_PADRAO_GRAUS_S);
+}
 
-    // Configura o PWM para operar em 50Hz, que é o padrão para a maioria dos servos.
-    // Frequência do clock do sistema (padrão 125MHz) / (divisor * wrap) = 50Hz
-    // Com div = 62.5 e wrap = 40000: 125,000,000 / (62.5 * 40000) = 50 Hz.
-    pwm_set_clkdiv(slice_num, 62.5f); 
-    pwm_set_wrap(slice_num, 40000);
+void servo_mover_para(int angle, uint16_t velocidade_graus_s) {
+    pwm_set_irq_enabled(servo_slice, false); // Seção crítica em relação à interrupção
+    alvo_q8 = angulo_para_pulso_q8(angle);
+    vel_max_q8 = GRAUS_S_PARA_VEL_Q8(velocidade_graus_s);
+    acel_q8 = GRAUS_S2_PARA_ACEL_Q8(SERVO_ACELERACAO_GRAUS_S2);
+    if (acel_q8 < 1) acel_q8 = 1;
+    varrendo = false;
+    servo_armar();
+}
 
-    // Converte o ângulo (0-180 graus) para a largura de pulso correspondente.
-    // Servos tipicamente usam pulsos de 1ms (0 graus) a 2ms (180 graus).
-    // Para um wrap de 40000 (período de 20ms): 1ms = 2000 ticks, 2ms = 4000 ticks.
-    // A fórmula mapeia o range de 0-180 graus para o range de pulso de 2000 a 4000.
-    int valor_pulso = (angle * 2000 / 180) + 2000;
-    pwm_set_chan_level(slice_num, pwm_gpio_to_channel(SERVO_PIN), valor_pulso);
+void servo_iniciar_varredura(int angulo_a, int angulo_b, uint16_t velocidade_graus_s) {
+    pwm_set_irq_enabled(servo_slice, false);
+    extremo_a_q8 = angulo_para_pulso_q8(angulo_a);
+    extremo_b_q8 = angulo_para_pulso_q8(angulo_b);
+    alvo_q8 = extremo_a_q8;
+    vel_max_q8 = GRAUS_S_PARA_VEL_Q8(velocidade_graus_s);
+    acel_q8 = GRAUS_S2_PARA_ACEL_Q8(SERVO_ACELERACAO_GRAUS_S2);
+    if (acel_q8 < 1) acel_q8 = 1;
+    varrendo = true;
+    servo_armar();
+}
 
-    pwm_set_enabled(slice_num, true); // Liga o PWM para iniciar o movimento
+bool servo_em_movimento(void) {
+    return ativo;
 }
 
 /**
@@ -49,13 +182,14 @@ void servo_start_move(int angle) {
  * Desliga o PWM e retorna o pino para a função de GPIO comum para parar o servo.
  */
 void servo_stop_move() {
-    uint slice_num = pwm_gpio_to_slice_num(SERVO_PIN);
-    
-    pwm_set_enabled(slice_num, false); // Desliga o sinal PWM
+    pwm_set_irq_enabled(servo_slice, false);
 
     // Retorna o pino para a função de GPIO padrão. Isso é crucial para:
     // 1. Parar completamente o envio de pulsos.
     // 2. Reduzir o consumo de energia (o servo não tenta manter a posição).
     // 3. Evitar "jitter" (vibrações finas) quando o servo não está ativo.
-    gpio_set_function(SERVO_PIN, GPIO_FUNC_SIO);
-}
\ No newline at end of file
+    servo_liberar();
+
+    // A posição comandada passa a ser o ponto de partida do próximo movimento.
+    alvo_q8 = posicao_q8;
+}
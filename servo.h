@@ -2,6 +2,8 @@
  * @file servo.h
  * @brief Arquivo de cabeçalho para o driver de um servo motor SG90/MG90.
  * Declara as funções para inicializar e controlar o movimento do servo.
+ * Os movimentos seguem perfis trapezoidais (aceleração e velocidade limitadas),
+ * calculados na interrupção de wrap do PWM, sem intervenção do laço principal.
  */
 
 #ifndef SERVO_H
@@ -13,26 +15,47 @@
 
 
 /**
- * @brief Inicializa o pino do servo em modo GPIO padrão.
- * O sinal PWM será ativado apenas quando o servo precisar se mover.
+ * @brief Configura o slice PWM do servo (50 Hz, 1 tick = 1 µs) e registra o tratador de interrupção.
+ * O pino permanece em modo GPIO até o primeiro movimento.
  * Deve ser chamada uma vez na inicialização do sistema.
  */
 void servo_init(void);
 
 /**
- * @brief Inicia o movimento do servo para um ângulo específico.
- * Esta função liga o sinal PWM e retorna imediatamente (não-bloqueante).
- * O servo permanecerá na posição até que `servo_stop_move()` seja chamada
- * ou um novo `servo_start_move()` seja acionado.
- * @param angle O ângulo desejado em graus (tipicamente entre 0 e 180, dependendo do servo).
+ * @brief Inicia o movimento do servo para um ângulo com o perfil padrão.
+ * Não-bloqueante: a trajetória é executada pela interrupção do PWM e o servo
+ * é liberado automaticamente pouco depois de atingir o alvo.
+ * @param angle O ângulo desejado em graus (0 a 180).
  */
 void servo_start_move(int angle);
 
 /**
- * @brief Para o sinal PWM do servo.
+ * @brief Move o servo até um ângulo com velocidade máxima específica.
+ * @param angle O ângulo desejado em graus (0 a 180).
+ * @param velocidade_graus_s Velocidade de cruzeiro em graus por segundo.
+ */
+void servo_mover_para(int angle, uint16_t velocidade_graus_s);
+
+/**
+ * @brief Inicia uma varredura contínua entre dois ângulos.
+ * O servo vai e volta até que servo_stop_move() ou um novo movimento seja solicitado.
+ * @param angulo_a Primeiro extremo em graus.
+ * @param angulo_b Segundo extremo em graus.
+ * @param velocidade_graus_s Velocidade de cruzeiro em graus por segundo.
+ */
+void servo_iniciar_varredura(int angulo_a, int angulo_b, uint16_t velocidade_graus_s);
+
+/**
+ * @brief Indica se há uma trajetória ou varredura em execução.
+ * @return true enquanto o servo estiver energizado por um movimento.
+ */
+bool servo_em_movimento(void);
+
+/**
+ * @brief Para o sinal PWM do servo imediatamente.
  * Retorna o pino para a função de GPIO padrão para desenergizar o servo,
  * eliminando o jitter e economizando energia.
  */
 void servo_stop_move(void);
 
-#endif // SERVO_H
\ No newline at end of file
+#endif // SERVO_H
@@ -0,0 +1,93 @@
+/**
+ * @file solo.c
+ * @brief Implementação do driver da sonda de umidade do solo (ADC + DMA).
+ */
+
+#include "solo.h"
+#include "configura_geral.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+
+// --- Estado ---
+static uint16_t buffer[SOLO_AMOSTRAS];
+static int canal_dma = -1;
+static dma_channel_config config_dma;
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Para o ADC e o DMA e esvazia a FIFO. Após um timeout de pronto(), a transferência
+ * anterior ainda pode estar em curso e não pode ser reconfigurada por cima.
+ */
+static void parar_captura(void) {
+    adc_run(false);
+    if (canal_dma >= 0) dma_channel_abort(canal_dma);
+    adc_fifo_drain();
+}
+
+// --- Implementação das Funções Públicas ---
+
+uint16_t solo_converter_bruto(uint16_t media) {
+    // A saída da sonda cai à medida que o solo fica mais úmido.
+    int32_t umidade = (SOLO_ADC_SECO - (int32_t)media) * 10000 / (SOLO_ADC_SECO - SOLO_ADC_MOLHADO);
+    if (umidade < 0) umidade = 0;
+    if (umidade > 10000) umidade = 10000;
+    return (uint16_t)umidade;
+}
+
+// --- Interface de Driver (sensor_driver.h) ---
+
+static bool driver_iniciar(const sensor_contexto_t *ctx) {
+    if (canal_dma < 0) {
+        adc_init();
+        adc_gpio_init(26 + ctx->parametro); // ADC0 a ADC2 = GPIO26 a GPIO28
+        // Cada conversão vai para a FIFO do ADC e pede uma transferência de DMA.
+        adc_fifo_setup(true, true, 1, false, false);
+        adc_set_clkdiv((float)clock_get_hz(clk_adc) / SOLO_TAXA_HZ - 1.0f);
+
+        canal_dma = dma_claim_unused_channel(true);
+        config_dma = dma_channel_get_default_config(canal_dma);
+        channel_config_set_transfer_data_size(&config_dma, DMA_SIZE_16);
+        channel_config_set_read_increment(&config_dma, false);
+        channel_config_set_write_increment(&config_dma, true);
+        channel_config_set_dreq(&config_dma, DREQ_ADC);
+    }
+    adc_select_input(ctx->parametro);
+    return true;
+}
+
+static int32_t driver_disparar(const sensor_contexto_t *ctx) {
+    parar_captura();
+    adc_select_input(ctx->parametro);
+    dma_channel_configure(canal_dma, &config_dma, buffer, &adc_hw->fifo, SOLO_AMOSTRAS, true);
+    adc_run(true);
+    return SOLO_AMOSTRAS * 1000 / SOLO_TAXA_HZ;
+}
+
+static bool driver_pronto(const sensor_contexto_t *ctx) {
+    (void)ctx;
+    return !dma_channel_is_busy(canal_dma);
+}
+
+static bool driver_ler(const sensor_contexto_t *ctx, amostra_t *destino) {
+    (void)ctx;
+    parar_captura();
+    uint32_t soma = 0;
+    for (uint32_t i = 0; i < SOLO_AMOSTRAS; i++) {
+        soma += buffer[i] & 0x0FFF;
+    }
+    destino->solo_c100 = solo_converter_bruto((uint16_t)(soma / SOLO_AMOSTRAS));
+    destino->validos |= AMOSTRA_SOLO;
+    return true;
+}
+
+const sensor_driver_t solo_driver = {
+    .nome = "solo",
+    .capacidades = AMOSTRA_SOLO,
+    .unidades = "%",
+    .iniciar = driver_iniciar,
+    .disparar = driver_disparar,
+    .pronto = driver_pronto, // Fim da transferência do DMA
+    .ler = driver_ler,
+};
@@ -0,0 +1,29 @@
+/**
+ * @file solo.h
+ * @brief Driver da sonda capacitiva de umidade do solo no ADC.
+ * Cada medição captura um bloco de conversões por DMA, sem ocupar a CPU, e devolve a
+ * média convertida em % pela calibração seco/molhado de configura_geral.h.
+ */
+
+#ifndef SOLO_H
+#define SOLO_H
+
+#include "pico/stdlib.h"     // Para tipos básicos
+#include "sensor_driver.h"   // Para sensor_driver_t
+
+#define SOLO_AMOSTRAS 256        // Conversões por medição (sobreamostragem)
+#define SOLO_TAXA_HZ 10000       // Taxa de conversão do ADC durante a captura
+
+/**
+ * @brief Converte a média bruta do ADC em umidade do solo (0 a 100 %).
+ * @param media Média das leituras de 12 bits.
+ * @return Umidade em centésimos de %, saturada nos extremos da calibração.
+ */
+uint16_t solo_converter_bruto(uint16_t media);
+
+/**
+ * @brief Driver da sonda para o registro de sensores. O parâmetro do contexto é a entrada do ADC.
+ */
+extern const sensor_driver_t solo_driver;
+
+#endif // SOLO_H
@@ -25,7 +25,7 @@
 #ifndef SSD1306_FONT_H
 #define SSD1306_FONT_H
 
-static uint8_t font[] = {
+static uint8_t font[] __attribute__((aligned(4))) = { // Alinhada para cópias de 32 bits
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, //0: Nothing
     0x78, 0x14, 0x12, 0x11, 0x12, 0x14, 0x78, 0x00, //1: A
     0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x7f, 0x00, //2: B
@@ -122,5 +122,35 @@ static uint8_t font[] = {
 
 };
 
+/**
+ * @brief Tabela de índices de glifo: código Latin-1 (0-255) -> índice em `font[]`.
+ * Substitui a busca por `switch` a cada caractere por um único acesso indexado.
+ * Os inicializadores são indexados pelo próprio caractere; os omitidos valem 0 (vazio).
+ */
+static const uint8_t font_indice[256] = {
+    // Letras maiúsculas
+    ['A'] = 1, ['B'] = 2, ['C'] = 3, ['D'] = 4, ['E'] = 5, ['F'] = 6, ['G'] = 7,
+    ['H'] = 8, ['I'] = 9, ['J'] = 10, ['K'] = 11, ['L'] = 12, ['M'] = 13, ['N'] = 14,
+    ['O'] = 15, ['P'] = 16, ['Q'] = 17, ['R'] = 18, ['S'] = 19, ['T'] = 20, ['U'] = 21,
+    ['V'] = 22, ['W'] = 23, ['X'] = 24, ['Y'] = 25, ['Z'] = 26,
+    // Letras minúsculas
+    ['a'] = 37, ['b'] = 38, ['c'] = 39, ['d'] = 40, ['e'] = 41, ['f'] = 42, ['g'] = 43,
+    ['h'] = 44, ['i'] = 45, ['j'] = 46, ['k'] = 47, ['l'] = 48, ['m'] = 49, ['n'] = 50,
+    ['o'] = 51, ['p'] = 52, ['q'] = 53, ['r'] = 54, ['s'] = 55, ['t'] = 56, ['u'] = 57,
+    ['v'] = 58, ['w'] = 59, ['x'] = 60, ['y'] = 61, ['z'] = 62,
+    // Dígitos
+    ['0'] = 27, ['1'] = 28, ['2'] = 29, ['3'] = 30, ['4'] = 31, ['5'] = 32, ['6'] = 33,
+    ['7'] = 34, ['8'] = 35, ['9'] = 36,
+    // Pontuação
+    ['!'] = 66, ['#'] = 65, [','] = 91, ['-'] = 92, ['.'] = 63, [':'] = 64, ['?'] = 67,
+    // Acentuados (Latin-1)
+    [0xC0] = 71, [0xC1] = 70, [0xC2] = 69, [0xC3] = 68, // À Á Â Ã
+    [0xC7] = 79, [0xC9] = 72, [0xCA] = 73, [0xCD] = 74, // Ç É Ê Í
+    [0xD3] = 75, [0xD4] = 76, [0xD5] = 77, [0xDA] = 78, // Ó Ô Õ Ú
+    [0xE0] = 83, [0xE1] = 82, [0xE2] = 84, [0xE3] = 81, // à á â ã
+    [0xE7] = 80, [0xE9] = 85, [0xEA] = 86, [0xED] = 87, // ç é ê í
+    [0xF3] = 88, [0xF4] = 89, [0xFA] = 90, // ó ô ú
+};
+
 #endif
 
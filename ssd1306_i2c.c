@@ -13,6 +13,7 @@
 
 // Protótipos de funções estáticas
 static void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character);
+static void ssd1306_draw_char_2x(uint8_t *ssd, int16_t x, int16_t y, uint8_t character);
 static inline int ssd1306_get_font(uint8_t character);
 static void ssd1306_send_command(uint8_t command);
 static void ssd1306_send_command_list(uint8_t *ssd, int number);
@@ -37,7 +38,9 @@ static void ssd1306_send_command_list(uint8_t *ssd, int number) {
 }
 
 static void ssd1306_send_buffer(uint8_t ssd[], int buffer_length) {
-    uint8_t temp_buffer[buffer_length + 1];
+    // Buffer estático: um quadro inteiro (1025 bytes) não cabe com folga na pilha de 2 KB.
+    static uint8_t temp_buffer[ssd1306_buffer_length + 1];
+    if (buffer_length > ssd1306_buffer_length) buffer_length = ssd1306_buffer_length;
     temp_buffer[0] = 0x40;
     memcpy(temp_buffer + 1, ssd, buffer_length);
     i2c_write_blocking(i2c1, ssd1306_i2c_address, temp_buffer, buffer_length + 1, false);
@@ -64,6 +67,10 @@ void ssd1306_init() {
     ssd1306_send_command_list(commands, count_of(commands));
 }
 
+void ssd1306_ligar(bool ligado) {
+    ssd1306_send_command(ssd1306_set_display | (ligado ? 0x01 : 0x00));
+}
+
 void render_on_display(uint8_t *ssd, struct render_area *area) {
     uint8_t commands[] = {
         ssd1306_set_column_address, area->start_column, area->end_column,
@@ -74,76 +81,109 @@ void render_on_display(uint8_t *ssd, struct render_area *area) {
 }
 
 static inline int ssd1306_get_font(uint8_t character) {
-    switch(character) {
-        case 'A' ... 'Z': return character - 'A' + 1;
-        case '0' ... '9': return character - '0' + 27;
-        case 'a' ... 'z': return character - 'a' + 37;
-        case '.': return 63;
-        case ':': return 64;
-        case '#': return 65;
-        case '!': return 66;
-        case '?': return 67;
-        case 0xC3: return 68; // Ã
-        case 0xC2: return 69; // Â
-        case 0xC1: return 70; // Á
-        case 0xC0: return 71; // À
-        case 0xC9: return 72; // É
-        case 0xCA: return 73; // Ê
-        case 0xCD: return 74; // Í
-        case 0xD3: return 75; // Ó
-        case 0xD4: return 76; // Ô
-        case 0xD5: return 77; // Õ
-        case 0xDA: return 78; // Ú
-        case 0xC7: return 79; // Ç
-        case 0xE7: return 80; // ç
-        case 0xE3: return 81; // ã
-        case 0xE1: return 82; // á
-        case 0xE0: return 83; // à
-        case 0xE2: return 84; // â
-        case 0xE9: return 85; // é
-        case 0xEA: return 86; // ê
-        case 0xED: return 87; // í
-        case 0xF3: return 88; // ó
-        case 0xF4: return 89; // ô
-        case 0xFA: return 90; // ú
-        case ',':  return 91;
-        case '-':  return 92;
-        default:   return 0; // caractere vazio/inválido
+    return font_indice[character]; // Tabela indexada pelo caractere (ssd1306_font.h)
+}
+
+/**
+ * @brief Expande 4 bits em 8, duplicando cada bit (usada pela fonte em tamanho duplo).
+ */
+static const uint8_t duplica_nibble[16] = {
+    0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F,
+    0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF,
+};
+
+/**
+ * @brief Combina uma coluna de até 16 pixels no buffer a partir de uma linha arbitrária.
+ * A coluna é deslocada para a posição de bit correta e dividida entre as páginas
+ * afetadas; páginas fora da tela são descartadas (recorte vertical).
+ */
+static inline void ssd1306_blit_coluna(uint8_t *ssd, int16_t x, int16_t y, uint16_t coluna) {
+    int16_t pagina = y >> 3; // Deslocamento aritmético: arredonda para baixo também com y negativo
+    uint32_t bits = (uint32_t)coluna << (y & 7);
+    for (; bits; bits >>= 8, pagina++) {
+        if (pagina >= 0 && pagina < ssd1306_n_pages) {
+            ssd[pagina * ssd1306_width + x] |= (uint8_t)bits;
+        }
     }
 }
 
 static void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character) {
-    if (x > ssd1306_width - 8 || y > ssd1306_height - 8) {
+    // Recorte: caracteres totalmente fora da tela são ignorados.
+    if (x <= -8 || x >= ssd1306_width || y <= -8 || y >= ssd1306_height) {
+        return;
+    }
+    const uint8_t *glifo = &font[ssd1306_get_font(character) * 8];
+
+    // Caminho rápido: alinhado à página e inteiro na tela. Copia o glifo com duas
+    // palavras de 32 bits quando o destino está alinhado (x múltiplo de 4).
+    if ((y & 7) == 0 && x >= 0 && x <= ssd1306_width - 8) {
+        uint8_t *destino = &ssd[(y >> 3) * ssd1306_width + x];
+        if (((uintptr_t)destino & 3) == 0) {
+            const uint32_t *origem32 = (const uint32_t *)glifo;
+            uint32_t *destino32 = (uint32_t *)destino;
+            destino32[0] = origem32[0];
+            destino32[1] = origem32[1];
+        } else {
+            memcpy(destino, glifo, 8);
+        }
         return;
     }
-    y = y / 8;
-    int idx = ssd1306_get_font(character);
-    int fb_idx = y * 128 + x;
+
+    // Caminho geral: deslocamento de bits para qualquer linha e recorte por coluna.
     for (int i = 0; i < 8; i++) {
-        ssd[fb_idx++] = font[idx * 8 + i];
+        int16_t coluna_x = x + i;
+        if (coluna_x < 0 || coluna_x >= ssd1306_width) continue;
+        ssd1306_blit_coluna(ssd, coluna_x, y, glifo[i]);
     }
 }
 
-void ssd1306_draw_utf8_multiline(uint8_t *ssd, int16_t x, int16_t y, const char *utf8_string) {
-    const int max_width = ssd1306_width;
+static void ssd1306_draw_char_2x(uint8_t *ssd, int16_t x, int16_t y, uint8_t character) {
+    if (x <= -16 || x >= ssd1306_width || y <= -16 || y >= ssd1306_height) {
+        return;
+    }
+    const uint8_t *glifo = &font[ssd1306_get_font(character) * 8];
+    for (int i = 0; i < 8; i++) {
+        // Cada coluna de 8 pixels vira duas colunas de 16 pixels.
+        uint16_t coluna = ((uint16_t)duplica_nibble[glifo[i] >> 4] << 8) | duplica_nibble[glifo[i] & 0x0F];
+        for (int rep = 0; rep < 2; rep++) {
+            int16_t coluna_x = x + 2 * i + rep;
+            if (coluna_x < 0 || coluna_x >= ssd1306_width) continue;
+            ssd1306_blit_coluna(ssd, coluna_x, y, coluna);
+        }
+    }
+}
+
+void ssd1306_draw_utf8_escala(uint8_t *ssd, int16_t x, int16_t y, const char *utf8_string, uint8_t escala) {
+    ssd1306_draw_utf8_largura(ssd, x, y, utf8_string, escala, ssd1306_width);
+}
+
+void ssd1306_draw_utf8_largura(uint8_t *ssd, int16_t x, int16_t y, const char *utf8_string, uint8_t escala,
+                               int16_t largura) {
+    const int max_width = largura;
     const int max_height = ssd1306_height;
-    const int char_width = 8;
-    const int char_height = 8;
+    const int char_width = escala == 2 ? 16 : 8;
+    const int char_height = escala == 2 ? 16 : 8;
 
     while (*utf8_string && y <= (max_height - char_height)) {
         uint8_t c = (uint8_t)*utf8_string;
+        uint8_t latin1;
         if ((c & 0x80) == 0) { // ASCII
-            ssd1306_draw_char(ssd, x, y, c);
+            latin1 = c;
             utf8_string++;
         }
-        else if ((c & 0xE0) == 0xC0) { // UTF-8 de 2 bytes (para caracteres acentuados)
+        else if ((c & 0xE0) == 0xC0 && utf8_string[1] != '\0') { // UTF-8 de 2 bytes (para caracteres acentuados)
             uint8_t first = (uint8_t)*utf8_string++;
             uint8_t second = (uint8_t)*utf8_string++;
-            uint8_t latin1 = ((first & 0x1F) << 6) | (second & 0x3F);
-            ssd1306_draw_char(ssd, x, y, latin1);
+            latin1 = ((first & 0x1F) << 6) | (second & 0x3F);
         }
         else { // Ignora outros caracteres multi-byte
             utf8_string++;
+            continue;
+        }
+        if (escala == 2) {
+            ssd1306_draw_char_2x(ssd, x, y, latin1);
+        } else {
+            ssd1306_draw_char(ssd, x, y, latin1);
         }
         x += char_width;
         if (x > (max_width - char_width)) {
@@ -151,4 +191,8 @@ void ssd1306_draw_utf8_multiline(uint8_t *ssd, int16_t x, int16_t y, const char
             y += char_height;
         }
     }
+}
+
+void ssd1306_draw_utf8_multiline(uint8_t *ssd, int16_t x, int16_t y, const char *utf8_string) {
+    ssd1306_draw_utf8_escala(ssd, x, y, utf8_string, 1);
 }
\ No newline at end of file
@@ -51,6 +51,14 @@ struct render_area {
 void ssd1306_init();
 void render_on_display(uint8_t *ssd, struct render_area *area);
 void calculate_render_area_buffer_length(struct render_area *area);
+// Liga ou desliga o painel (o conteúdo da RAM do controlador é preservado).
+void ssd1306_ligar(bool ligado);
+// Desenha texto UTF-8 (Latin-1) a partir de qualquer linha de pixel, com recorte nas bordas.
 void ssd1306_draw_utf8_multiline(uint8_t *ssd, int16_t x, int16_t y, const char *utf8_string);
+// Igual à anterior, com escala 1 (8x8) ou 2 (16x16, para leituras em destaque).
+void ssd1306_draw_utf8_escala(uint8_t *ssd, int16_t x, int16_t y, const char *utf8_string, uint8_t escala);
+// Igual à anterior, quebrando a linha antes da coluna `largura` (ex: para não invadir um ícone).
+void ssd1306_draw_utf8_largura(uint8_t *ssd, int16_t x, int16_t y, const char *utf8_string, uint8_t escala,
+                               int16_t largura);
 
 #endif // SSD1306_I2C_H
\ No newline at end of file
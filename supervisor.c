@@ -0,0 +1,104 @@
+/**
+ * @file supervisor.c
+ * @brief Implementação do supervisor de saúde dos núcleos.
+ *
+ * Registradores scratch do watchdog (preservados no reset por watchdog):
+ *   scratch[0]  SCRATCH_MAGICA, indica que os demais são válidos
+ *   scratch[1]  última fase do Core 0
+ *   scratch[2]  última fase do Core 1
+ *   scratch[3]  causa (bits 24-31) | segundos desde o boot (bits 0-23)
+ * Os scratch 4-7 são reservados ao SDK/bootrom.
+ */
+
+#include "supervisor.h"
+#include "na_ram.h"
+#include "perfil.h"
+#include "hardware/watchdog.h"
+#include "pico/multicore.h" // Para get_core_num
+#include <stdio.h>
+
+#define SCRATCH_MAGICA 0x53555056u // "SUPV"
+
+// Instantes em µs de 32 bits: leitura atômica entre núcleos; as diferenças sobrevivem ao estouro.
+static volatile uint32_t ultimo_batimento_us[2];
+static bool armado;
+static uint32_t recusas;
+static relatorio_reset_t relatorio;
+
+static const char *const nomes_fase_c0[PERFIL_NUM_FASES] = {
+    "laco", "fifo", "botao", "sensores", "estados", "display", "matriz", "heartbeat",
+};
+static const char *const nomes_fase_c1[] = { "rede", "fifo", "publicacao", "espera" };
+
+// --- Implementação das Funções Públicas ---
+
+void supervisor_iniciar(void) {
+    if (watchdog_enable_caused_reboot()) {
+        relatorio.motivo = RESET_WATCHDOG;
+    } else if (watchdog_caused_reboot()) {
+        relatorio.motivo = RESET_SOFTWARE;
+    } else {
+        relatorio.motivo = RESET_ENERGIA;
+    }
+    relatorio.registro_valido = watchdog_hw->scratch[0] == SCRATCH_MAGICA;
+    if (relatorio.registro_valido) {
+        relatorio.fase_c0 = (uint8_t)watchdog_hw->scratch[1];
+        relatorio.fase_c1 = (uint8_t)watchdog_hw->scratch[2];
+        relatorio.causa = (uint8_t)(watchdog_hw->scratch[3] >> 24);
+        relatorio.tempo_ligado_s = watchdog_hw->scratch[3] & 0xFFFFFF;
+    }
+
+    watchdog_hw->scratch[0] = SCRATCH_MAGICA;
+    watchdog_hw->scratch[1] = SUPERVISOR_FASE_INICIO;
+    watchdog_hw->scratch[2] = SUPERVISOR_FASE_INICIO;
+    watchdog_hw->scratch[3] = 0;
+}
+
+void supervisor_armar(void) {
+    uint32_t agora = time_us_32();
+    ultimo_batimento_us[0] = agora;
+    // O Core 1 ganha uma carência maior para o primeiro batimento (carga do firmware do CYW43).
+    ultimo_batimento_us[1] = agora + (SUPERVISOR_CARENCIA_C1_US - SUPERVISOR_ORCAMENTO_C1_US);
+    armado = true;
+    watchdog_enable(SUPERVISOR_WATCHDOG_MS, true); // Pausa durante a depuração
+}
+
+void NA_RAM(supervisor_fase)(uint8_t fase) {
+    watchdog_hw->scratch[1 + get_core_num()] = fase;
+}
+
+void NA_RAM(supervisor_batimento)(void) {
+    uint32_t agora = time_us_32();
+    if (get_core_num() == 1) {
+        ultimo_batimento_us[1] = agora;
+        return;
+    }
+
+    int32_t iteracao_us = (int32_t)(agora - ultimo_batimento_us[0]);
+    ultimo_batimento_us[0] = agora;
+    if (!armado) return;
+
+    uint8_t causa = CAUSA_NENHUMA;
+    if (iteracao_us > SUPERVISOR_ORCAMENTO_C0_US) {
+        causa = CAUSA_C0_LENTO;
+    } else if ((int32_t)(agora - ultimo_batimento_us[1]) > SUPERVISOR_ORCAMENTO_C1_US) {
+        causa = CAUSA_C1_PARADO;
+    }
+    watchdog_hw->scratch[3] = ((uint32_t)causa << 24) | ((uint32_t)(time_us_64() / 1000000) & 0xFFFFFF);
+
+    if (causa == CAUSA_NENHUMA) {
+        watchdog_update();
+    } else if (recusas++ == 0) {
+        printf("[supervisor] watchdog nao alimentado: %s\n", causa == CAUSA_C0_LENTO ? "core 0 lento" : "core 1 parado");
+    }
+}
+
+const relatorio_reset_t *supervisor_ultimo_reset(void) {
+    return &relatorio;
+}
+
+const char *supervisor_nome_fase(uint8_t nucleo, uint8_t fase) {
+    if (fase == SUPERVISOR_FASE_INICIO) return "inicio";
+    if (nucleo == 0) return fase < count_of(nomes_fase_c0) ? nomes_fase_c0[fase] : "?";
+    return fase < count_of(nomes_fase_c1) ? nomes_fase_c1[fase] : "?";
+}
@@ -0,0 +1,100 @@
+/**
+ * @file supervisor.h
+ * @brief Supervisor de saúde dos dois núcleos com o watchdog de hardware.
+ *
+ * Cada núcleo bate o ponto (supervisor_batimento) ao fim de cada iteração do seu laço
+ * e anota a fase em que está (supervisor_fase). O Core 0 só alimenta o watchdog quando
+ * os dois núcleos estão vivos e dentro do orçamento de tempo de laço; um travamento em
+ * qualquer um deles (ex: i2c_read_blocking em um barramento com defeito, ou uma chamada
+ * do LWIP presa) deixa o watchdog expirar e reinicia o dispositivo.
+ *
+ * As fases e a causa ficam nos registradores scratch 0-3 do watchdog, que sobrevivem
+ * ao reset, e são publicadas em <DEVICE_ID>/reset após a reinicialização.
+ */
+
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+#include "pico/stdlib.h" // Para tipos básicos
+
+#define SUPERVISOR_WATCHDOG_MS 3000        // Timeout do watchdog de hardware
+#define SUPERVISOR_ORCAMENTO_C0_US 1500000 // Maior iteração aceita no laço do Core 0
+#define SUPERVISOR_ORCAMENTO_C1_US 2000000 // Maior silêncio aceito do Core 1
+#define SUPERVISOR_CARENCIA_C1_US 10000000 // Prazo para o primeiro batimento do Core 1 (init do CYW43)
+#define SUPERVISOR_FASE_INICIO 0xFF        // Fase anotada antes do primeiro laço (nos dois núcleos)
+
+/**
+ * @brief Fases do laço do Core 1. As do Core 0 são as de enum FasePerfil (perfil.h).
+ */
+enum FaseNucleo1 {
+    FASE_C1_REDE,        ///< rede_tarefa(): Wi-Fi e MQTT.
+    FASE_C1_FIFO,        ///< Leitura do FIFO e formatação da mensagem.
+    FASE_C1_PUBLICACAO,  ///< Chamada ao mqtt_publish.
+    FASE_C1_ESPERA       ///< Poll do CYW43 e pausa.
+};
+
+/**
+ * @brief Causa registrada quando o supervisor deixa de alimentar o watchdog.
+ */
+enum CausaSupervisor {
+    CAUSA_NENHUMA,
+    CAUSA_C0_LENTO,   ///< Iteração do Core 0 acima do orçamento.
+    CAUSA_C1_PARADO   ///< Core 1 sem batimento dentro do orçamento.
+};
+
+/**
+ * @brief Origem do último reset.
+ */
+enum MotivoReset {
+    RESET_ENERGIA,   ///< Energização ou pino RUN.
+    RESET_WATCHDOG,  ///< Timeout do watchdog (travamento detectado).
+    RESET_SOFTWARE   ///< watchdog_reboot() chamado pelo firmware.
+};
+
+/**
+ * @struct relatorio_reset_t
+ * @brief O que se sabe sobre o último reset, lido no boot.
+ */
+typedef struct {
+    uint8_t motivo;           ///< Valor de enum MotivoReset.
+    bool registro_valido;     ///< Os scratch continham dados do supervisor.
+    uint8_t fase_c0;          ///< Última fase anotada pelo Core 0 (enum FasePerfil).
+    uint8_t fase_c1;          ///< Última fase anotada pelo Core 1 (enum FaseNucleo1).
+    uint8_t causa;            ///< Valor de enum CausaSupervisor.
+    uint32_t tempo_ligado_s;  ///< Tempo desde o boot anterior até o reset.
+} relatorio_reset_t;
+
+/**
+ * @brief Lê a causa do último reset e os scratch antes que sejam sobrescritos.
+ * Deve ser a primeira chamada do Core 0.
+ */
+void supervisor_iniciar(void);
+
+/**
+ * @brief Liga o watchdog. Chamada pelo Core 0 imediatamente antes do laço principal.
+ */
+void supervisor_armar(void);
+
+/**
+ * @brief Anota a fase atual do núcleo que chama (um store em registrador, barato).
+ */
+void supervisor_fase(uint8_t fase);
+
+/**
+ * @brief Registra o fim de uma iteração do laço do núcleo que chama.
+ * No Core 0, também decide se o watchdog é alimentado.
+ */
+void supervisor_batimento(void);
+
+/**
+ * @brief Relatório do último reset, preenchido por supervisor_iniciar().
+ */
+const relatorio_reset_t *supervisor_ultimo_reset(void);
+
+/**
+ * @brief Nome de uma fase para relatórios.
+ * @param nucleo 0 ou 1.
+ */
+const char *supervisor_nome_fase(uint8_t nucleo, uint8_t fase);
+
+#endif // SUPERVISOR_H
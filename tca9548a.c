@@ -0,0 +1,24 @@
+/**
+ * @file tca9548a.c
+ * @brief Implementação do driver do multiplexador I2C TCA9548A.
+ */
+
+#include "tca9548a.h"
+#include "configura_geral.h" // Para TCA9548A_ADDR
+
+static uint8_t canal_atual = TCA9548A_NENHUM;
+static bool canal_conhecido; // false após falha: a próxima seleção sempre escreve
+
+bool tca9548a_init(i2c_inst_t *i2c) {
+    canal_conhecido = false;
+    return tca9548a_selecionar(i2c, TCA9548A_NENHUM);
+}
+
+bool tca9548a_selecionar(i2c_inst_t *i2c, uint8_t canal) {
+    if (canal_conhecido && canal == canal_atual) return true;
+    // Registrador de controle: um bit por canal; 0 desliga todos.
+    uint8_t mascara = canal < TCA9548A_NUM_CANAIS ? (uint8_t)(1u << canal) : 0;
+    canal_conhecido = i2c_write_blocking(i2c, TCA9548A_ADDR, &mascara, 1, false) == 1;
+    canal_atual = canal;
+    return canal_conhecido;
+}
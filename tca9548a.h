@@ -0,0 +1,32 @@
+/**
+ * @file tca9548a.h
+ * @brief Driver do multiplexador I2C TCA9548A (8 canais).
+ * Permite ligar vários sensores com o mesmo endereço fixo (ex: um AHT10 por zona)
+ * ao mesmo barramento, cada um em um canal.
+ */
+
+#ifndef TCA9548A_H
+#define TCA9548A_H
+
+#include "pico/stdlib.h"  // Para tipos básicos
+#include "hardware/i2c.h" // Para o tipo i2c_inst_t
+
+#define TCA9548A_NUM_CANAIS 8
+#define TCA9548A_NENHUM 0xFF // Todos os canais desligados: só o barramento principal responde
+
+/**
+ * @brief Desliga todos os canais e esquece o canal selecionado.
+ * @param i2c A instância do I2C onde o multiplexador está conectado.
+ * @return true se o multiplexador respondeu.
+ */
+bool tca9548a_init(i2c_inst_t *i2c);
+
+/**
+ * @brief Seleciona um canal (ou nenhum). Não acessa o barramento se o canal já está selecionado.
+ * @param i2c A instância do I2C onde o multiplexador está conectado.
+ * @param canal 0 a 7, ou TCA9548A_NENHUM.
+ * @return true se o canal está selecionado.
+ */
+bool tca9548a_selecionar(i2c_inst_t *i2c, uint8_t canal);
+
+#endif // TCA9548A_H
@@ -0,0 +1,61 @@
+/**
+ * @file tempos_boot.c
+ * @brief Implementação do registro de tempos de inicialização.
+ * Cada núcleo escreve apenas no seu próprio registro, então não há disputa entre eles.
+ */
+
+#include "tempos_boot.h"
+#include "pico/multicore.h" // Para get_core_num
+#include <stdarg.h>
+#include <stdio.h>
+
+typedef struct {
+    const char *nome[TEMPOS_BOOT_MAX_ETAPAS];
+    uint32_t duracao_ms[TEMPOS_BOOT_MAX_ETAPAS];
+    uint8_t quantidade;
+    uint64_t ultima_marca_us;
+} tempos_nucleo_t;
+
+static tempos_nucleo_t nucleos[2];
+
+void tempos_boot_inicio_nucleo(void) {
+    tempos_nucleo_t *t = &nucleos[get_core_num()];
+    t->quantidade = 0;
+    t->ultima_marca_us = time_us_64();
+}
+
+void tempos_boot_marcar(const char *etapa) {
+    tempos_nucleo_t *t = &nucleos[get_core_num()];
+    uint64_t agora = time_us_64();
+    if (t->quantidade < TEMPOS_BOOT_MAX_ETAPAS) {
+        t->nome[t->quantidade] = etapa;
+        t->duracao_ms[t->quantidade] = (uint32_t)((agora - t->ultima_marca_us) / 1000);
+        t->quantidade++;
+    }
+    t->ultima_marca_us = agora;
+}
+
+/**
+ * @brief snprintf que continua a partir da posição n, truncando sem estourar o destino.
+ */
+static int acrescentar(char *destino, size_t tamanho, int n, const char *formato, ...) {
+    size_t pos = (size_t)n < tamanho ? (size_t)n : tamanho;
+    va_list args;
+    va_start(args, formato);
+    int escrito = vsnprintf(destino + pos, tamanho - pos, formato, args);
+    va_end(args);
+    return n + escrito;
+}
+
+int tempos_boot_formatar(char *destino, size_t tamanho) {
+    int n = 0;
+    for (int c = 0; c < 2; c++) {
+        const tempos_nucleo_t *t = &nucleos[c];
+        n = acrescentar(destino, tamanho, n, "%s\"c%d\":{", c ? "," : "{", c);
+        for (uint8_t i = 0; i < t->quantidade; i++) {
+            n = acrescentar(destino, tamanho, n, "\"%s\":%lu,", t->nome[i], (unsigned long)t->duracao_ms[i]);
+        }
+        n = acrescentar(destino, tamanho, n, "\"pronto\":%lu}", (unsigned long)(t->ultima_marca_us / 1000));
+    }
+    return acrescentar(destino, tamanho, n, "}");
+}
@@ -0,0 +1,33 @@
+/**
+ * @file tempos_boot.h
+ * @brief Registro do tempo gasto em cada etapa da inicialização, por núcleo.
+ * Cada núcleo marca o fim das suas etapas; a duração é contada a partir da marca
+ * anterior do mesmo núcleo. O resumo é publicado uma vez, quando o MQTT conecta.
+ */
+
+#ifndef TEMPOS_BOOT_H
+#define TEMPOS_BOOT_H
+
+#include "pico/stdlib.h" // Para tipos básicos
+
+#define TEMPOS_BOOT_MAX_ETAPAS 8 // Etapas registradas por núcleo
+
+/**
+ * @brief Inicia a contagem do núcleo que chama (a primeira etapa do Core 0 conta desde o reset).
+ */
+void tempos_boot_inicio_nucleo(void);
+
+/**
+ * @brief Marca o fim de uma etapa no núcleo que chama.
+ * @param etapa Nome curto e estático (vai para o JSON publicado).
+ */
+void tempos_boot_marcar(const char *etapa);
+
+/**
+ * @brief Escreve o resumo em JSON: {"c0":{"etapa":ms,...,"pronto":ms},"c1":{...}}.
+ * "pronto" é o instante (ms desde o reset) da última marca de cada núcleo.
+ * @return Número de caracteres escritos (como snprintf).
+ */
+int tempos_boot_formatar(char *destino, size_t tamanho);
+
+#endif // TEMPOS_BOOT_H
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+"""
+Relatório de uso de memória a partir do mapa do linker (Projeto3Estufa.elf.map).
+
+Soma, por arquivo-fonte, os bytes em flash (código, constantes e a imagem de
+inicialização de .data) e em RAM (.data, .bss e bancos de scratch), e lista os
+pools estáticos do LWIP (heap MEM_SIZE e um bloco por pool memp).
+
+Uso: relatorio_memoria.py <arquivo.map> [--todos]
+"""
+
+import re
+import sys
+from collections import defaultdict
+
+# Seções de saída do script de ligação do SDK e onde elas ocupam espaço.
+SECOES_FLASH = {".boot2", ".text", ".rodata", ".binary_info", ".ARM.extab", ".ARM.exidx"}
+SECOES_RAM = {".bss", ".uninitialized_data", ".ram_vector_table"}
+SECOES_AMBAS = {".data", ".scratch_x", ".scratch_y"}  # Imagem em flash, cópia em RAM
+SECOES_IGNORADAS = {".heap", ".stack_dummy", ".stack1_dummy", ".flash_end"}
+
+RE_SECAO_SAIDA = re.compile(r"^(\.[\w.]+)\s+0x[0-9a-f]+\s+0x[0-9a-f]+", re.I)
+RE_ENTRADA = re.compile(r"^\s(\.?[\w.$-]+)?\s*0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S+)", re.I)
+RE_ENTRADA_SO_NOME = re.compile(r"^\s(\.[\w.$-]+)\s*$")
+RE_POOL_LWIP = re.compile(r"\.bss\.(memp_memory_\w+_base|ram_heap)$")
+
+
+def agrupar(objeto):
+    """Reduz o caminho do objeto a um nome legível: arquivo do projeto, módulo do SDK ou biblioteca."""
+    biblioteca = re.search(r"([^/]+)\.a\(", objeto)
+    if biblioteca:  # Membro de biblioteca: .../libc_nano.a(lib_a-memcpy.o)
+        return "[" + biblioteca.group(1) + "]"
+    arquivo = re.sub(r"\.obj$", "", objeto.split("/")[-1])
+    if "/lwip/" in objeto:
+        return "[lwip] " + arquivo
+    if "cyw43" in objeto:
+        return "[cyw43] " + arquivo
+    if "pico-sdk" in objeto or "pico_sdk" in objeto or "/src/rp2" in objeto:
+        return "[sdk] " + arquivo
+    return arquivo
+
+
+def ler_mapa(caminho):
+    flash = defaultdict(int)
+    ram = defaultdict(int)
+    pools = []
+    secao = None
+    nome_pendente = None
+    dentro = False
+    with open(caminho, encoding="utf-8", errors="replace") as f:
+        for linha in f:
+            linha = linha.rstrip("\n")
+            if linha.startswith("Linker script and memory map"):
+                dentro = True
+                continue
+            if not dentro:
+                continue
+            m = RE_SECAO_SAIDA.match(linha)
+            if m:
+                secao = m.group(1)
+                nome_pendente = None
+                continue
+            if linha.startswith("."):
+                secao = linha.split()[0]
+                continue
+            m = RE_ENTRADA_SO_NOME.match(linha)
+            if m:  # Nome longo: endereço, tamanho e objeto vêm na linha seguinte
+                nome_pendente = m.group(1)
+                continue
+            m = RE_ENTRADA.match(linha)
+            if not m or secao is None or secao in SECOES_IGNORADAS:
+                nome_pendente = None
+                continue
+            nome = m.group(1) or nome_pendente
+            nome_pendente = None
+            tamanho = int(m.group(3), 16)
+            objeto = m.group(4)
+            if tamanho == 0 or objeto.startswith("0x") or not nome:
+                continue
+            grupo = agrupar(objeto)
+            if secao in SECOES_FLASH or secao in SECOES_AMBAS:
+                flash[grupo] += tamanho
+            if secao in SECOES_RAM or secao in SECOES_AMBAS:
+                ram[grupo] += tamanho
+            p = RE_POOL_LWIP.search(nome)
+            if p:
+                pools.append((p.group(1), tamanho))
+    return flash, ram, pools
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__.strip())
+        return 2
+    flash, ram, pools = ler_mapa(sys.argv[1])
+    todos = "--todos" in sys.argv
+    grupos = sorted(set(flash) | set(ram), key=lambda g: -(flash[g] + ram[g]))
+    if not todos:
+        grupos = grupos[:40]
+
+    print(f"{'arquivo':<40} {'flash':>8} {'ram':>8}")
+    print("-" * 58)
+    for g in grupos:
+        print(f"{g:<40} {flash[g]:>8} {ram[g]:>8}")
+    print("-" * 58)
+    print(f"{'total':<40} {sum(flash.values()):>8} {sum(ram.values()):>8}")
+
+    if pools:
+        print("\nPools estáticos do LWIP (bytes; picos de uso em tempo de execução: memoria_imprimir com ESTUFA_PERFIL):")
+        for nome, tamanho in sorted(pools, key=lambda p: -p[1]):
+            print(f"  {nome:<40} {tamanho:>8}")
+        print(f"  {'total':<40} {sum(t for _, t in pools):>8}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+"""
+Envia um traço gravado a um firmware compilado com ESTUFA_REPRODUCAO=1 e imprime a
+sequência de transições de modo e de publicações que ele produz.
+
+O traço pode estar no formato do firmware (uma amostra por linha,
+"t_ms,temp_c100,umid_c100,luz_mlux[,solo_c100]", campos vazios para leituras
+ausentes) ou ser a captura do tópico <DEVICE_ID>/sensores/amostra, uma mensagem
+JSON por linha, com ou sem o tópico na frente (mosquitto_sub -v). Das capturas,
+só a zona principal é usada; o tempo é o "ts" das amostras com o relógio
+sincronizado e o "mono_ms" das demais.
+
+Uso: reproduzir_traco.py <porta> <traço> [--converter]
+
+Com --converter, só imprime o traço no formato do firmware, sem abrir a porta.
+Requer pyserial (pip install pyserial).
+"""
+
+import json
+import sys
+import threading
+
+PREFIXO = "[reproducao] "
+
+
+def c100(valor):
+    return "" if valor is None else str(round(valor * 100))
+
+
+def converter(linhas):
+    """Gera as linhas do traço no formato do firmware, a partir de CSV ou JSON."""
+    for linha in linhas:
+        linha = linha.strip()
+        if not linha or linha.startswith("#"):
+            continue
+        if "{" not in linha:
+            yield linha  # Já está no formato do firmware
+            continue
+        topico, _, corpo = linha.partition("{")
+        if "/zona" in topico:
+            continue
+        try:
+            a = json.loads("{" + corpo)
+        except ValueError:
+            continue  # Linha cortada no meio da captura
+        t_ms = a["ts"] if a.get("sinc") else a["mono_ms"]
+        luz = "" if a.get("lux") is None else str(round(a["lux"] * 1000))
+        yield f"{t_ms},{c100(a.get('temp'))},{c100(a.get('umid'))},{luz},{c100(a.get('solo'))}"
+
+
+def main():
+    if len(sys.argv) < 3:
+        print(__doc__.strip())
+        return 2
+    with open(sys.argv[2], encoding="utf-8", errors="replace") as f:
+        traco = list(converter(f))
+    if "--converter" in sys.argv:
+        print("\n".join(traco))
+        return 0
+
+    import serial  # Só necessário para falar com a placa
+
+    porta = serial.Serial(sys.argv[1], 115200, timeout=1)
+    pronto = threading.Event()
+
+    def enviar():
+        pronto.wait(3)  # O "pronto" do boot se perde se a porta foi aberta depois dele
+        for linha in traco:
+            porta.write((linha + "\n").encode())
+        porta.write(b"fim\n")
+
+    # A saída é lida enquanto o traço é enviado: o stdio USB descarta o que ninguém lê.
+    threading.Thread(target=enviar, daemon=True).start()
+    while True:
+        linha = porta.readline().decode(errors="replace").strip()
+        if PREFIXO not in linha:
+            continue
+        evento = linha.split(PREFIXO, 1)[1]
+        if evento == "pronto":
+            pronto.set()
+            continue
+        print(evento, flush=True)
+        if " fim " in evento:
+            return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+"""
+Verifica as latências de ponta a ponta contra um orçamento.
+
+Lê um log do console serial (linhas "[latencia] {...}") ou a saída de um
+assinante de <DEVICE_ID>/diagnostico/latencia (uma mensagem JSON por linha) e
+compara o último relatório com os limites em ms de cada medida. O último
+relatório cobre todo o tempo desde o boot, então basta rodar o ensaio (ex: um
+comando IRRIGAR por minuto e luz forçada acima do limiar) e capturar o log.
+
+Uso: verificar_latencia.py <log|-> [--p99 medida=ms ...] [--max medida=ms ...]
+                           [--vazao-min msg/s]
+
+Sem limites na linha de comando, usa ORCAMENTO_PADRAO. Sai com 1 se algum
+limite foi estourado ou se uma medida orçada não teve nenhuma ocorrência, e com
+2 se não há relatório no log.
+"""
+
+import json
+import sys
+
+# Orçamento padrão (ms), do pior caso aceitável no laço de 1 s do Core 0.
+ORCAMENTO_PADRAO = {
+    "p99": {"sensor_envio": 1500, "alarme": 1500, "cmd_irrigar": 200},
+    "max": {"sensor_envio": 5000, "alarme": 3000, "cmd_irrigar": 1000},
+}
+PREFIXO = "[latencia] "
+
+
+def ultimo_relatorio(linhas):
+    relatorio = None
+    for linha in linhas:
+        linha = linha.strip()
+        if PREFIXO in linha:
+            linha = linha.split(PREFIXO, 1)[1]
+        elif " {" in linha:  # mosquitto_sub -v: "<topico> {...}"
+            linha = linha.split(" ", 1)[1]
+        if not linha.startswith("{"):
+            continue
+        try:
+            dados = json.loads(linha)
+        except ValueError:
+            continue  # Linha cortada no meio da captura
+        if "pub_s" in dados:
+            relatorio = dados
+    return relatorio
+
+
+def ler_limites(argumentos):
+    orcamento = {"p99": {}, "max": {}}
+    vazao_min = None
+    i = 0
+    while i < len(argumentos):
+        chave = argumentos[i].lstrip("-")
+        if i + 1 >= len(argumentos):
+            raise ValueError(f"falta o valor de {argumentos[i]}")
+        valor = argumentos[i + 1]
+        if chave == "vazao-min":
+            vazao_min = float(valor)
+        elif chave in orcamento:
+            medida, ms = valor.split("=", 1)
+            orcamento[chave][medida] = float(ms)
+        else:
+            raise ValueError(f"opção desconhecida: {argumentos[i]}")
+        i += 2
+    if not orcamento["p99"] and not orcamento["max"]:
+        orcamento = ORCAMENTO_PADRAO
+    return orcamento, vazao_min
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__.strip())
+        return 2
+    try:
+        orcamento, vazao_min = ler_limites(sys.argv[2:])
+    except ValueError as erro:
+        print(erro)
+        return 2
+    if sys.argv[1] == "-":
+        relatorio = ultimo_relatorio(sys.stdin)
+    else:
+        with open(sys.argv[1], encoding="utf-8", errors="replace") as f:
+            relatorio = ultimo_relatorio(f)
+    if relatorio is None:
+        print("nenhum relatório de latência no log")
+        return 2
+
+    falhas = 0
+    print(f"{'medida':<14} {'n':>6} {'p50':>8} {'p99':>8} {'max':>8}  (ms)")
+    for medida, valores in relatorio.items():
+        if isinstance(valores, dict):
+            print(f"{medida:<14} {valores['n']:>6} {valores['p50']:>8} {valores['p99']:>8} {valores['max']:>8}")
+    print(f"vazão: {relatorio['pub_s']} msg/s")
+
+    ausentes = set()
+    for estatistica, limites in orcamento.items():
+        for medida, limite in limites.items():
+            valores = relatorio.get(medida)
+            if not valores or valores["n"] == 0:
+                if medida not in ausentes:
+                    print(f"FALHA {medida}: nenhuma ocorrência no ensaio")
+                    ausentes.add(medida)
+                    falhas += 1
+            elif valores[estatistica] > limite:
+                print(f"FALHA {medida}: {estatistica} {valores[estatistica]} ms > {limite} ms")
+                falhas += 1
+    if vazao_min is not None and relatorio["pub_s"] < vazao_min:
+        print(f"FALHA vazão: {relatorio['pub_s']} msg/s < {vazao_min} msg/s")
+        falhas += 1
+
+    print("OK" if falhas == 0 else f"{falhas} limite(s) estourado(s)")
+    return 1 if falhas else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())